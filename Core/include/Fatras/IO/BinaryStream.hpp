@@ -0,0 +1,181 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief The binary stream format
+///
+/// A stream file starts with a file header, followed by blocks of records.
+/// Every block has a header with the tag of the record type, the record
+/// size and the number of records, followed by the raw records.
+namespace stream {
+
+/// The file magic "FTSTREAM"
+constexpr std::uint64_t magic = 0x4d41455254535446;
+/// The format version
+constexpr std::uint32_t version = 1;
+
+/// The tags of the Fatras records
+enum Tag : std::uint32_t { Hits = 1, Particles = 2, Boundaries = 3 };
+
+struct FileHeader {
+  std::uint64_t magic = stream::magic;
+  std::uint32_t version = stream::version;
+  std::uint32_t reserved = 0;
+};
+
+struct BlockHeader {
+  std::uint32_t tag = 0;
+  std::uint32_t recordSize = 0;
+  std::uint64_t count = 0;
+};
+
+} // namespace stream
+
+/// @brief Binary stream writer with a background writer thread
+///
+/// Blocks of records are appended to a front buffer. Once it exceeds the
+/// buffer size, it is swapped with the back buffer which the writer thread
+/// writes to the file, while the caller continues to fill the front one.
+/// If the writer thread is still busy with the back buffer, the caller
+/// waits: at most two buffers are in memory.
+///
+/// Errors of the writer thread are rethrown by the next flush() or close().
+class AsyncWriter {
+public:
+  /// Constructor
+  ///
+  /// @param path is the output file
+  /// @param bufferSize is the size of the front buffer that triggers the
+  ///        hand-over to the writer thread
+  ///
+  /// @throw std::runtime_error if the file can not be opened
+  AsyncWriter(const std::string &path, std::size_t bufferSize = 1 << 20);
+
+  /// Destructor, closes the stream without reporting errors
+  ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  /// @brief Append a block of records
+  ///
+  /// @tparam record_t Type of the trivially copyable record
+  ///
+  /// @param tag is the record tag
+  /// @param records are the records
+  /// @param count is the number of records
+  template <typename record_t>
+  void write(std::uint32_t tag, const record_t *records, std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<record_t>,
+                  "Records are written as raw bytes");
+    if (count == 0) {
+      return;
+    }
+    stream::BlockHeader header;
+    header.tag = tag;
+    header.recordSize = sizeof(record_t);
+    header.count = count;
+    append(&header, sizeof(header));
+    append(records, count * sizeof(record_t));
+    if (m_front.size() >= m_bufferSize) {
+      flush();
+    }
+  }
+
+  /// Append a block of records
+  template <typename record_t>
+  void write(std::uint32_t tag, const std::vector<record_t> &records) {
+    write(tag, records.data(), records.size());
+  }
+
+  /// Hand the front buffer over to the writer thread
+  void flush();
+
+  /// Write all buffers, stop the writer thread and close the file
+  void close();
+
+  /// The number of bytes handed over to the writer thread
+  std::size_t bytesWritten() const { return m_bytesWritten; }
+
+private:
+  void append(const void *data, std::size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    m_front.insert(m_front.end(), bytes, bytes + size);
+  }
+
+  /// The writer thread loop
+  void run();
+
+  std::ofstream m_file;
+  std::size_t m_bufferSize;
+  std::size_t m_bytesWritten = 0;
+  std::vector<char> m_front;
+  std::vector<char> m_back;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_backFull = false;
+  bool m_stop = false;
+  std::exception_ptr m_error = nullptr;
+};
+
+/// @brief Sequential reader of a binary stream file
+class BlockReader {
+public:
+  /// Constructor
+  ///
+  /// @param path is the input file
+  ///
+  /// @throw std::runtime_error if the file is not a stream file
+  BlockReader(const std::string &path);
+
+  /// @brief Read the next block
+  ///
+  /// @return false at the end of the file
+  /// @throw std::runtime_error for a truncated block
+  bool next();
+
+  /// The header of the current block
+  const stream::BlockHeader &header() const { return m_header; }
+
+  /// @brief The records of the current block
+  ///
+  /// @throw std::runtime_error if the record size does not match
+  template <typename record_t> std::vector<record_t> records() const {
+    if (m_header.recordSize != sizeof(record_t)) {
+      throw std::runtime_error("Record size mismatch in stream block");
+    }
+    std::vector<record_t> result(m_header.count);
+    std::memcpy(result.data(), m_data.data(), m_data.size());
+    return result;
+  }
+
+private:
+  std::ifstream m_file;
+  stream::BlockHeader m_header;
+  std::vector<char> m_data;
+};
+
+} // namespace Fatras
@@ -0,0 +1,194 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/IO/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief The columnar file format
+///
+/// A columnar file starts with a file header and the column directory,
+/// followed by the columns. Every column is a contiguous array of one
+/// fundamental type which starts at a multiple of the alignment, such that
+/// a memory mapped file can be read in place.
+namespace columnar {
+
+/// The file magic "FTCOLUMN"
+constexpr std::uint64_t magic = 0x4e4d554c4f435446;
+/// The format version
+constexpr std::uint32_t version = 1;
+/// The alignment of the columns in the file
+constexpr std::size_t alignment = 64;
+
+/// The element types of the columns
+enum class Type : std::uint32_t {
+  UInt64 = 1,
+  Int32 = 2,
+  Float = 3,
+  Double = 4
+};
+
+template <typename T> struct type_of;
+template <> struct type_of<std::uint64_t> {
+  static constexpr Type value = Type::UInt64;
+};
+template <> struct type_of<std::int32_t> {
+  static constexpr Type value = Type::Int32;
+};
+template <> struct type_of<float> {
+  static constexpr Type value = Type::Float;
+};
+template <> struct type_of<double> {
+  static constexpr Type value = Type::Double;
+};
+
+struct FileHeader {
+  std::uint64_t magic = columnar::magic;
+  std::uint32_t version = columnar::version;
+  std::uint32_t nColumns = 0;
+};
+
+struct ColumnHeader {
+  char name[48] = {};
+  std::uint32_t type = 0;
+  std::uint32_t elementSize = 0;
+  std::uint64_t count = 0;
+  std::uint64_t offset = 0;
+};
+
+} // namespace columnar
+
+/// @brief A non-owning view of a contiguous array
+template <typename T> class Span {
+public:
+  Span() = default;
+  Span(T *data, std::size_t size) : m_data(data), m_size(size) {}
+
+  T *data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  T &operator[](std::size_t i) const { return m_data[i]; }
+  T *begin() const { return m_data; }
+  T *end() const { return m_data + m_size; }
+
+private:
+  T *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+/// @brief Writer of a columnar file
+///
+/// The columns are collected in memory and written in one go.
+class ColumnarWriter {
+public:
+  /// @brief Add a column
+  ///
+  /// @tparam value_t Type of the column elements
+  ///
+  /// @param name is the unique column name
+  /// @param values are the column elements
+  template <typename value_t>
+  void add(const std::string &name, const std::vector<value_t> &values) {
+    void *data = allocate(name, columnar::type_of<value_t>::value,
+                          sizeof(value_t), values.size());
+    std::memcpy(data, values.data(), values.size() * sizeof(value_t));
+  }
+
+  /// @brief Add a column from one member of an array of records
+  ///
+  /// @tparam record_t Type of the records
+  /// @tparam value_t Type of the member
+  ///
+  /// @param name is the unique column name
+  /// @param records are the records
+  /// @param member is the record member stored in the column
+  template <typename record_t, typename value_t>
+  void add(const std::string &name, const std::vector<record_t> &records,
+           value_t record_t::*member) {
+    value_t *data = static_cast<value_t *>(
+        allocate(name, columnar::type_of<value_t>::value, sizeof(value_t),
+                 records.size()));
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      data[i] = records[i].*member;
+    }
+  }
+
+  /// Remove all columns
+  void clear() { m_columns.clear(); }
+
+  /// @brief Write the columns to a file
+  ///
+  /// @throw std::runtime_error if the file can not be written
+  void write(const std::string &path) const;
+
+private:
+  struct Column {
+    columnar::ColumnHeader header;
+    std::vector<char> data;
+  };
+
+  /// @throw std::invalid_argument for a duplicated or too long name
+  void *allocate(const std::string &name, columnar::Type type,
+                 std::size_t elementSize, std::size_t count);
+
+  std::vector<Column> m_columns;
+};
+
+/// @brief Reader of a memory mapped columnar file
+///
+/// The columns are typed views into the mapped file, they are valid as
+/// long as the reader exists.
+class ColumnarReader {
+public:
+  /// Constructor
+  ///
+  /// @param path is the input file
+  ///
+  /// @throw std::runtime_error if the file can not be mapped or is not a
+  ///        valid columnar file
+  ColumnarReader(const std::string &path);
+
+  /// The names of all columns in file order
+  std::vector<std::string> names() const;
+
+  /// Check whether a column exists
+  bool has(const std::string &name) const { return find(name) != nullptr; }
+
+  /// @brief The elements of a column
+  ///
+  /// @tparam value_t Type of the column elements
+  ///
+  /// @throw std::runtime_error if the column is missing or has another type
+  template <typename value_t>
+  Span<const value_t> column(const std::string &name) const {
+    const columnar::ColumnHeader *header =
+        get(name, columnar::type_of<value_t>::value);
+    return Span<const value_t>(
+        reinterpret_cast<const value_t *>(m_file.data() + header->offset),
+        header->count);
+  }
+
+private:
+  const columnar::ColumnHeader *find(const std::string &name) const;
+  const columnar::ColumnHeader *get(const std::string &name,
+                                    columnar::Type type) const;
+
+  MappedFile m_file;
+  const columnar::ColumnHeader *m_columns = nullptr;
+  std::uint32_t m_nColumns = 0;
+};
+
+} // namespace Fatras
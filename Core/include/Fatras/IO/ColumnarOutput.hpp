@@ -0,0 +1,95 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/IO/ColumnarFile.hpp"
+#include "Fatras/IO/Records.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Columnar output of the simulation
+///
+/// It is handed to the Simulator as hit collection and collects the hits
+/// and the final state of every simulated particle, which are written as
+/// the columns
+///   hit.geoID, hit.barcode, hit.x, hit.y, hit.z, hit.time,
+///   hit.depositedEnergy, hit.pathLength,
+///   particle.barcode, particle.pdg, particle.q, particle.m,
+///   particle.x, particle.y, particle.z, particle.time,
+///   particle.px, particle.py, particle.pz
+///
+/// @tparam hit_converter_t Type of the functor converting a hit into a
+///         HitRecord
+template <typename hit_converter_t> class ColumnarOutput {
+public:
+  /// Constructor
+  ///
+  /// @param converter is the hit converter
+  ColumnarOutput(hit_converter_t converter = hit_converter_t())
+      : m_converter(std::move(converter)) {}
+
+  /// Add a simulated hit
+  template <typename hit_t> void insert(const hit_t &hit) {
+    m_hits.push_back(m_converter(hit));
+  }
+
+  /// Add the final state of a simulated particle
+  template <typename particle_t> void finished(const particle_t &particle) {
+    m_particles.push_back(makeParticleRecord(particle));
+  }
+
+  /// The collected hits
+  const std::vector<HitRecord> &hits() const { return m_hits; }
+
+  /// The collected particles
+  const std::vector<ParticleRecord> &particles() const { return m_particles; }
+
+  /// Remove all hits and particles
+  void clear() {
+    m_hits.clear();
+    m_particles.clear();
+  }
+
+  /// @brief Write the collected hits and particles
+  ///
+  /// @throw std::runtime_error if the file can not be written
+  void write(const std::string &path) const {
+    ColumnarWriter writer;
+    writer.add("hit.geoID", m_hits, &HitRecord::geoID);
+    writer.add("hit.barcode", m_hits, &HitRecord::barcode);
+    writer.add("hit.x", m_hits, &HitRecord::x);
+    writer.add("hit.y", m_hits, &HitRecord::y);
+    writer.add("hit.z", m_hits, &HitRecord::z);
+    writer.add("hit.time", m_hits, &HitRecord::time);
+    writer.add("hit.depositedEnergy", m_hits, &HitRecord::depositedEnergy);
+    writer.add("hit.pathLength", m_hits, &HitRecord::pathLength);
+    writer.add("particle.barcode", m_particles, &ParticleRecord::barcode);
+    writer.add("particle.pdg", m_particles, &ParticleRecord::pdg);
+    writer.add("particle.q", m_particles, &ParticleRecord::q);
+    writer.add("particle.m", m_particles, &ParticleRecord::m);
+    writer.add("particle.x", m_particles, &ParticleRecord::x);
+    writer.add("particle.y", m_particles, &ParticleRecord::y);
+    writer.add("particle.z", m_particles, &ParticleRecord::z);
+    writer.add("particle.time", m_particles, &ParticleRecord::time);
+    writer.add("particle.px", m_particles, &ParticleRecord::px);
+    writer.add("particle.py", m_particles, &ParticleRecord::py);
+    writer.add("particle.pz", m_particles, &ParticleRecord::pz);
+    writer.write(path);
+  }
+
+private:
+  hit_converter_t m_converter;
+  std::vector<HitRecord> m_hits;
+  std::vector<ParticleRecord> m_particles;
+};
+
+} // namespace Fatras
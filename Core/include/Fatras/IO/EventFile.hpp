@@ -0,0 +1,211 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Fatras/IO/MappedFile.hpp"
+#include "Fatras/IO/Records.hpp"
+#include "Fatras/Kernel/Particle.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief The binary event file format
+///
+/// An event file starts with a file header, followed by the event table,
+/// the vertex table and the primary particle records. An event is a range
+/// of vertices, a vertex a range of primary particles.
+namespace eventfile {
+
+/// The file magic "FTEVENTS"
+constexpr std::uint64_t magic = 0x53544e4556455446;
+/// The format version
+constexpr std::uint32_t version = 1;
+
+struct FileHeader {
+  std::uint64_t magic = eventfile::magic;
+  std::uint32_t version = eventfile::version;
+  std::uint32_t reserved = 0;
+  std::uint64_t nEvents = 0;
+  std::uint64_t nVertices = 0;
+  std::uint64_t nParticles = 0;
+};
+
+struct Range {
+  std::uint64_t first = 0;
+  std::uint64_t count = 0;
+};
+
+} // namespace eventfile
+
+/// @brief Create a particle from a primary record
+///
+/// @tparam particle_t Type of the particle
+template <typename particle_t>
+particle_t makeParticle(const PrimaryRecord &record) {
+  return particle_t(Acts::Vector3D(record.x, record.y, record.z),
+                    Acts::Vector3D(record.px, record.py, record.pz),
+                    record.m, record.q, record.pdg, record.barcode,
+                    record.time);
+}
+
+/// @brief Event collection on top of a mapped event file
+///
+/// The primaries are read from the mapped records on access, only the
+/// secondaries added during the simulation are stored.
+///
+/// @tparam particle_t Type of the particle
+template <typename particle_t = Particle> class MappedEvent {
+public:
+  /// The outgoing particles of a vertex, primaries first
+  class Outgoing {
+  public:
+    Outgoing(const PrimaryRecord *primaries, std::size_t nPrimaries)
+        : m_primaries(primaries), m_nPrimaries(nPrimaries) {}
+
+    std::size_t size() const { return m_nPrimaries + m_secondaries.size(); }
+
+    particle_t operator[](std::size_t index) const {
+      if (index < m_nPrimaries) {
+        return makeParticle<particle_t>(m_primaries[index]);
+      }
+      return m_secondaries[index - m_nPrimaries];
+    }
+
+    /// The number of primaries
+    std::size_t primaries() const { return m_nPrimaries; }
+
+    /// The secondaries added during the simulation
+    const std::vector<particle_t> &secondaries() const {
+      return m_secondaries;
+    }
+
+  private:
+    friend class MappedEvent;
+
+    const PrimaryRecord *m_primaries;
+    std::size_t m_nPrimaries;
+    std::vector<particle_t> m_secondaries;
+  };
+
+  /// A vertex of the event
+  struct Vertex {
+    Outgoing outgoing;
+
+    void outgoing_insert(const std::vector<particle_t> &particles) {
+      outgoing.m_secondaries.insert(outgoing.m_secondaries.end(),
+                                    particles.begin(), particles.end());
+    }
+  };
+
+  /// Add a vertex with its primaries
+  void addVertex(const PrimaryRecord *primaries, std::size_t nPrimaries) {
+    m_vertices.push_back(Vertex{Outgoing(primaries, nPrimaries)});
+  }
+
+  std::size_t size() const { return m_vertices.size(); }
+
+  typename std::vector<Vertex>::iterator begin() { return m_vertices.begin(); }
+  typename std::vector<Vertex>::iterator end() { return m_vertices.end(); }
+
+private:
+  std::vector<Vertex> m_vertices;
+};
+
+/// @brief Reader of a memory mapped event file
+///
+/// Every event request hands the following event to a background thread,
+/// which faults its pages in while the current event is simulated. The
+/// events refer to the mapped file and are valid as long as the reader
+/// exists.
+class EventFileReader {
+public:
+  /// Constructor
+  ///
+  /// @param path is the input file
+  ///
+  /// @throw std::runtime_error if the file can not be mapped or is not a
+  ///        valid event file
+  EventFileReader(const std::string &path);
+
+  /// Destructor, stops the prefetching
+  ~EventFileReader();
+
+  EventFileReader(const EventFileReader &) = delete;
+  EventFileReader &operator=(const EventFileReader &) = delete;
+
+  /// The number of events
+  std::size_t size() const { return m_header.nEvents; }
+
+  /// @brief The event collection of an event
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param index is the event index, it must be smaller than size()
+  template <typename particle_t = Particle>
+  MappedEvent<particle_t> event(std::size_t index) {
+    MappedEvent<particle_t> result;
+    const eventfile::Range &event = m_events[index];
+    for (std::uint64_t v = event.first; v < event.first + event.count; ++v) {
+      const eventfile::Range &vertex = m_vertices[v];
+      result.addVertex(m_primaries + vertex.first, vertex.count);
+    }
+    prefetch(index + 1);
+    return result;
+  }
+
+  /// Request the background prefetch of an event, ignored if out of range
+  void prefetch(std::size_t index);
+
+  /// The number of events prefetched so far
+  std::size_t prefetched() const { return m_prefetched; }
+
+private:
+  /// The prefetch thread loop
+  void run();
+
+  MappedFile m_file;
+  eventfile::FileHeader m_header;
+  const eventfile::Range *m_events = nullptr;
+  const eventfile::Range *m_vertices = nullptr;
+  const PrimaryRecord *m_primaries = nullptr;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::vector<std::size_t> m_requests;
+  bool m_stop = false;
+  std::atomic<std::size_t> m_prefetched{0};
+};
+
+/// @brief Convert events from a text format into an event file
+///
+/// The text format has one entry per line, empty lines and lines starting
+/// with '#' are ignored:
+///   event
+///   vertex
+///   particle <barcode> <pdg> <q> <m> <x> <y> <z> <time> <px> <py> <pz>
+/// A vertex belongs to the last event, a particle to the last vertex.
+///
+/// @param input is the text input
+/// @param path is the output event file
+///
+/// @return the number of converted events
+/// @throw std::runtime_error for malformed input or an unwritable output
+std::size_t convertEventText(std::istream &input, const std::string &path);
+
+} // namespace Fatras
@@ -0,0 +1,48 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Fatras {
+
+/// @brief A read-only memory mapping of a whole file
+class MappedFile {
+public:
+  /// Constructor
+  ///
+  /// @param path is the file to be mapped
+  ///
+  /// @throw std::runtime_error if the file can not be opened or mapped
+  MappedFile(const std::string &path);
+
+  /// Destructor, unmaps the file
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /// The mapped bytes
+  const char *data() const { return m_data; }
+
+  /// The file size
+  std::size_t size() const { return m_size; }
+
+  /// @brief Hint the kernel to read the given byte range ahead
+  ///
+  /// The range is rounded to full pages and clipped to the file.
+  void willNeed(std::size_t offset, std::size_t length) const;
+
+private:
+  const char *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+} // namespace Fatras
@@ -0,0 +1,141 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Fatras {
+
+/// @brief Compact binary record of a simulated hit
+///
+/// The global position and the time are kept in double precision: single
+/// precision resolves only about a quarter of a micrometer at 4 m and
+/// worse further out. The deposited energy and the path length are kept in
+/// single precision.
+struct HitRecord {
+  std::uint64_t geoID = 0;
+  std::uint64_t barcode = 0;
+  double x = 0.;
+  double y = 0.;
+  double z = 0.;
+  double time = 0.;
+  float depositedEnergy = 0.f;
+  float pathLength = 0.f;
+};
+
+/// @brief Compact binary record of a particle
+struct ParticleRecord {
+  std::uint64_t barcode = 0;
+  std::int32_t pdg = 0;
+  float q = 0.f;
+  float m = 0.f;
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+  float time = 0.f;
+  float px = 0.f;
+  float py = 0.f;
+  float pz = 0.f;
+};
+
+/// @brief Compact binary record of a particle terminated at a boundary
+///
+/// The identifier is the one of the surface in the kill volume that was
+/// reached, or zero if the particle left the kill envelope.
+struct BoundaryRecord {
+  std::uint64_t barcode = 0;
+  std::uint64_t geoID = 0;
+  std::int32_t pdg = 0;
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+  float time = 0.f;
+  float px = 0.f;
+  float py = 0.f;
+  float pz = 0.f;
+};
+
+/// @brief Binary record of a generated primary particle
+///
+/// The kinematics are kept in double precision as they are the input of
+/// the simulation.
+struct PrimaryRecord {
+  std::uint64_t barcode = 0;
+  std::int32_t pdg = 0;
+  float q = 0.f;
+  double m = 0.;
+  double x = 0.;
+  double y = 0.;
+  double z = 0.;
+  double time = 0.;
+  double px = 0.;
+  double py = 0.;
+  double pz = 0.;
+};
+
+static_assert(std::is_trivially_copyable_v<HitRecord> and
+                  sizeof(HitRecord) == 56,
+              "HitRecord is written as raw bytes");
+static_assert(std::is_trivially_copyable_v<ParticleRecord> and
+                  sizeof(ParticleRecord) == 48,
+              "ParticleRecord is written as raw bytes");
+static_assert(std::is_trivially_copyable_v<BoundaryRecord> and
+                  sizeof(BoundaryRecord) == 48,
+              "BoundaryRecord is written as raw bytes");
+static_assert(std::is_trivially_copyable_v<PrimaryRecord> and
+                  sizeof(PrimaryRecord) == 80,
+              "PrimaryRecord is read in place");
+
+/// @brief Create the record of a particle
+///
+/// @tparam particle_t Type of the particle
+///
+/// @param particle is the particle to be recorded
+template <typename particle_t>
+ParticleRecord makeParticleRecord(const particle_t &particle) {
+  ParticleRecord record;
+  record.barcode = particle.barcode();
+  record.pdg = particle.pdg();
+  record.q = particle.q();
+  record.m = particle.m();
+  record.x = particle.position().x();
+  record.y = particle.position().y();
+  record.z = particle.position().z();
+  record.time = particle.time();
+  record.px = particle.momentum().x();
+  record.py = particle.momentum().y();
+  record.pz = particle.momentum().z();
+  return record;
+}
+
+/// @brief Create the boundary record of a particle
+///
+/// @tparam particle_t Type of the particle
+///
+/// @param particle is the particle at the boundary
+/// @param geoID is the identifier of the surface, zero for the envelope
+template <typename particle_t>
+BoundaryRecord makeBoundaryRecord(const particle_t &particle,
+                                  std::uint64_t geoID) {
+  BoundaryRecord record;
+  record.barcode = particle.barcode();
+  record.geoID = geoID;
+  record.pdg = particle.pdg();
+  record.x = particle.position().x();
+  record.y = particle.position().y();
+  record.z = particle.position().z();
+  record.time = particle.time();
+  record.px = particle.momentum().x();
+  record.py = particle.momentum().y();
+  record.pz = particle.momentum().z();
+  return record;
+}
+
+} // namespace Fatras
@@ -0,0 +1,100 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/IO/BinaryStream.hpp"
+#include "Fatras/IO/Records.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Streaming output of the simulation
+///
+/// It is handed to the Simulator as hit collection: the hits, the final
+/// state of every simulated particle and the boundary records of the
+/// particles terminated in kill volumes, are converted to records and
+/// handed over to the writer in chunks while the simulation continues.
+///
+/// @tparam hit_converter_t Type of the functor converting a hit into a
+///         HitRecord
+template <typename hit_converter_t> class StreamingOutput {
+public:
+  /// Constructor
+  ///
+  /// @param writer is the stream writer
+  /// @param converter is the hit converter
+  /// @param chunkSize is the number of records per block
+  StreamingOutput(AsyncWriter &writer,
+                  hit_converter_t converter = hit_converter_t(),
+                  std::size_t chunkSize = 4096)
+      : m_writer(&writer), m_converter(std::move(converter)),
+        m_chunkSize(chunkSize) {
+    m_hits.reserve(chunkSize);
+    m_particles.reserve(chunkSize);
+    m_boundaries.reserve(chunkSize);
+  }
+
+  /// Add a simulated hit
+  template <typename hit_t> void insert(const hit_t &hit) {
+    m_hits.push_back(m_converter(hit));
+    if (m_hits.size() == m_chunkSize) {
+      writeHits();
+    }
+  }
+
+  /// Add the final state of a simulated particle
+  template <typename particle_t> void finished(const particle_t &particle) {
+    m_particles.push_back(makeParticleRecord(particle));
+    if (m_particles.size() == m_chunkSize) {
+      writeParticles();
+    }
+  }
+
+  /// Add a particle terminated at a kill boundary
+  void crossed(const BoundaryRecord &record) {
+    m_boundaries.push_back(record);
+    if (m_boundaries.size() == m_chunkSize) {
+      writeBoundaries();
+    }
+  }
+
+  /// Hand the incomplete chunks over to the writer, e.g. at the event end
+  void flush() {
+    writeHits();
+    writeParticles();
+    writeBoundaries();
+  }
+
+private:
+  void writeHits() {
+    m_writer->write(stream::Hits, m_hits);
+    m_hits.clear();
+  }
+
+  void writeParticles() {
+    m_writer->write(stream::Particles, m_particles);
+    m_particles.clear();
+  }
+
+  void writeBoundaries() {
+    m_writer->write(stream::Boundaries, m_boundaries);
+    m_boundaries.clear();
+  }
+
+  AsyncWriter *m_writer;
+  hit_converter_t m_converter;
+  std::size_t m_chunkSize;
+  std::vector<HitRecord> m_hits;
+  std::vector<ParticleRecord> m_particles;
+  std::vector<BoundaryRecord> m_boundaries;
+};
+
+} // namespace Fatras
@@ -0,0 +1,187 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/Kernel/Particle.hpp"
+#include <stdexcept>
+
+namespace Fatras {
+
+/// @brief Hierarchical particle barcode
+///
+/// The barcode packs the ancestry of a particle into one integer:
+///
+///   | vertex (14) | primary (16) | generation (6) | sub-particle (28) |
+///
+/// A primary particle is identified by its vertex and primary number and
+/// has generation 0. Its descendants share vertex and primary number, the
+/// generation counts the steps from the primary and the sub-particle
+/// number distinguishes all descendants of one primary.
+///
+/// The primary numbers start at 1, primary number 0 is reserved: the value
+/// 0 marks particles without barcode, and plain sequential barcodes (1, 2,
+/// ...) of other sources, which would decode as sub-particles of primary 0,
+/// are recognised as not hierarchical.
+class Barcode {
+public:
+  static constexpr unsigned int vertexBits = 14;
+  static constexpr unsigned int primaryBits = 16;
+  static constexpr unsigned int generationBits = 6;
+  static constexpr unsigned int subParticleBits = 28;
+
+  /// Default constructor, an invalid barcode
+  constexpr Barcode() = default;
+
+  /// Construct from an encoded value
+  constexpr explicit Barcode(barcode_type value) : m_value(value) {}
+
+  /// Construct from the components
+  ///
+  /// @throw std::out_of_range if a component exceeds its field
+  constexpr Barcode(barcode_type vertex, barcode_type primary,
+                    barcode_type generation = 0, barcode_type subParticle = 0)
+      : m_value(encode(vertex, vertexBits, vertexShift) |
+                encode(primary, primaryBits, primaryShift) |
+                encode(generation, generationBits, generationShift) |
+                encode(subParticle, subParticleBits, subParticleShift)) {}
+
+  /// The encoded value
+  constexpr barcode_type value() const { return m_value; }
+
+  /// The vertex number
+  constexpr barcode_type vertex() const {
+    return decode(vertexBits, vertexShift);
+  }
+
+  /// The primary number within the vertex
+  constexpr barcode_type primary() const {
+    return decode(primaryBits, primaryShift);
+  }
+
+  /// The number of generations from the primary
+  constexpr barcode_type generation() const {
+    return decode(generationBits, generationShift);
+  }
+
+  /// The sub-particle number among the descendants of the primary
+  constexpr barcode_type subParticle() const {
+    return decode(subParticleBits, subParticleShift);
+  }
+
+  /// Whether this is a hierarchical barcode, i.e. it has a primary number
+  constexpr bool isValid() const { return primary() != 0; }
+
+  /// Whether this is the hierarchical barcode of a primary
+  constexpr bool isPrimary() const {
+    return isValid() and generation() == 0 and subParticle() == 0;
+  }
+
+  /// The barcode of the primary this particle descends from
+  constexpr Barcode primaryBarcode() const {
+    return Barcode(vertex(), primary());
+  }
+
+  /// The barcode of a descendant in the next generation
+  ///
+  /// The generation saturates at its maximum, the barcode stays unique
+  /// through the sub-particle number.
+  ///
+  /// @param subParticle is the sub-particle number of the descendant
+  constexpr Barcode descendant(barcode_type subParticle) const {
+    barcode_type nextGeneration = generation() + 1;
+    if (nextGeneration > mask(generationBits)) {
+      nextGeneration = mask(generationBits);
+    }
+    return Barcode(vertex(), primary(), nextGeneration, subParticle);
+  }
+
+  constexpr bool operator==(Barcode other) const {
+    return m_value == other.m_value;
+  }
+  constexpr bool operator!=(Barcode other) const {
+    return m_value != other.m_value;
+  }
+  constexpr bool operator<(Barcode other) const {
+    return m_value < other.m_value;
+  }
+
+private:
+  static constexpr unsigned int subParticleShift = 0;
+  static constexpr unsigned int generationShift = subParticleBits;
+  static constexpr unsigned int primaryShift = generationShift + generationBits;
+  static constexpr unsigned int vertexShift = primaryShift + primaryBits;
+
+  static_assert(vertexShift + vertexBits == 8 * sizeof(barcode_type),
+                "Barcode fields have to fill the barcode type");
+
+  static constexpr barcode_type mask(unsigned int bits) {
+    return (barcode_type(1) << bits) - 1;
+  }
+
+  static constexpr barcode_type encode(barcode_type value, unsigned int bits,
+                                       unsigned int shift) {
+    if (value > mask(bits)) {
+      throw std::out_of_range("Barcode component exceeds its field");
+    }
+    return value << shift;
+  }
+
+  constexpr barcode_type decode(unsigned int bits, unsigned int shift) const {
+    return (m_value >> shift) & mask(bits);
+  }
+
+  barcode_type m_value = 0;
+};
+
+/// @brief Allocator of the secondary barcodes of one primary
+///
+/// Every primary has its own allocator which numbers its descendants in
+/// the order they are created. As long as the descendants of a primary
+/// are simulated in a fixed order, e.g. by the thread that simulates the
+/// primary, the barcodes are reproducible independent of the threading
+/// and no shared counter or lock is needed. An allocator must not be
+/// shared between threads.
+class BarcodeAllocator {
+public:
+  /// Constructor from the barcode of the primary or one of its descendants
+  ///
+  /// @throw std::invalid_argument if the barcode is not hierarchical
+  explicit BarcodeAllocator(Barcode primary)
+      : m_primary(primary.primaryBarcode()) {
+    if (not primary.isValid()) {
+      throw std::invalid_argument("Barcode is not hierarchical");
+    }
+  }
+
+  /// The barcode of the primary
+  Barcode primary() const { return m_primary; }
+
+  /// The number of allocated barcodes
+  barcode_type allocated() const { return m_allocated; }
+
+  /// @brief Allocate the barcode of a secondary
+  ///
+  /// @param parent is the barcode of the particle creating the secondary,
+  ///        it has to descend from the primary of this allocator
+  ///
+  /// @throw std::overflow_error if the sub-particle numbers are exhausted
+  /// @return the barcode in the generation after the parent
+  Barcode operator()(Barcode parent) {
+    if (m_allocated == (barcode_type(1) << Barcode::subParticleBits) - 1) {
+      throw std::overflow_error("Secondary barcodes of primary exhausted");
+    }
+    return parent.descendant(++m_allocated);
+  }
+
+private:
+  Barcode m_primary;
+  barcode_type m_allocated = 0;
+};
+
+} // namespace Fatras
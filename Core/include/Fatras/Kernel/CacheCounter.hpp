@@ -0,0 +1,48 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstdint>
+
+namespace Fatras {
+
+/// @brief Hardware cache counters of the calling thread
+///
+/// The last level cache references and misses are read from the Linux
+/// performance counters. Where they are not available, e.g. on other
+/// systems or without the permission, the counter does nothing and
+/// available() is false.
+class CacheCounter {
+public:
+  struct Counts {
+    std::uint64_t references = 0;
+    std::uint64_t misses = 0;
+  };
+
+  CacheCounter();
+  ~CacheCounter();
+
+  CacheCounter(const CacheCounter &) = delete;
+  CacheCounter &operator=(const CacheCounter &) = delete;
+
+  /// Whether the hardware counters could be opened
+  bool available() const { return m_references >= 0 and m_misses >= 0; }
+
+  /// Reset and start counting
+  void start();
+
+  /// Stop counting and return the counts since start()
+  Counts stop();
+
+private:
+  int m_references = -1;
+  int m_misses = -1;
+};
+
+} // namespace Fatras
@@ -0,0 +1,169 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/Selectors/KinematicCasts.hpp"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief The projected tail latency of one event on parallel workers
+///
+/// The particles are dispatched in the given order to the first free
+/// worker; the makespan is the time until the last worker is done, the
+/// lower bound the best any order can achieve. This is a projection that
+/// treats all particles as available from the start: a secondary can in
+/// fact only start once its parent is done, which the makespan ignores.
+struct TailReport {
+  std::size_t nParticles = 0;
+  /// The summed particle times
+  double total = 0.;
+  /// The longest single particle
+  double longest = 0.;
+  /// The time until the last worker is done
+  double makespan = 0.;
+  /// max(total / nWorkers, longest)
+  double lowerBound = 0.;
+
+  /// The fraction of the ideal makespan that is achieved
+  double efficiency() const {
+    return makespan > 0. ? lowerBound / makespan : 1.;
+  }
+};
+
+/// @brief Project the dispatch of particles to parallel workers
+///
+/// See TailReport for the approximation of independent particles.
+///
+/// @param times are the particle times in dispatch order
+/// @param nWorkers is the number of workers
+TailReport tailReport(const std::vector<double> &times, std::size_t nWorkers);
+
+/// @brief Online model of the simulation time of a particle
+///
+/// The time is learned per bin of particle class (electrons and photons,
+/// muons, charged and neutral hadrons), |eta|, log(pT) and log(E) as the
+/// mean of the measured times, with an exponential forgetting once a bin
+/// is well populated. The energy separates the heavy slow particles from
+/// the light ones of the same |eta| and pT. Bins without measurements
+/// fall back to the mean of their class, then to the prior.
+///
+/// The model is meant for a dispatcher that runs the particles of an
+/// event on parallel workers: it hands them out in the order of decreasing
+/// estimated time (longest processing time first), such that expensive
+/// particles are not picked up late, learns the measured times and adds
+/// the times of every event to the report. The Simulator processes the
+/// particles one after the other, where the order cannot shorten an
+/// event, and does not use the model.
+///
+/// The estimates are taken from a frozen copy of the learned times, which
+/// is only updated by an explicit call to freeze(), e.g. between runs or
+/// after a calibration run. The dispatch order thus does not depend on
+/// the wall-clock times measured during a run and stays reproducible; a
+/// model that is never frozen estimates the prior for all particles.
+///
+/// The model is shared between threads, all methods are thread-safe.
+class CostModel {
+public:
+  struct Config {
+    /// The number of |eta| bins in [0, maxAbsEta), overflow in the last
+    std::size_t nEtaBins = 6;
+    double maxAbsEta = 6.;
+    /// The number of log10(pT) bins in [minLogPT, maxLogPT)
+    std::size_t nPTBins = 12;
+    double minLogPT = -2.;
+    double maxLogPT = 4.;
+    /// The number of log10(E) bins in [minLogE, maxLogE)
+    std::size_t nEBins = 6;
+    double minLogE = -2.;
+    double maxLogE = 4.;
+    /// The estimate without any measurement
+    double prior = 1e-4;
+    /// The number of measurements after which a bin starts forgetting
+    double memory = 1000.;
+    /// The number of workers the tail latency is evaluated for
+    std::size_t nWorkers = 8;
+  };
+
+  /// The accumulated projected tail latencies, see TailReport
+  struct Report {
+    std::size_t nEvents = 0;
+    std::size_t nParticles = 0;
+    double sumMakespan = 0.;
+    double maxMakespan = 0.;
+    double sumLowerBound = 0.;
+
+    double meanMakespan() const {
+      return nEvents ? sumMakespan / nEvents : 0.;
+    }
+    double efficiency() const {
+      return sumMakespan > 0. ? sumLowerBound / sumMakespan : 1.;
+    }
+  };
+
+  CostModel() : CostModel(Config()) {}
+  explicit CostModel(const Config &cfg);
+
+  /// The estimated time of a particle from the frozen model
+  template <typename particle_t>
+  double estimate(const particle_t &particle) const {
+    return estimate(particle.pdg(), particle.q(), casts::absEta()(particle),
+                    casts::pT()(particle), casts::E()(particle));
+  }
+
+  /// Learn the measured time of a particle
+  template <typename particle_t>
+  void learn(const particle_t &particle, double time) {
+    learn(particle.pdg(), particle.q(), casts::absEta()(particle),
+          casts::pT()(particle), casts::E()(particle), time);
+  }
+
+  /// The estimated time from the particle properties
+  double estimate(int pdg, double q, double absEta, double pT,
+                  double E) const;
+
+  /// Learn a measured time from the particle properties, it enters the
+  /// estimates only with the next freeze()
+  void learn(int pdg, double q, double absEta, double pT, double E,
+             double time);
+
+  /// Use the times learned so far for the estimates
+  void freeze();
+
+  /// Add the measured particle times of an event in dispatch order
+  void addEvent(const std::vector<double> &times);
+
+  /// The accumulated tail latencies of all events
+  Report report() const;
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  struct Bin {
+    double n = 0.;
+    double mean = 0.;
+  };
+
+  std::size_t bin(int pdg, double q, double absEta, double pT,
+                  double E) const;
+
+  Config m_cfg;
+  /// The learned times
+  std::vector<Bin> m_bins;
+  std::vector<Bin> m_classes;
+  /// The times the estimates are taken from
+  std::vector<Bin> m_frozenBins;
+  std::vector<Bin> m_frozenClasses;
+  Report m_report;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace Fatras
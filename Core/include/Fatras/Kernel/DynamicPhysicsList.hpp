@@ -0,0 +1,226 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/detail/MPL/all_of.hpp"
+#include "Acts/Utilities/detail/MPL/has_duplicates.hpp"
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/detail/physics_list_implementation.hpp"
+#include "Fatras/Kernel/detail/process_signature_check.hpp"
+#include "Fatras/Kernel/detail/selector_memo.hpp"
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief A physics list that is composed at run time
+///
+/// The processes are chosen from a closed set of known types, such that
+/// the process mix can be changed by configuration without recompiling.
+/// Each configured process is stored by value in a variant and dispatched
+/// through a jump table over the known types, there is no virtual call and
+/// no heap allocation per process. The processes are called in the order
+/// they are added, with the same abort semantics as the PhysicsList.
+///
+/// @tparam processes are the process types that can be configured
+template <typename... processes> class DynamicPhysicsList {
+  static_assert(sizeof...(processes) > 0, "no process types given");
+  static_assert(not Acts::detail::has_duplicates_v<processes...>,
+                "same process type specified several times");
+
+public:
+  DynamicPhysicsList() = default;
+  DynamicPhysicsList(const DynamicPhysicsList &) = default;
+  DynamicPhysicsList(DynamicPhysicsList &&) = default;
+
+  /// Assignment by swap, processes are not required to be assignable
+  DynamicPhysicsList &operator=(DynamicPhysicsList other) {
+    m_entries.swap(other.m_entries);
+    return *this;
+  }
+
+  /// The storage of a single configured process
+  using Entry = std::variant<processes...>;
+
+  /// The number of known process types
+  static constexpr std::size_t nTypes = sizeof...(processes);
+
+  /// The index of a known process type
+  template <typename process_t> static constexpr std::size_t typeIndex() {
+    constexpr std::size_t index = detail::type_index<process_t, processes...>();
+    static_assert(index < nTypes, "unknown process type");
+    return index;
+  }
+
+  /// Append a process
+  ///
+  /// @param process is the configured process
+  ///
+  /// @return a reference to the stored process, invalidated by the next
+  ///         change of the list
+  template <typename process_t>
+  process_t &add(process_t process = process_t()) {
+    typeIndex<process_t>();
+    m_entries.emplace_back(std::in_place_type<process_t>, std::move(process));
+    return *std::get_if<process_t>(&m_entries.back());
+  }
+
+  /// Append a default constructed process by its type index
+  ///
+  /// This allows to map configuration strings to processes in the client.
+  ///
+  /// @param index is the index of the process type
+  void addByIndex(std::size_t index) {
+    if (index >= nTypes) {
+      throw std::out_of_range("unknown process type index");
+    }
+    static constexpr auto makers = makeTable<Entry (*)()>(
+        std::index_sequence_for<processes...>(),
+        [](auto i) -> Entry (*)() {
+          return []() {
+            return Entry(std::in_place_index<decltype(i)::value>);
+          };
+        });
+    m_entries.push_back(makers[index]());
+  }
+
+  /// Remove all processes of a type
+  ///
+  /// @return the number of removed processes
+  template <typename process_t> std::size_t remove() {
+    typeIndex<process_t>();
+    // rebuild, processes are not required to be assignable
+    std::vector<Entry> kept;
+    kept.reserve(m_entries.size());
+    for (const auto &entry : m_entries) {
+      if (not std::holds_alternative<process_t>(entry)) {
+        kept.push_back(entry);
+      }
+    }
+    std::size_t n = m_entries.size() - kept.size();
+    m_entries.swap(kept);
+    return n;
+  }
+
+  /// Access the first process of a type
+  ///
+  /// @return a pointer to the process or nullptr if not configured
+  template <typename process_t> process_t *find() {
+    for (auto &entry : m_entries) {
+      if (auto process = std::get_if<process_t>(&entry)) {
+        return process;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Access the first process of a type
+  template <typename process_t> const process_t *find() const {
+    return const_cast<DynamicPhysicsList *>(this)->find<process_t>();
+  }
+
+  /// The configured processes
+  const std::vector<Entry> &entries() const { return m_entries; }
+
+  std::size_t size() const { return m_entries.size(); }
+
+  bool empty() const { return m_entries.empty(); }
+
+  void clear() { m_entries.clear(); }
+
+  /// Call operator that broadcasts the call to the configured processes
+  ///
+  /// @tparam generator_t is the random number generator type
+  /// @tparam detector_t is the detector information type used
+  /// @tparam particle_t is the particle type used in simulation
+  ///
+  /// @param[in] gen is the generator object
+  /// @param[in] det is the necessary detector information
+  /// @param[in] in is the ingoing particle (can be modified)
+  /// @param[in,out] out are the (eventually) outgoing particles
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out) const {
+    return call(gen, det, in, out, nullptr);
+  }
+
+  /// Call operator with secondary production cuts
+  ///
+  /// @param[in] gen is the generator object
+  /// @param[in] det is the necessary detector information
+  /// @param[in] in is the ingoing particle (can be modified)
+  /// @param[in,out] out are the (eventually) outgoing particles
+  /// @param[in] cuts are the kinetic energy cuts of the secondaries per
+  ///            configured process, missing ones are off
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out,
+                  const std::vector<double> &cuts) const {
+    return call(gen, det, in, out, &cuts);
+  }
+
+private:
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool call(generator_t &gen, const detector_t &det, particle_t &in,
+            std::vector<particle_t> &out,
+            const std::vector<double> *cuts) const {
+    // clang-format off
+    static_assert(Acts::detail::all_of_v<detail::process_signature_check_v<processes, generator_t, detector_t, particle_t>...>,
+                  "not all processes support the specified interface");
+    // clang-format on
+
+    using Cache = detail::physics_list_cache_t<processes...>;
+    using Call = bool (*)(const Entry &, generator_t &, const detector_t &,
+                          particle_t &, std::vector<particle_t> &, Cache &);
+    // one table per configuration and call signature
+    static constexpr auto calls =
+        makeTable<Call>(std::index_sequence_for<processes...>(), [](auto i) {
+          return Call([](const Entry &entry, generator_t &g,
+                         const detector_t &d, particle_t &p,
+                         std::vector<particle_t> &o, Cache &c) {
+            const auto &process = *std::get_if<decltype(i)::value>(&entry);
+            return detail::apply_process<species::Any>(process, g, d, p, o, c);
+          });
+        });
+
+    // the selectors shared by the processes are evaluated once
+    Cache cache;
+    for (std::size_t k = 0; k < m_entries.size(); ++k) {
+      const Entry &entry = m_entries[k];
+      const std::size_t first = out.size();
+      bool kills = calls[entry.index()](entry, gen, det, in, out, cache);
+      if (cuts and k < cuts->size()) {
+        detail::apply_production_cut(out, first, (*cuts)[k]);
+      }
+      if (kills) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename function_t, std::size_t... is, typename maker_t>
+  static constexpr std::array<function_t, sizeof...(is)>
+  makeTable(std::index_sequence<is...>, maker_t maker) {
+    return {{maker(std::integral_constant<std::size_t, is>())...}};
+  }
+
+  std::vector<Entry> m_entries;
+};
+
+} // namespace Fatras
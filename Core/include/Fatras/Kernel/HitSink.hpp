@@ -0,0 +1,177 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// Hit ordering that keeps the hits of one module in insertion order
+struct InsertionOrder {
+  template <typename hit_t>
+  bool operator()(const hit_t &, const hit_t &) const {
+    return false;
+  }
+};
+
+/// @brief Collection of the simulated hits from concurrent simulation
+///
+/// The hits are collected into a fixed number of append-only buffers,
+/// e.g. one per thread or one per primary, without any locking: every
+/// buffer must only be filled by one thread at a time. At the end of the
+/// event every buffer is sorted into buckets of the geometry identifier,
+/// and a single k-way merge produces the sorted hit collection.
+///
+/// The result is ordered by geometry identifier, then by the hit
+/// ordering, then by buffer and insertion order. It is deterministic if
+/// the hit ordering is total, or if the buffers are filled in a
+/// deterministic way, e.g. per primary.
+///
+/// @tparam hit_t Type of the simulated hit
+/// @tparam geo_id_t Type of the functor returning the geometry identifier
+///         of a hit
+/// @tparam compare_t Type of the hit ordering within one module
+template <typename hit_t, typename geo_id_t,
+          typename compare_t = InsertionOrder>
+class HitSink {
+public:
+  /// @brief Append-only buffer of one thread
+  ///
+  /// It provides the insert() of the hit collection the Simulator fills.
+  class Buffer {
+  public:
+    /// Append a hit
+    void insert(hit_t hit) {
+      m_entries.push_back({m_geoID(hit), std::move(hit)});
+      m_sorted = false;
+    }
+
+    /// The number of hits
+    std::size_t size() const { return m_entries.size(); }
+
+    /// @brief Sort the hits into the geometry identifier buckets
+    ///
+    /// Called by the merge if needed, can be called by the filling thread
+    /// to sort the buffers concurrently.
+    void close() {
+      if (m_sorted) {
+        return;
+      }
+      std::stable_sort(m_entries.begin(), m_entries.end(),
+                       [this](const Entry &a, const Entry &b) {
+                         return less(a, b);
+                       });
+      m_sorted = true;
+    }
+
+  private:
+    friend class HitSink;
+
+    struct Entry {
+      Acts::geo_id_value geoID;
+      hit_t hit;
+    };
+
+    Buffer(geo_id_t geoID, compare_t compare)
+        : m_geoID(std::move(geoID)), m_compare(std::move(compare)) {}
+
+    bool less(const Entry &a, const Entry &b) const {
+      if (a.geoID != b.geoID) {
+        return a.geoID < b.geoID;
+      }
+      return m_compare(a.hit, b.hit);
+    }
+
+    std::vector<Entry> m_entries;
+    geo_id_t m_geoID;
+    compare_t m_compare;
+    bool m_sorted = true;
+  };
+
+  /// Constructor
+  ///
+  /// @param nBuffers is the number of buffers, e.g. one per thread
+  /// @param geoID is the functor returning the hit geometry identifier
+  /// @param compare is the hit ordering within one module
+  explicit HitSink(std::size_t nBuffers, geo_id_t geoID = geo_id_t(),
+                   compare_t compare = compare_t()) {
+    m_buffers.reserve(nBuffers);
+    for (std::size_t i = 0; i < nBuffers; ++i) {
+      m_buffers.push_back(Buffer(geoID, compare));
+    }
+  }
+
+  /// The number of buffers
+  std::size_t buffers() const { return m_buffers.size(); }
+
+  /// The buffer to be filled by one thread
+  Buffer &buffer(std::size_t i) { return m_buffers[i]; }
+
+  /// The number of hits in all buffers
+  std::size_t size() const {
+    std::size_t n = 0;
+    for (const auto &buffer : m_buffers) {
+      n += buffer.size();
+    }
+    return n;
+  }
+
+  /// @brief Merge the buffers into the sorted hit collection
+  ///
+  /// Must not be called while the buffers are filled. The buffers are
+  /// emptied, their capacity is kept for the next event.
+  ///
+  /// @param hits is the collection the sorted hits are appended to
+  void merge(std::vector<hit_t> &hits) {
+    // the head position of every buffer, ordered by its current entry
+    using Head = std::pair<std::size_t, std::size_t>;
+    auto greater = [this](const Head &a, const Head &b) {
+      const auto &ea = m_buffers[a.first].m_entries[a.second];
+      const auto &eb = m_buffers[b.first].m_entries[b.second];
+      if (m_buffers[a.first].less(ea, eb)) {
+        return false;
+      }
+      if (m_buffers[a.first].less(eb, ea)) {
+        return true;
+      }
+      return a.first > b.first;
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(greater)> heads(
+        greater);
+    for (std::size_t i = 0; i < m_buffers.size(); ++i) {
+      m_buffers[i].close();
+      if (m_buffers[i].size()) {
+        heads.emplace(i, 0);
+      }
+    }
+    hits.reserve(hits.size() + size());
+    while (not heads.empty()) {
+      Head head = heads.top();
+      heads.pop();
+      auto &entries = m_buffers[head.first].m_entries;
+      hits.push_back(std::move(entries[head.second].hit));
+      if (++head.second < entries.size()) {
+        heads.push(head);
+      }
+    }
+    for (auto &buffer : m_buffers) {
+      buffer.m_entries.clear();
+    }
+  }
+
+private:
+  std::vector<Buffer> m_buffers;
+};
+
+} // namespace Fatras
@@ -0,0 +1,149 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Flat hit container indexed by geometry identifier
+///
+/// All hits of an event are kept in one contiguous array sorted by the
+/// geometry identifier, with an offset table per module: the hits of a
+/// module are a contiguous range that can be iterated without any
+/// lookup, or found with one binary search over the modules.
+///
+/// It provides the insert() of the hit collection the Simulator fills.
+/// Inserted hits are staged and become visible with build(), which the
+/// Simulator calls at the end of the event. Hits of one module keep
+/// their insertion order.
+///
+/// @tparam hit_t Type of the simulated hit
+/// @tparam geo_id_t Type of the functor returning the geometry identifier
+///         of a hit
+template <typename hit_t, typename geo_id_t> class HitStore {
+public:
+  /// A contiguous range of hits
+  struct Range {
+    const hit_t *first = nullptr;
+    const hit_t *last = nullptr;
+
+    const hit_t *begin() const { return first; }
+    const hit_t *end() const { return last; }
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    const hit_t &operator[](std::size_t i) const { return first[i]; }
+  };
+
+  /// Constructor
+  ///
+  /// @param geoID is the functor returning the hit geometry identifier
+  explicit HitStore(geo_id_t geoID = geo_id_t())
+      : m_geoID(std::move(geoID)) {}
+
+  /// Stage a hit, it is visible after the next build()
+  void insert(hit_t hit) { m_staged.push_back(std::move(hit)); }
+
+  /// @brief Sort the staged hits into the store and rebuild the offsets
+  ///
+  /// Previously built hits are kept, the staged ones are merged behind
+  /// the hits of the same module.
+  void build() {
+    if (m_staged.empty()) {
+      return;
+    }
+    auto byModule = [this](const hit_t &a, const hit_t &b) {
+      return m_geoID(a) < m_geoID(b);
+    };
+    std::stable_sort(m_staged.begin(), m_staged.end(), byModule);
+    std::size_t nBuilt = m_hits.size();
+    m_hits.insert(m_hits.end(), std::make_move_iterator(m_staged.begin()),
+                  std::make_move_iterator(m_staged.end()));
+    m_staged.clear();
+    std::inplace_merge(m_hits.begin(), m_hits.begin() + nBuilt, m_hits.end(),
+                       byModule);
+    // the offset table
+    m_modules.clear();
+    m_offsets.clear();
+    for (std::size_t i = 0; i < m_hits.size(); ++i) {
+      Acts::geo_id_value geoID = m_geoID(m_hits[i]);
+      if (m_modules.empty() or m_modules.back() != geoID) {
+        m_modules.push_back(geoID);
+        m_offsets.push_back(i);
+      }
+    }
+    m_offsets.push_back(m_hits.size());
+  }
+
+  /// Remove all hits, the capacity is kept for the next event
+  void clear() {
+    m_hits.clear();
+    m_staged.clear();
+    m_modules.clear();
+    m_offsets.clear();
+  }
+
+  /// The number of built hits
+  std::size_t size() const { return m_hits.size(); }
+
+  /// Whether there are no built hits
+  bool empty() const { return m_hits.empty(); }
+
+  /// All built hits, sorted by geometry identifier
+  Range hits() const {
+    return {m_hits.data(), m_hits.data() + m_hits.size()};
+  }
+
+  /// The number of modules with hits
+  std::size_t modules() const { return m_modules.size(); }
+
+  /// The geometry identifier of the i-th module with hits
+  Acts::geo_id_value moduleID(std::size_t i) const { return m_modules[i]; }
+
+  /// The hits of the i-th module with hits
+  Range moduleHits(std::size_t i) const {
+    return {m_hits.data() + m_offsets[i], m_hits.data() + m_offsets[i + 1]};
+  }
+
+  /// @brief The hits of a module
+  ///
+  /// @param geoID is the geometry identifier of the module
+  ///
+  /// @return the hits, empty if the module has none
+  Range find(Acts::geo_id_value geoID) const {
+    auto module = std::lower_bound(m_modules.begin(), m_modules.end(), geoID);
+    if (module == m_modules.end() or *module != geoID) {
+      return {};
+    }
+    return moduleHits(module - m_modules.begin());
+  }
+
+private:
+  geo_id_t m_geoID;
+  std::vector<hit_t> m_hits;
+  std::vector<hit_t> m_staged;
+  std::vector<Acts::geo_id_value> m_modules;
+  std::vector<std::size_t> m_offsets;
+};
+
+/// Check for a flat hit store
+template <typename T> struct is_hit_store : std::false_type {};
+
+template <typename hit_t, typename geo_id_t>
+struct is_hit_store<HitStore<hit_t, geo_id_t>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_hit_store_v = is_hit_store<T>::value;
+
+} // namespace Fatras
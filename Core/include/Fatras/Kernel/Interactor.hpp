@@ -13,10 +13,17 @@
 #include "Acts/Material/MaterialProperties.hpp"
 #include "Acts/Propagator/ActionList.hpp"
 #include "Acts/Surfaces/Surface.hpp"
+#include "Fatras/IO/Records.hpp"
+#include "Fatras/Kernel/Barcode.hpp"
+#include "Fatras/Kernel/KillVolumes.hpp"
+#include "Fatras/Kernel/LooperControl.hpp"
 #include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/PhysicsRegions.hpp"
+#include "Fatras/Physics/EnergyLoss/RangeOut.hpp"
 #include "detail/RandomNumberDistributions.hpp"
 #include <climits>
 #include <cmath>
+#include <optional>
 #include <sstream>
 #include <utility>
 
@@ -27,6 +34,17 @@ struct VoidSelector {
   bool operator()(const Acts::Surface &) const { return false; }
 };
 
+struct VoidDecay {
+
+  template <typename generator_t, typename particle_t>
+  void initialize(generator_t &, particle_t &) const {}
+
+  template <typename generator_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &, const particle_t &) const {
+    return {};
+  }
+};
+
 /// The Fatras Interactor
 ///
 /// This is the Fatras plugin to the ACTS Propagator, it replaces
@@ -39,7 +57,7 @@ struct VoidSelector {
 /// @tparam sensitive_selector_t The Selector type to identify sensitive
 /// surfaces
 /// @tparam physics_list_t Type of Extendable physics list that is called
-/// @tparam decay_list_t Type of Extendable decay list that is called
+/// @tparam decay_t Type of the decay module that is called on every step
 ///
 /// The physics list plays a central role in this DetectorInteractor
 /// it is called on each process that is defined at compile time
@@ -47,9 +65,11 @@ struct VoidSelector {
 /// the propagation cache.
 template <typename generator_t, typename particle_t, typename hit_t,
           typename hit_creator_t, typename sensitive_selector_t = VoidSelector,
-          typename physics_list_t = PhysicsList<>>
+          typename physics_list_t = PhysicsList<>,
+          typename decay_t = VoidDecay>
 struct Interactor {
   using PhysicsList_t = physics_list_t;
+  using Decay_t = decay_t;
 
   /// The random generator to be spawnper event
   generator_t *generator = nullptr;
@@ -60,6 +80,26 @@ struct Interactor {
   /// The physics list provided for this call
   physics_list_t physicsList;
 
+  /// The decay module provided for this call
+  decay_t decay;
+
+  /// The (optional) range out of slow charged particles
+  RangeOut *rangeOut = nullptr;
+
+  /// The (optional) budget of loopers
+  LooperControl *looperControl = nullptr;
+
+  /// The (optional) kill volumes and envelope
+  KillVolumes *killVolumes = nullptr;
+
+  /// The (optional) physics regions: the variant is chosen if the physics
+  /// list has variants, the production cuts are applied if it takes cuts
+  const PhysicsRegions *physicsRegions = nullptr;
+
+  /// The (optional) barcode allocator of the primary, the secondaries
+  /// keep the barcode given by the physics if not set
+  BarcodeAllocator *barcodeAllocator = nullptr;
+
   /// Simple result struct to be returned
   particle_t initialParticle;
 
@@ -81,6 +121,19 @@ struct Interactor {
 
     /// The simulated hits created along the way
     std::vector<hit_t> simulatedHits;
+
+    /// The particle was stopped by the simulation before coming to rest
+    bool stopped = false;
+
+    /// The looper bookkeeping
+    LooperControl::State looper;
+
+    /// The state of the particle terminated at a kill boundary
+    std::optional<BoundaryRecord> boundary;
+
+    /// The physics region of the current volume, found on volume entry
+    const PhysicsRegion *region = nullptr;
+    Acts::geo_id_value regionVolume = 0;
   };
 
   typedef this_result result_type;
@@ -114,6 +167,8 @@ struct Interactor {
     if (!result.initialized) {
       // set the initial particle parameters
       result.particle = initialParticle;
+      // sample the decay time once for the particle
+      decay.initialize(*generator, result.particle);
       result.initialized = true;
     }
     // get position and momentum presetp
@@ -121,15 +176,39 @@ struct Interactor {
     auto direction = stepper.direction(state.stepping);
     auto p = stepper.momentum(state.stepping);
 
-    // set the stepping position to the particle
+    // set the stepping position to the particle, the stepper time is the
+    // absolute time and the particle takes the time elapsed in the step
     result.particle.update(position, p * direction, 0., 0.,
-                           stepper.time(state.stepping));
+                           stepper.time(state.stepping) -
+                               result.particle.time());
+
+    // entering a kill volume or leaving the envelope ends the particle
+    if (killVolumes) {
+      result.boundary =
+          (*killVolumes)(state.navigation.currentSurface, result.particle);
+      if (result.boundary) {
+        result.stopped = true;
+        return;
+      }
+    }
+
+    // the decay happened within this step: the daughters are handed over
+    // as secondaries and the material at the current surface is not seen
+    const std::size_t nOutgoing = result.outgoing.size();
+    auto daughters = decay(*generator, result.particle);
+    if (not daughters.empty()) {
+      result.outgoing.insert(result.outgoing.end(), daughters.begin(),
+                             daughters.end());
+      assignBarcodes(result, nOutgoing);
+      return;
+    }
 
     // Check if the current surrface a senstive one
     bool sensitive = state.navigation.currentSurface
                          ? sensitiveSelector(*state.navigation.currentSurface)
                          : false;
     double depositedEnergy = 0.;
+    double stepInX0 = 0.;
 
     // a current surface has been assigned by the navigator
     if (state.navigation.currentSurface &&
@@ -140,9 +219,22 @@ struct Interactor {
           sMaterial->materialProperties(position);
       bool breakIndicator = false;
       if (mProperties) {
+        stepInX0 = mProperties.thicknessInX0();
+        // the region is only looked up when entering another volume
+        const Acts::geo_id_value volume =
+            state.navigation.currentSurface->geoID().volume();
+        if (physicsRegions and
+            (result.region == nullptr or volume != result.regionVolume)) {
+          result.region = &physicsRegions->find(volume);
+          result.regionVolume = volume;
+        }
         // run the Fatras physics list - only when there's material
-        breakIndicator = physicsList(*generator, mProperties, result.particle,
-                                     result.outgoing);
+        breakIndicator = applyPhysics(mProperties, result);
+        assignBarcodes(result, nOutgoing);
+        // stop the particle here if it would not get much further
+        if (rangeOut) {
+          depositedEnergy += (*rangeOut)(mProperties, result.particle);
+        }
       }
     }
     // Update the stepper cache with the current particle parameters
@@ -160,11 +252,88 @@ struct Interactor {
                      depositedEnergy, htime, result.particle);
       result.simulatedHits.push_back(std::move(simHit));
     }
+    // a looper over its budget is stopped or forwarded to the end
+    if (looperControl and result.particle and
+        (*looperControl)(*generator, result.looper, result.particle,
+                         stepInX0)) {
+      result.stopped = true;
+    }
   }
 
   /// Pure observer interface
   /// This does not apply to the Fatras simulator
   template <typename propagator_state_t, typename stepper_t>
   void operator()(propagator_state_t &, stepper_t &) const {}
+
+private:
+  /// Run the physics list in the region of the current volume
+  ///
+  /// @param detector is the material of the current surface
+  /// @param result is the mutable result cache object
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename detector_t>
+  bool applyPhysics(const detector_t &detector, result_type &result) const {
+    if (result.region) {
+      if constexpr (detail::physics_takes_v<physics_list_t, generator_t,
+                                            detector_t, particle_t,
+                                            PhysicsRegion>) {
+        return physicsList(*generator, detector, result.particle,
+                           result.outgoing, *result.region);
+      } else if constexpr (detail::physics_takes_v<
+                               physics_list_t, generator_t, detector_t,
+                               particle_t, std::vector<double>>) {
+        return physicsList(*generator, detector, result.particle,
+                           result.outgoing, result.region->cuts);
+      }
+    }
+    return physicsList(*generator, detector, result.particle,
+                       result.outgoing);
+  }
+
+  /// Assign the secondary barcodes to the new outgoing particles
+  ///
+  /// @param result is the mutable result cache object
+  /// @param first is the first outgoing particle to be assigned
+  void assignBarcodes(result_type &result, std::size_t first) const {
+    if (barcodeAllocator == nullptr) {
+      return;
+    }
+    Barcode parent(result.particle.barcode());
+    for (std::size_t i = first; i < result.outgoing.size(); ++i) {
+      result.outgoing[i].setBarcode((*barcodeAllocator)(parent).value());
+    }
+  }
 };
+
+/// The Fatras aborter for the propagation
+///
+/// This ends the propagation as soon as the particle simulated by the
+/// Interactor is not alive anymore, e.g. because it decayed, it came to
+/// rest or it passed one of its limits, or when the Interactor stopped it.
+///
+/// @tparam interactor_t Type of the Interactor in the action list
+template <typename interactor_t> struct ParticleKilled {
+
+  /// The aborter is conditional on the result of the Interactor
+  using action_type = interactor_t;
+
+  /// Check the interactor particle
+  ///
+  /// @param result is the result of the Interactor
+  ///
+  /// @return indicator if the propagation is to be aborted
+  template <typename propagator_state_t, typename stepper_t>
+  bool operator()(const typename interactor_t::result_type &result,
+                  propagator_state_t &, const stepper_t &) const {
+    return result.initialized and (result.stopped or not result.particle);
+  }
+
+  /// Unconditional call operator is never aborting
+  template <typename propagator_state_t, typename stepper_t>
+  bool operator()(propagator_state_t &, const stepper_t &) const {
+    return false;
+  }
+};
+
 } // namespace Fatras
@@ -0,0 +1,173 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/IO/Records.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Termination of particles at the end of the region of interest
+///
+/// A particle is terminated when it reaches a surface of one of the kill
+/// volumes, e.g. the calorimeters, or when it leaves the cylindrical kill
+/// envelope, e.g. the tracker. Its state is kept in a boundary record;
+/// for the envelope, the particle is first moved back along its last step
+/// on a straight line to the envelope, such that the record and the final
+/// particle agree.
+///
+/// The counters are thread-safe and shared by all interactors.
+class KillVolumes {
+public:
+  struct Config {
+    /// The identifiers of the kill volumes, sorted on construction
+    std::vector<Acts::geo_id_value> volumes = {};
+    /// The kill envelope
+    double maxRadius = std::numeric_limits<double>::infinity();
+    double maxAbsZ = std::numeric_limits<double>::infinity();
+  };
+
+  struct Counters {
+    std::uint64_t inVolume = 0;
+    /// The particles terminated per kill volume, in the order of the
+    /// configured volumes
+    std::vector<std::uint64_t> perVolume = {};
+    std::uint64_t atEnvelope = 0;
+  };
+
+  KillVolumes() = default;
+  explicit KillVolumes(Config cfg) : m_cfg(std::move(cfg)) {
+    std::sort(m_cfg.volumes.begin(), m_cfg.volumes.end());
+    m_cfg.volumes.erase(
+        std::unique(m_cfg.volumes.begin(), m_cfg.volumes.end()),
+        m_cfg.volumes.end());
+    m_perVolume = std::vector<std::atomic<std::uint64_t>>(m_cfg.volumes.size());
+    for (auto &count : m_perVolume) {
+      count = 0;
+    }
+  }
+
+  /// Whether a volume is a kill volume
+  bool isKillVolume(Acts::geo_id_value volume) const {
+    return volumeIndex(volume) < m_cfg.volumes.size();
+  }
+
+  /// Whether a position is outside the kill envelope
+  bool isOutside(const Acts::Vector3D &position) const {
+    return std::hypot(position.x(), position.y()) > m_cfg.maxRadius or
+           std::abs(position.z()) > m_cfg.maxAbsZ;
+  }
+
+  /// @brief Check whether a particle is to be terminated
+  ///
+  /// @param surface is the current surface, can be nullptr
+  /// @param particle is the particle after the step, it is moved back to
+  ///        the envelope if it is terminated there
+  ///
+  /// @return the boundary record if the particle is terminated
+  template <typename particle_t>
+  std::optional<BoundaryRecord> operator()(const Acts::Surface *surface,
+                                           particle_t &particle) {
+    if (surface) {
+      const std::size_t index = volumeIndex(surface->geoID().volume());
+      if (index < m_cfg.volumes.size()) {
+        ++m_inVolume;
+        ++m_perVolume[index];
+        return makeBoundaryRecord(particle, surface->geoID().value());
+      }
+    }
+    if (not isOutside(particle.position())) {
+      return std::nullopt;
+    }
+    ++m_atEnvelope;
+    const double p = particle.momentum().norm();
+    if (p > 0.) {
+      const Acts::Vector3D direction = particle.momentum() / p;
+      const double s = backStep(particle.position(), direction);
+      const double E = std::sqrt(p * p + particle.m() * particle.m());
+      // the update counts the back step as path, its proper time is thus
+      // taken back twice
+      particle.advanceProperTime(-2. * s * particle.m() /
+                                 (p * Acts::units::_c));
+      particle.update(particle.position() - s * direction,
+                      particle.momentum(), 0., 0.,
+                      -s * E / (p * Acts::units::_c));
+    }
+    return makeBoundaryRecord(particle, 0);
+  }
+
+  /// A snapshot of the counters
+  Counters counters() const {
+    Counters result;
+    result.inVolume = m_inVolume;
+    result.atEnvelope = m_atEnvelope;
+    for (const auto &count : m_perVolume) {
+      result.perVolume.push_back(count);
+    }
+    return result;
+  }
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  /// The index of a kill volume, the number of volumes if it is none
+  std::size_t volumeIndex(Acts::geo_id_value volume) const {
+    auto it =
+        std::lower_bound(m_cfg.volumes.begin(), m_cfg.volumes.end(), volume);
+    if (it == m_cfg.volumes.end() or *it != volume) {
+      return m_cfg.volumes.size();
+    }
+    return it - m_cfg.volumes.begin();
+  }
+
+  /// The straight path back to the envelope from a position outside,
+  /// only through the boundaries the particle is moving out of
+  double backStep(const Acts::Vector3D &position,
+                  const Acts::Vector3D &direction) const {
+    double s = 0.;
+    // back through the barrel
+    const double r2 = position.x() * position.x() +
+                      position.y() * position.y();
+    const double R2 = m_cfg.maxRadius * m_cfg.maxRadius;
+    const double d2 = direction.x() * direction.x() +
+                      direction.y() * direction.y();
+    const double pd =
+        position.x() * direction.x() + position.y() * direction.y();
+    if (r2 > R2 and d2 > 0. and pd > 0.) {
+      const double discriminant = pd * pd - d2 * (r2 - R2);
+      if (discriminant >= 0.) {
+        s = std::max(s, (pd - std::sqrt(discriminant)) / d2);
+      }
+    }
+    // back through the end caps
+    const double z = std::abs(position.z());
+    if (z > m_cfg.maxAbsZ and position.z() * direction.z() > 0.) {
+      s = std::max(s, (z - m_cfg.maxAbsZ) / std::abs(direction.z()));
+    }
+    return s;
+  }
+
+  Config m_cfg;
+  std::atomic<std::uint64_t> m_inVolume{0};
+  std::vector<std::atomic<std::uint64_t>> m_perVolume;
+  std::atomic<std::uint64_t> m_atEnvelope{0};
+};
+
+} // namespace Fatras
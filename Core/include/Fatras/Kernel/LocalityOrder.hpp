@@ -0,0 +1,163 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Helpers.hpp"
+#include "Fatras/Kernel/CacheCounter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Geometric-locality ordering of the pending particles
+///
+/// The particles are binned into tiles of their origin, eta and phi, and
+/// processed tile after tile: successive propagations then cross the same
+/// surfaces and material bins, which are still in the cache.
+///
+/// The origin is binned in the transverse radius of the production vertex
+/// with the given boundaries, e.g. those of the detector volumes.
+///
+/// The counters are thread-safe and allow to compare runs with and without
+/// sorting: the number of tile switches between successive particles, and
+/// the hardware cache references and misses during the simulation, where
+/// available.
+class LocalityOrder {
+public:
+  struct Config {
+    /// Sort the particles, otherwise only count
+    bool sort = true;
+    /// The number of eta tiles in [-maxAbsEta, maxAbsEta]
+    std::size_t nEtaTiles = 16;
+    double maxAbsEta = 4.;
+    /// The number of phi tiles
+    std::size_t nPhiTiles = 16;
+    /// The radial boundaries of the origin bins
+    std::vector<double> originRadii = {};
+  };
+
+  struct Counters {
+    std::uint64_t particles = 0;
+    /// The tile switches in the given particle order
+    std::uint64_t switchesBefore = 0;
+    /// The tile switches in the processing order
+    std::uint64_t switchesAfter = 0;
+    std::uint64_t cacheReferences = 0;
+    std::uint64_t cacheMisses = 0;
+
+    double missRate() const {
+      return cacheReferences ? double(cacheMisses) / cacheReferences : 0.;
+    }
+  };
+
+  LocalityOrder() = default;
+  explicit LocalityOrder(Config cfg) : m_cfg(std::move(cfg)) {}
+
+  /// The tile of a particle
+  template <typename particle_t> std::size_t tile(const particle_t &p) const {
+    const auto &position = p.position();
+    const double r = std::hypot(position.x(), position.y());
+    const std::size_t origin =
+        std::upper_bound(m_cfg.originRadii.begin(), m_cfg.originRadii.end(),
+                         r) -
+        m_cfg.originRadii.begin();
+    const double eta = Acts::VectorHelpers::eta(p.momentum());
+    const double phi = Acts::VectorHelpers::phi(p.momentum());
+    const std::size_t etaTile =
+        bin(eta + m_cfg.maxAbsEta, 2. * m_cfg.maxAbsEta, m_cfg.nEtaTiles);
+    const std::size_t phiTile = bin(phi + M_PI, 2. * M_PI, m_cfg.nPhiTiles);
+    return (origin * m_cfg.nEtaTiles + etaTile) * m_cfg.nPhiTiles + phiTile;
+  }
+
+  /// @brief Sort a range of the processing order by tile
+  ///
+  /// The order within a tile is kept. The switches after sorting are
+  /// counted on the sorted order, the caller must thus not rearrange the
+  /// range afterwards, or the counters describe an order never processed.
+  ///
+  /// @tparam particles_t Type of the indexable particle collection
+  ///
+  /// @param particles are the particles
+  /// @param order is the processing order, its range [begin, end) is sorted
+  /// @param begin is the first position to be sorted
+  template <typename particles_t>
+  void sort(const particles_t &particles, std::vector<std::size_t> &order,
+            std::size_t begin) {
+    std::vector<std::size_t> tiles(order.size());
+    for (std::size_t j = begin; j < order.size(); ++j) {
+      tiles[order[j]] = tile(particles[order[j]]);
+    }
+    std::uint64_t before = switches(tiles, order, begin);
+    if (m_cfg.sort) {
+      std::stable_sort(order.begin() + begin, order.end(),
+                       [&](std::size_t a, std::size_t b) {
+                         return tiles[a] < tiles[b];
+                       });
+    }
+    m_counters.particles += order.size() - begin;
+    m_counters.switchesBefore += before;
+    m_counters.switchesAfter += switches(tiles, order, begin);
+  }
+
+  /// Add the hardware cache counts of a simulation
+  void addCacheCounts(const CacheCounter::Counts &counts) {
+    m_counters.cacheReferences += counts.references;
+    m_counters.cacheMisses += counts.misses;
+  }
+
+  /// A snapshot of the counters
+  Counters counters() const {
+    Counters result;
+    result.particles = m_counters.particles;
+    result.switchesBefore = m_counters.switchesBefore;
+    result.switchesAfter = m_counters.switchesAfter;
+    result.cacheReferences = m_counters.cacheReferences;
+    result.cacheMisses = m_counters.cacheMisses;
+    return result;
+  }
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  static std::size_t bin(double value, double range, std::size_t nBins) {
+    if (not(value > 0.)) {
+      return 0;
+    }
+    return std::min(static_cast<std::size_t>(value / range * nBins),
+                    nBins - 1);
+  }
+
+  static std::uint64_t switches(const std::vector<std::size_t> &tiles,
+                                const std::vector<std::size_t> &order,
+                                std::size_t begin) {
+    std::uint64_t result = 0;
+    for (std::size_t j = begin + 1; j < order.size(); ++j) {
+      result += tiles[order[j]] != tiles[order[j - 1]];
+    }
+    return result;
+  }
+
+  struct AtomicCounters {
+    std::atomic<std::uint64_t> particles{0};
+    std::atomic<std::uint64_t> switchesBefore{0};
+    std::atomic<std::uint64_t> switchesAfter{0};
+    std::atomic<std::uint64_t> cacheReferences{0};
+    std::atomic<std::uint64_t> cacheMisses{0};
+  };
+
+  Config m_cfg;
+  AtomicCounters m_counters;
+};
+
+} // namespace Fatras
@@ -0,0 +1,254 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Fatras {
+
+/// @brief Budget and fast-forward of low pT loopers
+///
+/// In the solenoid field along z, a charged particle moves on a helix of
+/// radius R = pT / (|q| B). It is a looper if the helix stays inside the
+/// tracker radius and would cross the same surfaces turn after turn.
+///
+/// Loopers are given a budget of turns, path length and steps. Once one
+/// of them is exceeded, the particle is either stopped, or the remaining
+/// turns up to the end of the tracker are skipped on the analytic helix:
+/// the energy loss and the material per turn measured so far are applied
+/// for the skipped turns, the first as a mean loss, the latter as a
+/// Gaussian deflection with the Highland width. A particle that runs out
+/// of energy first comes to rest on the way.
+///
+/// The counters are thread-safe and shared by all interactors.
+class LooperControl {
+public:
+  struct Config {
+    /// The solenoid field along z
+    double bField = 2. * Acts::units::_T;
+    /// The tracker envelope
+    double trackerRadius = 1. * Acts::units::_m;
+    double trackerHalfLength = 3. * Acts::units::_m;
+    /// The budget of a looper
+    double maxTurns = 2.;
+    double maxPath = std::numeric_limits<double>::max();
+    std::size_t maxSteps = std::numeric_limits<std::size_t>::max();
+    /// Skip the remaining turns, otherwise stop the looper
+    bool fastForward = true;
+  };
+
+  /// The per-particle bookkeeping, kept in the interactor result
+  struct State {
+    bool initialized = false;
+    bool looper = false;
+    std::size_t steps = 0;
+    double path = 0.;
+    double turns = 0.;
+    double pathInX0 = 0.;
+    double initialEnergy = 0.;
+    double lastPhi = 0.;
+    Acts::Vector3D lastPosition = Acts::Vector3D(0., 0., 0.);
+  };
+
+  struct Counters {
+    std::uint64_t loopers = 0;
+    std::uint64_t stopped = 0;
+    std::uint64_t forwarded = 0;
+    double skippedTurns = 0.;
+  };
+
+  LooperControl() = default;
+  explicit LooperControl(const Config &cfg) : m_cfg(cfg) {}
+
+  /// The helix radius of a particle
+  template <typename particle_t> double radius(const particle_t &p) const {
+    return p.pT() / std::abs(p.q() * m_cfg.bField);
+  }
+
+  /// Whether the helix of a charged particle stays inside the tracker
+  template <typename particle_t> bool isLooper(const particle_t &p) const {
+    if (p.q() == 0. or m_cfg.bField == 0. or not(p.pT() > 0.)) {
+      return false;
+    }
+    const double R = radius(p);
+    const Acts::Vector3D centre = helixCentre(p, R);
+    return std::hypot(centre.x(), centre.y()) + R < m_cfg.trackerRadius;
+  }
+
+  /// @brief Account for a step and enforce the budget
+  ///
+  /// @param generator is the random number generator
+  /// @param state is the bookkeeping of the particle
+  /// @param particle is the particle after the step, it is forwarded
+  ///        to the end of the tracker if over budget
+  /// @param stepInX0 is the material crossed in the step
+  ///
+  /// @return whether the particle is to be stopped
+  template <typename generator_t, typename particle_t>
+  bool operator()(generator_t &generator, State &state, particle_t &particle,
+                  double stepInX0) {
+    const double phi = Acts::VectorHelpers::phi(particle.momentum());
+    if (not state.initialized) {
+      state.initialized = true;
+      state.initialEnergy = particle.E();
+      state.lastPhi = phi;
+      state.lastPosition = particle.position();
+    }
+    ++state.steps;
+    state.path += (particle.position() - state.lastPosition).norm();
+    state.pathInX0 += stepInX0;
+    state.turns += std::abs(std::remainder(phi - state.lastPhi, 2. * M_PI)) /
+                   (2. * M_PI);
+    state.lastPhi = phi;
+    state.lastPosition = particle.position();
+
+    if (not isLooper(particle)) {
+      return false;
+    }
+    if (not state.looper) {
+      state.looper = true;
+      ++m_loopers;
+    }
+    if (state.turns <= m_cfg.maxTurns and state.path <= m_cfg.maxPath and
+        state.steps <= m_cfg.maxSteps) {
+      return false;
+    }
+    if (m_cfg.fastForward) {
+      forward(generator, state, particle);
+      ++m_forwarded;
+    } else {
+      ++m_stopped;
+    }
+    return true;
+  }
+
+  /// A snapshot of the counters
+  Counters counters() const {
+    Counters result;
+    result.loopers = m_loopers;
+    result.stopped = m_stopped;
+    result.forwarded = m_forwarded;
+    result.skippedTurns = m_skippedTurns;
+    return result;
+  }
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  /// The centre of the helix in the transverse plane
+  template <typename particle_t>
+  Acts::Vector3D helixCentre(const particle_t &p, double R) const {
+    // positive charges turn clockwise in a field along +z
+    const double s = p.q() * m_cfg.bField > 0. ? 1. : -1.;
+    const Acts::Vector3D &d = p.momentum();
+    return p.position() +
+           s * R / p.pT() * Acts::Vector3D(d.y(), -d.x(), 0.);
+  }
+
+  /// Skip the remaining turns up to the end of the tracker
+  template <typename generator_t, typename particle_t>
+  void forward(generator_t &generator, const State &state,
+               particle_t &particle) {
+    const double turns = std::max(state.turns, 1e-3);
+    const double lossPerTurn =
+        std::max(state.initialEnergy - particle.E(), 0.) / turns;
+    const double x0PerTurn = state.pathInX0 / turns;
+
+    // the turns to the end of the tracker and until the particle stops
+    const double R = radius(particle);
+    const double pz = particle.momentum().z();
+    const double pitch = 2. * M_PI * R * pz / particle.pT();
+    double nTurns = std::numeric_limits<double>::infinity();
+    if (pitch != 0.) {
+      const double z = particle.position().z();
+      const double end =
+          pitch > 0. ? m_cfg.trackerHalfLength : -m_cfg.trackerHalfLength;
+      nTurns = std::max((end - z) / pitch, 0.);
+    }
+    const double kineticEnergy = particle.E() - particle.m();
+    const bool atRest =
+        lossPerTurn > 0. and lossPerTurn * nTurns >= kineticEnergy;
+    if (atRest) {
+      nTurns = kineticEnergy / lossPerTurn;
+    } else if (std::isinf(nTurns)) {
+      // it never leaves, the particle is stopped where it is
+      nTurns = 0.;
+    }
+    double skipped = m_skippedTurns.load();
+    while (not m_skippedTurns.compare_exchange_weak(skipped,
+                                                    skipped + nTurns)) {
+    }
+
+    // the position and direction on the helix after the skipped turns
+    const double s = particle.q() * m_cfg.bField > 0. ? 1. : -1.;
+    const Acts::Vector3D centre = helixCentre(particle, R);
+    const double alpha = -s * 2. * M_PI * std::fmod(nTurns, 1.);
+    const double c = std::cos(alpha);
+    const double sn = std::sin(alpha);
+    auto rotate = [&](const Acts::Vector3D &v) {
+      return Acts::Vector3D(c * v.x() - sn * v.y(), sn * v.x() + c * v.y(),
+                            v.z());
+    };
+    Acts::Vector3D offset = particle.position() - centre;
+    Acts::Vector3D position = centre + rotate(offset);
+    position.z() += nTurns * pitch;
+    Acts::Vector3D momentum = rotate(particle.momentum());
+    // the time along the skipped helix at the current velocity
+    const double turnLength = 2. * M_PI * R * particle.p() / particle.pT();
+    const double beta = particle.p() / particle.E();
+    const double deltaTime = nTurns * turnLength / (beta * Acts::units::_c);
+    // the update takes the proper time along the chord, the remainder to
+    // the helix length is added explicitly
+    const double chord = (position - particle.position()).norm();
+    const double properTimePerLength =
+        particle.m() / (particle.p() * Acts::units::_c);
+    particle.update(position, momentum, nTurns * x0PerTurn, 0., deltaTime);
+    particle.advanceProperTime((nTurns * turnLength - chord) *
+                               properTimePerLength);
+    if (atRest) {
+      particle.energyLoss(particle.E());
+      return;
+    }
+
+    // the mean energy loss and the scattering of the skipped material
+    particle.energyLoss(nTurns * lossPerTurn);
+    const double x = nTurns * x0PerTurn;
+    if (x > 0. and particle.p() > 0.) {
+      const double beta = particle.p() / particle.E();
+      const double theta0 = 13.6 * Acts::units::_MeV / (beta * particle.p()) *
+                            std::abs(particle.q()) * std::sqrt(x) *
+                            (1. + 0.038 * std::log(x / (beta * beta)));
+      BasicGaussDist<double> gaussDist(0., std::max(theta0, 0.));
+      const Acts::Vector3D direction = particle.momentum().normalized();
+      Acts::Vector3D u = direction.unitOrthogonal();
+      Acts::Vector3D v = direction.cross(u);
+      Acts::Vector3D scattered =
+          (direction + gaussDist(generator) * u + gaussDist(generator) * v)
+              .normalized();
+      particle.scatter(particle.p() * scattered);
+    }
+  }
+
+  Config m_cfg;
+  std::atomic<std::uint64_t> m_loopers{0};
+  std::atomic<std::uint64_t> m_stopped{0};
+  std::atomic<std::uint64_t> m_forwarded{0};
+  std::atomic<double> m_skippedTurns{0.};
+};
+
+} // namespace Fatras
@@ -0,0 +1,253 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Fatras {
+
+/// Typedef the pdg code
+typedef int pdg_type;
+
+/// Typedef the process code
+typedef unsigned int process_code;
+
+/// Typedef barcode, wide enough for the hierarchical encoding
+typedef std::uint64_t barcode_type;
+
+/// @brief The particle used by the simulation
+///
+/// It provides the interface the Interactor, the Processes and the
+/// physics modules expect, with a layout that fits into two cache lines:
+/// the kinematics (position, momentum, momentum magnitude, mass) fill the
+/// first one, the times and the bookkeeping (limits, identification,
+/// status) the second one.
+///
+/// Only the momentum magnitude is stored with the momentum, since nearly
+/// every module reads it; E, pT, beta and gamma are derived on demand.
+/// The material budget paths and the limits are kept in single precision,
+/// which is ample for a limit check and halves their footprint.
+class alignas(64) Particle {
+
+public:
+  /// Default
+  Particle() = default;
+
+  /// @brief Construct a particle consistently
+  ///
+  /// @param position The particle position at construction
+  /// @param momentum The particle momentum at construction
+  /// @param m The particle mass
+  /// @param q The particle charge
+  /// @param pdg The particle pdg code
+  /// @param barcode The particle barcode
+  /// @param startTime The time at construction
+  Particle(const Acts::Vector3D &position, const Acts::Vector3D &momentum,
+           double m, double q, pdg_type pdg = 0, barcode_type barcode = 0,
+           double startTime = 0.)
+      : m_position(position), m_momentum(momentum), m_p(momentum.norm()),
+        m_m(m), m_time(startTime), m_barcode(barcode),
+        m_q(static_cast<float>(q)), m_pdg(pdg) {}
+
+  /// @brief Set the limits
+  ///
+  /// @param x0Limit the limit in X0 to be passed
+  /// @param l0Limit the limit in L0 to be passed
+  /// @param timeLimit the readout time limit to be passed
+  void setLimits(double x0Limit, double l0Limit,
+                 double timeLimit = std::numeric_limits<double>::max()) {
+    m_limitInX0 = narrow(x0Limit);
+    m_limitInL0 = narrow(l0Limit);
+    m_timeLimit = narrow(timeLimit);
+  }
+
+  /// @brief Set the proper time limit, i.e. the sampled decay time
+  ///
+  /// @param properTimeLimit the proper time limit to be passed
+  void setProperTimeLimit(double properTimeLimit) {
+    m_properTimeLimit = properTimeLimit;
+  }
+
+  /// @brief Set the barcode, e.g. when the particle is a secondary
+  ///
+  /// @param barcode the barcode to be set
+  void setBarcode(barcode_type barcode) { m_barcode = barcode; }
+
+  /// @brief Update the particle with a new momentum from scattering
+  ///
+  /// @param nmomentum is the momentum after scattering
+  void scatter(Acts::Vector3D nmomentum) {
+    m_momentum = std::move(nmomentum);
+    m_p = m_momentum.norm();
+  }
+
+  /// @brief Update the particle with applying energy loss
+  ///
+  /// @param deltaE is the energy loss to be applied
+  void energyLoss(double deltaE) {
+    double nE = E() - deltaE;
+    // particle falls to rest
+    if (nE <= m_m) {
+      m_momentum = Acts::Vector3D(0., 0., 0.);
+      m_p = 0.;
+      m_alive = false;
+      return;
+    }
+    double np = std::sqrt(nE * nE - m_m * m_m);
+    m_momentum *= (np / m_p);
+    m_p = np;
+  }
+
+  /// @brief Update the particle with a new position and momentum,
+  /// this corresponds to a step update
+  ///
+  /// @param position New position after update
+  /// @param momentum New momentum after update
+  /// @param deltaPathX0 passed since last step
+  /// @param deltaPathL0 passed since last step
+  /// @param deltaTime The time elapsed
+  ///
+  /// @return break condition
+  bool update(const Acts::Vector3D &position, const Acts::Vector3D &momentum,
+              double deltaPathX0 = 0., double deltaPathL0 = 0.,
+              double deltaTime = 0.) {
+    double deltaPath = (position - m_position).norm();
+    m_position = position;
+    m_momentum = momentum;
+    m_p = momentum.norm();
+    if (m_p) {
+      // set parameters and check limits
+      m_pathInX0 += static_cast<float>(deltaPathX0);
+      m_pathInL0 += static_cast<float>(deltaPathL0);
+      m_time += deltaTime;
+      // proper time elapsed along the path
+      m_properTime += deltaPath * m_m / (m_p * Acts::units::_c);
+      if (m_pathInX0 >= m_limitInX0 || m_pathInL0 >= m_limitInL0 ||
+          m_time > m_timeLimit || m_properTime >= m_properTimeLimit) {
+        m_alive = false;
+      }
+    }
+    return !m_alive;
+  }
+
+  /// @brief Advance the proper time along a path the position update
+  /// does not follow, e.g. the turns of a helix
+  ///
+  /// @param deltaProperTime The proper time elapsed
+  ///
+  /// @return break condition
+  bool advanceProperTime(double deltaProperTime) {
+    m_properTime += deltaProperTime;
+    if (m_properTime >= m_properTimeLimit) {
+      m_alive = false;
+    }
+    return !m_alive;
+  }
+
+  /// @brief Access methods: position
+  const Acts::Vector3D &position() const { return m_position; }
+
+  /// @brief Access methods: momentum
+  const Acts::Vector3D &momentum() const { return m_momentum; }
+
+  /// @brief Access methods: p
+  double p() const { return m_p; }
+
+  /// @brief Access methods: pT, derived from the momentum
+  double pT() const { return Acts::VectorHelpers::perp(m_momentum); }
+
+  /// @brief Access methods: E, derived from p and m
+  double E() const { return std::sqrt(m_p * m_p + m_m * m_m); }
+
+  /// @brief Access methods: m
+  double m() const { return m_m; }
+
+  /// @brief Access methods: beta, derived from p and E
+  double beta() const { return m_p / E(); }
+
+  /// @brief Access methods: gamma, derived from E and m
+  double gamma() const { return E() / m_m; }
+
+  /// @brief Access methods: charge
+  double q() const { return m_q; }
+
+  /// @brief Access methods: pdg code
+  pdg_type pdg() const { return m_pdg; }
+
+  /// @brief Access methods: barcode
+  barcode_type barcode() const { return m_barcode; }
+
+  /// @brief Access methods: path/X0
+  double pathInX0() const { return m_pathInX0; }
+
+  /// @brief Access methods: limit/X0
+  double limitInX0() const { return m_limitInX0; }
+
+  /// @brief Access methods: path/L0
+  double pathInL0() const { return m_pathInL0; }
+
+  /// @brief Access methods: limit/L0
+  double limitInL0() const { return m_limitInL0; }
+
+  /// @brief Access methods: time
+  double time() const { return m_time; }
+
+  /// @brief Access methods: time limit
+  double timeLimit() const { return m_timeLimit; }
+
+  /// @brief Access methods: proper time
+  double properTime() const { return m_properTime; }
+
+  /// @brief Access methods: proper time limit
+  double properTimeLimit() const { return m_properTimeLimit; }
+
+  /// @brief boolean operator indicating the particle to be alive
+  operator bool() const { return m_alive; }
+
+private:
+  /// Clamp a limit into the single precision range
+  static float narrow(double limit) {
+    return static_cast<float>(
+        std::min(limit, double(std::numeric_limits<float>::max())));
+  }
+
+  // first cache line: kinematics
+  Acts::Vector3D m_position = Acts::Vector3D(0., 0., 0.); //!< kinematic info
+  Acts::Vector3D m_momentum = Acts::Vector3D(0., 0., 0.); //!< kinematic info
+  double m_p = 0.; //!< momentum magnitude
+  double m_m = 0.; //!< particle mass
+
+  // second cache line: times and bookkeeping
+  double m_time = 0.;       //!< passed time elapsed
+  double m_properTime = 0.; //!< passed proper time
+  double m_properTimeLimit =
+      std::numeric_limits<double>::max(); //!< proper time limit
+  barcode_type m_barcode = 0;             //!< barcode of the particle
+
+  float m_pathInX0 = 0.; //!< passed path in X0
+  float m_limitInX0 = std::numeric_limits<float>::max(); //!< limit in X0
+  float m_pathInL0 = 0.; //!< passed path in L0
+  float m_limitInL0 = std::numeric_limits<float>::max(); //!< limit in L0
+  float m_timeLimit = std::numeric_limits<float>::max(); //!< time limit
+
+  float m_q = 0.;      //!< the charge
+  pdg_type m_pdg = 0;  //!< pdg code of the particle
+  bool m_alive = true; //!< the particle is alive
+};
+
+static_assert(sizeof(Particle) <= 128,
+              "Particle is meant to fit into two cache lines");
+
+} // namespace Fatras
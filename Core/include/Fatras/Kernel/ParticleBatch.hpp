@@ -0,0 +1,52 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Fatras {
+
+/// @brief A structure-of-arrays view of a batch of particles
+///
+/// This is the input of the batch selection: every quantity is a
+/// contiguous column of `size` entries, such that the selectors can
+/// evaluate them in simple loops the compiler vectorises. The batch does
+/// not own the columns.
+struct ParticleBatch {
+  /// The number of particles in the batch
+  std::size_t size = 0;
+
+  /// The production vertex
+  const double *x = nullptr;
+  const double *y = nullptr;
+  const double *z = nullptr;
+
+  /// The momentum
+  const double *px = nullptr;
+  const double *py = nullptr;
+  const double *pz = nullptr;
+
+  /// Mass and charge
+  const double *m = nullptr;
+  const double *q = nullptr;
+
+  /// The pdg code
+  const int *pdg = nullptr;
+
+  /// A view of the particles [begin, end) of this batch
+  ParticleBatch slice(std::size_t begin, std::size_t end) const {
+    auto offset = [begin](auto *column) {
+      return column ? column + begin : column;
+    };
+    return {end - begin, offset(x),  offset(y),  offset(z), offset(px),
+            offset(py),  offset(pz), offset(m),  offset(q), offset(pdg)};
+  }
+};
+
+} // namespace Fatras
@@ -0,0 +1,310 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Fatras/Kernel/Particle.hpp"
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Fatras {
+
+/// The simulation status of a particle in the store
+enum class ParticleStatus : std::uint8_t { Alive = 0, Stopped = 1 };
+
+/// @brief Structure-of-arrays particle store of one event
+///
+/// Every particle quantity is kept in its own contiguous column, which
+/// is about 80 bytes per particle and can be handed to the batch
+/// selection as a ParticleBatch without copying.
+///
+/// Indices are stable: particles are never removed or reordered. The
+/// primaries occupy the range [0, primaries()), the secondaries created
+/// by the simulation are appended behind them.
+class ParticleStore {
+public:
+  /// The stable particle index
+  using Index = std::uint32_t;
+
+  /// @brief Read-only view of one particle in the store
+  ///
+  /// It offers the accessors the selectors use, such that they can be
+  /// evaluated on the store without materialising a particle.
+  class Proxy {
+  public:
+    Proxy(const ParticleStore &store, Index index)
+        : m_store(&store), m_index(index) {}
+
+    /// The index in the store
+    Index index() const { return m_index; }
+
+    /// @brief Access methods: position
+    Acts::Vector3D position() const {
+      return Acts::Vector3D(m_store->m_x[m_index], m_store->m_y[m_index],
+                            m_store->m_z[m_index]);
+    }
+
+    /// @brief Access methods: momentum
+    Acts::Vector3D momentum() const {
+      return Acts::Vector3D(m_store->m_px[m_index], m_store->m_py[m_index],
+                            m_store->m_pz[m_index]);
+    }
+
+    /// @brief Access methods: p
+    double p() const { return momentum().norm(); }
+
+    /// @brief Access methods: pT
+    double pT() const { return Acts::VectorHelpers::perp(momentum()); }
+
+    /// @brief Access methods: E
+    double E() const { return std::sqrt(p() * p() + m() * m()); }
+
+    /// @brief Access methods: m
+    double m() const { return m_store->m_m[m_index]; }
+
+    /// @brief Access methods: charge
+    double q() const { return m_store->m_q[m_index]; }
+
+    /// @brief Access methods: pdg code
+    pdg_type pdg() const { return m_store->m_pdg[m_index]; }
+
+    /// @brief Access methods: barcode
+    barcode_type barcode() const { return m_store->m_barcode[m_index]; }
+
+    /// @brief Access methods: time
+    double time() const { return m_store->m_time[m_index]; }
+
+    /// @brief Access methods: status
+    ParticleStatus status() const { return m_store->m_status[m_index]; }
+
+    /// @brief boolean operator indicating the particle to be alive
+    operator bool() const { return status() == ParticleStatus::Alive; }
+
+  private:
+    const ParticleStore *m_store;
+    Index m_index;
+  };
+
+  /// Forward iterator over the particles, yields proxies
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Proxy;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Proxy;
+
+    Iterator(const ParticleStore &store, Index index)
+        : m_store(&store), m_index(index) {}
+
+    Proxy operator*() const { return Proxy(*m_store, m_index); }
+    Iterator &operator++() {
+      ++m_index;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator before = *this;
+      ++m_index;
+      return before;
+    }
+    bool operator==(const Iterator &other) const {
+      return m_index == other.m_index and m_store == other.m_store;
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+  private:
+    const ParticleStore *m_store;
+    Index m_index;
+  };
+
+  /// Default constructor for an empty store
+  ParticleStore() = default;
+
+  /// Reserve the columns for a number of particles
+  void reserve(std::size_t n);
+
+  /// Remove all particles, the capacity is kept for the next event
+  void clear();
+
+  /// The number of particles
+  std::size_t size() const { return m_pdg.size(); }
+
+  /// Whether the store is empty
+  bool empty() const { return m_pdg.empty(); }
+
+  /// The number of primaries, they occupy the range [0, primaries())
+  std::size_t primaries() const { return m_primaries; }
+
+  /// The number of secondaries, they follow the primaries
+  std::size_t secondaries() const { return size() - m_primaries; }
+
+  /// @brief Add a primary particle
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param particle is the particle to be added
+  ///
+  /// @throw std::logic_error if secondaries have been added already
+  /// @return the stable index of the particle
+  template <typename particle_t> Index addPrimary(const particle_t &particle) {
+    if (secondaries()) {
+      throw std::logic_error("Primaries can not follow secondaries");
+    }
+    ++m_primaries;
+    return append(particle);
+  }
+
+  /// @brief Append a secondary particle
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param particle is the particle to be added
+  ///
+  /// @return the stable index of the particle
+  template <typename particle_t>
+  Index addSecondary(const particle_t &particle) {
+    return append(particle);
+  }
+
+  /// @brief Append a set of secondary particles
+  ///
+  /// The columns grow geometrically, an exact reserve per call would
+  /// reallocate them for every set of secondaries.
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param particles are the particles to be added
+  ///
+  /// @return the stable index of the first particle
+  template <typename particle_t>
+  Index addSecondaries(const std::vector<particle_t> &particles) {
+    Index first = static_cast<Index>(size());
+    for (const auto &particle : particles) {
+      append(particle);
+    }
+    return first;
+  }
+
+  /// @brief Materialise a particle from the store
+  ///
+  /// The particle is constructed at the stored kinematics, the simulation
+  /// state (passed material, limits) is not part of the store.
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param index is the stable index of the particle
+  template <typename particle_t = Particle>
+  particle_t particle(Index index) const {
+    return particle_t(Acts::Vector3D(m_x[index], m_y[index], m_z[index]),
+                      Acts::Vector3D(m_px[index], m_py[index], m_pz[index]),
+                      m_m[index], m_q[index], m_pdg[index], m_barcode[index],
+                      m_time[index]);
+  }
+
+  /// Read-only view of the particle at an index
+  Proxy operator[](Index index) const { return Proxy(*this, index); }
+
+  /// Iterate all particles
+  Iterator begin() const { return Iterator(*this, 0); }
+  Iterator end() const { return Iterator(*this, static_cast<Index>(size())); }
+
+  /// Set the status of a particle
+  void setStatus(Index index, ParticleStatus status) {
+    m_status[index] = status;
+  }
+
+  /// The batch view of all particles
+  ParticleBatch batch() const;
+
+  /// The batch view of the particles [begin, end)
+  ParticleBatch batch(Index begin, Index end) const;
+
+private:
+  template <typename particle_t> Index append(const particle_t &particle) {
+    if (size() >= std::numeric_limits<Index>::max()) {
+      throw std::length_error("Particle store index space exhausted");
+    }
+    const Acts::Vector3D &position = particle.position();
+    const Acts::Vector3D &momentum = particle.momentum();
+    m_x.push_back(position.x());
+    m_y.push_back(position.y());
+    m_z.push_back(position.z());
+    m_px.push_back(momentum.x());
+    m_py.push_back(momentum.y());
+    m_pz.push_back(momentum.z());
+    m_time.push_back(particle.time());
+    m_m.push_back(particle.m());
+    m_q.push_back(particle.q());
+    m_pdg.push_back(particle.pdg());
+    m_barcode.push_back(particle.barcode());
+    m_status.push_back(particle ? ParticleStatus::Alive
+                                : ParticleStatus::Stopped);
+    return static_cast<Index>(size() - 1);
+  }
+
+  std::vector<double> m_x, m_y, m_z;
+  std::vector<double> m_px, m_py, m_pz;
+  std::vector<double> m_time;
+  std::vector<double> m_m;
+  std::vector<double> m_q;
+  std::vector<pdg_type> m_pdg;
+  std::vector<barcode_type> m_barcode;
+  std::vector<ParticleStatus> m_status;
+  std::size_t m_primaries = 0;
+};
+
+/// @brief Adaptor to run the Simulator on a particle store
+///
+/// The Simulator iterates the vertices of an event and their outgoing
+/// particles, attaching the secondaries to the vertex. This presents the
+/// store as a single vertex: the particles are materialised on access and
+/// the secondaries are appended to the store.
+///
+/// @tparam particle_t Type of the particle the simulation runs on
+template <typename particle_t = Particle> class ParticleStoreEvent {
+public:
+  /// The outgoing particles of the vertex
+  struct Outgoing {
+    ParticleStore *store = nullptr;
+
+    std::size_t size() const { return store->size(); }
+
+    particle_t operator[](std::size_t index) const {
+      return store->template particle<particle_t>(
+          static_cast<ParticleStore::Index>(index));
+    }
+  };
+
+  /// The vertex view of the store
+  struct Vertex {
+    Outgoing outgoing;
+
+    void outgoing_insert(const std::vector<particle_t> &particles) {
+      outgoing.store->addSecondaries(particles);
+    }
+  };
+
+  /// Constructor from the store to be simulated
+  explicit ParticleStoreEvent(ParticleStore &store) : m_vertex{{&store}} {}
+
+  Vertex *begin() { return &m_vertex; }
+  Vertex *end() { return &m_vertex + 1; }
+
+private:
+  Vertex m_vertex;
+};
+
+} // namespace Fatras
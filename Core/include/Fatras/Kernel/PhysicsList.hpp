@@ -14,6 +14,9 @@
 #include "Acts/Utilities/detail/MPL/type_collector.hpp"
 #include "Fatras/Kernel/detail/physics_list_implementation.hpp"
 #include "Fatras/Kernel/detail/process_signature_check.hpp"
+#include <cstddef>
+#include <tuple>
+#include <vector>
 
 namespace Fatras {
 
@@ -52,9 +55,47 @@ public:
                   "not all processes support the specified interface");
     // clang-format on
 
-    // create an emtpy particle vector
+    // the selectors shared by the processes are evaluated once
+    detail::physics_list_cache_t<processes...> cache;
     typedef detail::physics_list_impl<processes...> impl;
-    return impl::process(tuple(), gen, det, in, out);
+    return impl::process(tuple(), gen, det, in, out, cache);
+  }
+
+  /// Call operator with secondary production cuts
+  ///
+  /// @param[in] gen is the generator object
+  /// @param[in] det is the necessary detector information
+  /// @param[in] in is the ingoing particle (can be modified)
+  /// @param[in,out] out are the (eventually) outgoing particles
+  /// @param[in] cuts are the kinetic energy cuts of the secondaries per
+  ///            process in the order of the list, missing ones are off
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out,
+                  const std::vector<double> &cuts) const {
+    // clang-format off
+    static_assert(Acts::detail::all_of_v<detail::process_signature_check_v<processes, generator_t, detector_t, particle_t>...>,
+                  "not all processes support the specified interface");
+    // clang-format on
+
+    detail::physics_list_cache_t<processes...> cache;
+    std::size_t index = 0;
+    auto call = [&](const auto &process) {
+      const std::size_t first = out.size();
+      bool kills = detail::apply_process<species::Any>(process, gen, det, in,
+                                                       out, cache);
+      detail::apply_production_cut(out, first,
+                                   index < cuts.size() ? cuts[index] : 0.);
+      ++index;
+      return kills;
+    };
+    // stop at the first process that kills the particle
+    auto callAll = [&](const auto &... process) {
+      return (false or ... or call(process));
+    };
+    return std::apply(callAll, tuple());
   }
 };
 
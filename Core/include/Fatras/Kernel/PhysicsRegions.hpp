@@ -0,0 +1,164 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// The physics configuration of a detector region
+struct PhysicsRegion {
+  /// The physics list variant to be used
+  std::size_t variant = 0;
+  /// The kinetic energy cuts of the secondaries per process, in the order
+  /// of the processes in the variant; missing ones are off. Secondaries
+  /// below the cut are dropped without depositing their energy.
+  std::vector<double> cuts = {};
+};
+
+/// @brief The physics regions keyed by tracking volume identifier
+///
+/// Volumes without an explicit region use the default region. The
+/// Interactor keeps the region of the current volume in its result and
+/// looks it up again only when the particle enters another volume, the
+/// regions must thus not be changed during the simulation.
+class PhysicsRegions {
+public:
+  PhysicsRegions() = default;
+
+  /// Constructor with all volumes in the default region
+  ///
+  /// @param defaultRegion is the region of the unconfigured volumes
+  explicit PhysicsRegions(PhysicsRegion defaultRegion);
+
+  /// Set the region of a volume, replaces an existing one
+  ///
+  /// @param volume is the volume identifier
+  /// @param region is the physics configuration of the volume
+  void set(Acts::geo_id_value volume, PhysicsRegion region);
+
+  /// Find the region of a volume
+  ///
+  /// @param volume is the volume identifier
+  ///
+  /// @return the region of the volume or the default region
+  const PhysicsRegion &find(Acts::geo_id_value volume) const;
+
+  /// The region of the unconfigured volumes
+  const PhysicsRegion &defaultRegion() const { return m_default; }
+
+  /// The number of configured volumes
+  std::size_t size() const { return m_regions.size(); }
+
+private:
+  PhysicsRegion m_default;
+  /// The configured regions, sorted by volume identifier
+  std::vector<std::pair<Acts::geo_id_value, PhysicsRegion>> m_regions;
+};
+
+/// @brief A physics list with a variant per region
+///
+/// The variant and the production cuts are taken from the region of the
+/// current volume. The variants have to accept production cuts, as the
+/// PhysicsList and the DynamicPhysicsList do; an empty PhysicsList<>
+/// switches the physics off in a region. Without a region the first
+/// variant is called without cuts.
+///
+/// @tparam lists are the physics list variants
+template <typename... lists> class RegionPhysicsList {
+  static_assert(sizeof...(lists) > 0, "no physics list variants given");
+
+public:
+  /// The number of variants
+  static constexpr std::size_t nVariants = sizeof...(lists);
+
+  /// Access a variant for its configuration
+  template <std::size_t index> auto &get() { return std::get<index>(m_lists); }
+
+  template <std::size_t index> const auto &get() const {
+    return std::get<index>(m_lists);
+  }
+
+  /// Call operator with the first variant
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out) const {
+    return std::get<0>(m_lists)(gen, det, in, out);
+  }
+
+  /// Call operator with the variant and the cuts of a region
+  ///
+  /// @param[in] gen is the generator object
+  /// @param[in] det is the necessary detector information
+  /// @param[in] in is the ingoing particle (can be modified)
+  /// @param[in,out] out are the (eventually) outgoing particles
+  /// @param[in] region is the region of the current volume
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out,
+                  const PhysicsRegion &region) const {
+    if (region.variant >= nVariants) {
+      throw std::out_of_range("unknown physics list variant");
+    }
+    return dispatch(std::index_sequence_for<lists...>(), gen, det, in, out,
+                    region);
+  }
+
+private:
+  template <std::size_t... is, typename generator_t, typename detector_t,
+            typename particle_t>
+  bool dispatch(std::index_sequence<is...>, generator_t &gen,
+                const detector_t &det, particle_t &in,
+                std::vector<particle_t> &out,
+                const PhysicsRegion &region) const {
+    bool kills = false;
+    ((region.variant == is and
+      (kills = std::get<is>(m_lists)(gen, det, in, out, region.cuts), true)) or
+     ...);
+    return kills;
+  }
+
+  std::tuple<lists...> m_lists;
+};
+
+namespace detail {
+
+/// Check whether a physics list takes an additional argument, i.e. a
+/// region or the production cuts
+template <typename list_t, typename generator_t, typename detector_t,
+          typename particle_t, typename argument_t, typename = void>
+struct physics_takes : std::false_type {};
+
+template <typename list_t, typename generator_t, typename detector_t,
+          typename particle_t, typename argument_t>
+struct physics_takes<
+    list_t, generator_t, detector_t, particle_t, argument_t,
+    std::void_t<decltype(std::declval<const list_t &>()(
+        std::declval<generator_t &>(), std::declval<const detector_t &>(),
+        std::declval<particle_t &>(),
+        std::declval<std::vector<particle_t> &>(),
+        std::declval<const argument_t &>()))>> : std::true_type {};
+
+template <typename list_t, typename generator_t, typename detector_t,
+          typename particle_t, typename argument_t>
+constexpr bool physics_takes_v =
+    physics_takes<list_t, generator_t, detector_t, particle_t,
+                  argument_t>::value;
+
+} // namespace detail
+
+} // namespace Fatras
@@ -0,0 +1,191 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Barcode.hpp"
+#include "Fatras/Kernel/HitStore.hpp"
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Configuration of the pile-up overlay
+struct PileUpConfig {
+  /// The mean number of overlaid vertices per event
+  double mu = 200.;
+  /// Overlay exactly round(mu) vertices instead of a Poisson number
+  bool fixedNumber = false;
+  /// The longitudinal spread of the luminous region
+  double sigmaZ = 50. * Acts::units::_mm;
+  /// The time spread, by default the one of a bunch of the length sigmaZ
+  double sigmaT = 50. * Acts::units::_mm / Acts::units::_c;
+  /// The barcode vertex number of the first overlaid vertex
+  barcode_type firstVertex = 1;
+};
+
+/// @brief Library of simulated minimum-bias vertices
+///
+/// Minimum-bias vertices are statistically interchangeable: they are
+/// simulated once, their hits and truth particles stored in flat arrays,
+/// and randomly chosen entries are overlaid onto every hard-scatter
+/// event, shifted in z and time. Only the hard scatter is simulated for
+/// each event.
+///
+/// The overlaid particles get the barcode vertex number of their overlay,
+/// such that barcodes stay unique within the event.
+///
+/// @tparam particle_t Type of the particle
+/// @tparam hit_t Type of the simulated hit
+template <typename particle_t, typename hit_t> class PileUpLibrary {
+public:
+  /// The overlay of one library entry
+  struct Overlay {
+    std::size_t entry = 0;
+    double dz = 0.;
+    double dt = 0.;
+    barcode_type vertex = 0;
+  };
+
+  /// @brief Simulate a minimum-bias vertex and add it as a library entry
+  ///
+  /// @tparam simulator_t Type of the simulator, e.g. the Simulator
+  /// @tparam context_t Type of the context object
+  /// @tparam generator_t Type of the generator object
+  /// @tparam vertex_t Type of the vertex of the event collection
+  ///
+  /// @param simulator is called as simulator(context, generator, event,
+  ///        hits) with a single vertex event
+  /// @param fatrasContext is the event-bound context
+  /// @param fatrasGenerator is the random generator
+  /// @param vertex is the minimum-bias vertex with its primaries
+  template <typename simulator_t, typename context_t, typename generator_t,
+            typename vertex_t>
+  void add(const simulator_t &simulator, context_t &fatrasContext,
+           generator_t &fatrasGenerator, const vertex_t &vertex) {
+    Collector collector{&m_hits};
+    std::vector<vertex_t> event(1, vertex);
+    simulator(fatrasContext, fatrasGenerator, event, collector);
+    const auto &outgoing = event.front().outgoing;
+    for (std::size_t i = 0; i < outgoing.size(); ++i) {
+      m_particles.push_back(outgoing[i]);
+    }
+    m_hitOffsets.push_back(m_hits.size());
+    m_particleOffsets.push_back(m_particles.size());
+  }
+
+  /// The number of library entries
+  std::size_t size() const { return m_hitOffsets.size() - 1; }
+
+  /// The number of hits of an entry
+  std::size_t nHits(std::size_t entry) const {
+    return m_hitOffsets[entry + 1] - m_hitOffsets[entry];
+  }
+
+  /// The number of particles of an entry
+  std::size_t nParticles(std::size_t entry) const {
+    return m_particleOffsets[entry + 1] - m_particleOffsets[entry];
+  }
+
+  /// @brief Overlay library entries onto an event
+  ///
+  /// @tparam generator_t Type of the generator object
+  /// @tparam hit_collection_t Type of the hit collection, needs insert();
+  ///         a HitStore is built at the end
+  /// @tparam hit_shifter_t Type of the functor returning a hit shifted by
+  ///         (dz, dt), called as shift(hit, dz, dt)
+  ///
+  /// @param fatrasGenerator is the event-bound random generator
+  /// @param cfg is the overlay configuration
+  /// @param fatrasHits is the hit collection of the event
+  /// @param particles receives the shifted truth particles
+  /// @param shift is the hit shifter
+  ///
+  /// @return the overlaid entries with their shifts
+  /// @throw std::logic_error if vertices are requested from an empty
+  ///        library
+  template <typename generator_t, typename hit_collection_t,
+            typename hit_shifter_t>
+  std::vector<Overlay>
+  overlay(generator_t &fatrasGenerator, const PileUpConfig &cfg,
+          hit_collection_t &fatrasHits, std::vector<particle_t> &particles,
+          const hit_shifter_t &shift) const {
+    std::size_t nVertices = 0;
+    if (cfg.fixedNumber) {
+      nVertices = static_cast<std::size_t>(cfg.mu + 0.5);
+    } else if (cfg.mu > 0.) {
+      std::poisson_distribution<std::size_t> poisson(cfg.mu);
+      nVertices = poisson(fatrasGenerator);
+    }
+    if (nVertices and not size()) {
+      throw std::logic_error("Pile-up overlay from an empty library");
+    }
+    std::uniform_int_distribution<std::size_t> pick(0, size() - 1);
+    std::normal_distribution<double> gaussZ(0., cfg.sigmaZ);
+    std::normal_distribution<double> gaussT(0., cfg.sigmaT);
+
+    std::vector<Overlay> overlays;
+    overlays.reserve(nVertices);
+    for (std::size_t i = 0; i < nVertices; ++i) {
+      Overlay ovl;
+      ovl.entry = pick(fatrasGenerator);
+      ovl.dz = cfg.sigmaZ > 0. ? gaussZ(fatrasGenerator) : 0.;
+      ovl.dt = cfg.sigmaT > 0. ? gaussT(fatrasGenerator) : 0.;
+      ovl.vertex = cfg.firstVertex + i;
+      for (std::size_t h = m_hitOffsets[ovl.entry];
+           h < m_hitOffsets[ovl.entry + 1]; ++h) {
+        fatrasHits.insert(shift(m_hits[h], ovl.dz, ovl.dt));
+      }
+      const Acts::Vector3D offset(0., 0., ovl.dz);
+      for (std::size_t p = m_particleOffsets[ovl.entry];
+           p < m_particleOffsets[ovl.entry + 1]; ++p) {
+        const particle_t &source = m_particles[p];
+        Barcode barcode(source.barcode());
+        particles.emplace_back(
+            source.position() + offset, source.momentum(), source.m(),
+            source.q(), source.pdg(),
+            Barcode(ovl.vertex, barcode.primary(), barcode.generation(),
+                    barcode.subParticle())
+                .value(),
+            source.time() + ovl.dt);
+      }
+      overlays.push_back(ovl);
+    }
+    if constexpr (is_hit_store_v<hit_collection_t>) {
+      fatrasHits.build();
+    }
+    return overlays;
+  }
+
+  /// Remove all entries
+  void clear() {
+    m_hits.clear();
+    m_particles.clear();
+    m_hitOffsets.assign(1, 0);
+    m_particleOffsets.assign(1, 0);
+  }
+
+private:
+  /// The hit collection handed to the simulator
+  struct Collector {
+    std::vector<hit_t> *hits;
+
+    void insert(const hit_t &hit) { hits->push_back(hit); }
+  };
+
+  std::vector<hit_t> m_hits;
+  std::vector<particle_t> m_particles;
+  std::vector<std::size_t> m_hitOffsets = {0};
+  std::vector<std::size_t> m_particleOffsets = {0};
+};
+
+} // namespace Fatras
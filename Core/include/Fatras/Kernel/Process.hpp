@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Acts/Utilities/Definitions.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/Species.hpp"
 
 #include <cmath>
 
@@ -33,6 +35,10 @@ template <typename physics_t, typename selector_in_t, typename selector_out_t,
 
 struct Process {
 
+  using SelectorIn = selector_in_t;
+  using SelectorOut = selector_out_t;
+  using SelectorChild = selector_child_t;
+
   /// The actual physics that is happening
   physics_t process;
 
@@ -45,20 +51,62 @@ struct Process {
   template <typename generator_t, typename detector_t, typename particle_t>
   bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
                   std::vector<particle_t> &out) const {
+    return apply<species::Any>(gen, det, in, out);
+  }
+
+  /// Call for a particle of a known species
+  ///
+  /// Selectors that are decided by the species alone are not evaluated,
+  /// the process is dropped entirely if it never applies to the species.
+  ///
+  /// @tparam species_t is the compile-time species of the particle
+  template <typename species_t, typename generator_t, typename detector_t,
+            typename particle_t>
+  bool apply(generator_t &gen, const detector_t &det, particle_t &in,
+             std::vector<particle_t> &out) const {
+    SelectorCache<> cache;
+    return apply<species_t>(gen, det, in, out, cache);
+  }
+
+  /// Call for a particle of a known species with a selector cache
+  ///
+  /// The cache is shared with the other processes of a physics list, its
+  /// kinematics are invalidated once this process modified the particle.
+  ///
+  /// @tparam species_t is the compile-time species of the particle
+  template <typename species_t, typename generator_t, typename detector_t,
+            typename particle_t, typename... memo_ts>
+  bool apply(generator_t &gen, const detector_t &det, particle_t &in,
+             std::vector<particle_t> &out,
+             SelectorCache<memo_ts...> &cache) const {
+    constexpr Acceptance acceptIn =
+        species_acceptance_v<selector_in_t, species_t>;
+    constexpr Acceptance acceptOut =
+        species_acceptance_v<selector_out_t, species_t>;
     // check if the process applies
-    if (selectorIn(det, in)) {
-      // apply energy loss and get eventual children
-      auto children = process(gen, det, in);
-      if (children.size()) {
-        // copy the children that comply with the child selector
-        std::copy_if(
-            children.begin(), children.end(), std::back_inserter(out),
-            [this, det](const particle_t &p) { return selectorChild(det, p); });
+    if constexpr (acceptIn != Acceptance::Never) {
+      if (acceptIn == Acceptance::Always or
+          cache.select(selectorIn, det, in)) {
+        // apply energy loss and get eventual children
+        auto children = process(gen, det, in);
+        cache.invalidate();
+        if (children.size()) {
+          // copy the children that comply with the child selector
+          std::copy_if(children.begin(), children.end(),
+                       std::back_inserter(out),
+                       [this, det](const particle_t &p) {
+                         return selectorChild(det, p);
+                       });
+        }
       }
     }
     // check if this killed the particle,
     // or pushed below threshold
-    return (!selectorOut(det, in));
+    if constexpr (acceptOut == Acceptance::Runtime) {
+      return (!cache.select(selectorOut, det, in));
+    } else {
+      return (acceptOut == Acceptance::Never);
+    }
   }
 };
 
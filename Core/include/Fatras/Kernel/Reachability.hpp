@@ -0,0 +1,160 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Physics/EnergyLoss/RangeOut.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Analytic pre-check whether a particle can reach a sensitive layer
+///
+/// The Simulator asks it before starting a propagation; a particle that
+/// cannot reach a sensitive layer is not propagated, and only handed to
+/// the hit collection as finished if recording is on. The checks are
+///
+/// - Curling: the maximal radius of the helix in the solenoid field,
+///   |centre| + R, is below the next layer radius outside the origin. The
+///   layer radii should include the inner radii of the disks.
+/// - Acceptance: the particle is outside the |eta| envelope, or outside
+///   the outermost layer radius.
+/// - Range: the residual range of a charged particle is shorter than the
+///   material in front of the first layer, e.g. the beam pipe. Only
+///   particles that start inside the material radius and the first layer
+///   radius have to cross it.
+///
+/// Every check is off with its default configuration. The counters of
+/// the skipped particles per reason are thread-safe.
+class Reachability {
+public:
+  /// The reasons for a particle to be skipped
+  enum class Reason { Reachable = 0, Curling = 1, Acceptance = 2, Range = 3 };
+
+  struct Config {
+    /// The solenoid field along z
+    double bField = 2. * Acts::units::_T;
+    /// The radii of the sensitive layers
+    std::vector<double> layerRadii = {};
+    /// The |eta| envelope of the sensitive layers
+    double maxAbsEta = std::numeric_limits<double>::infinity();
+    /// The material in front of the first layer
+    Acts::MaterialProperties material = {};
+    /// The outer radius of the material in front of the first layer
+    double materialRadius = std::numeric_limits<double>::infinity();
+    /// Hand the skipped particles to the hit collection as finished
+    bool record = true;
+  };
+
+  struct Counters {
+    std::uint64_t checked = 0;
+    /// The skipped particles per reason, indexed by Reason
+    std::array<std::uint64_t, 4> skipped = {{0, 0, 0, 0}};
+  };
+
+  Reachability() = default;
+  explicit Reachability(Config cfg) : m_cfg(std::move(cfg)) {
+    std::sort(m_cfg.layerRadii.begin(), m_cfg.layerRadii.end());
+  }
+
+  /// @brief The reason a particle can not reach a sensitive layer
+  ///
+  /// @tparam particle_t is the particle information type
+  /// @param particle is the particle before propagation
+  template <typename particle_t> Reason check(const particle_t &particle) {
+    if (std::abs(Acts::VectorHelpers::eta(particle.momentum())) >
+        m_cfg.maxAbsEta) {
+      return Reason::Acceptance;
+    }
+    const Acts::Vector3D &position = particle.position();
+    const double r = std::hypot(position.x(), position.y());
+    if (not m_cfg.layerRadii.empty()) {
+      auto next = std::upper_bound(m_cfg.layerRadii.begin(),
+                                   m_cfg.layerRadii.end(), r);
+      if (next == m_cfg.layerRadii.end()) {
+        return Reason::Acceptance;
+      }
+      if (maxRadius(particle) < *next) {
+        return Reason::Curling;
+      }
+    }
+    const bool inFront =
+        r < m_cfg.materialRadius and
+        (m_cfg.layerRadii.empty() or r < m_cfg.layerRadii.front());
+    if (m_cfg.material and particle.q() != 0. and inFront) {
+      const double kineticEnergy = particle.E() - particle.m();
+      const double range =
+          m_ranges
+              .table(m_cfg.material.material(), particle.pdg(), particle.m(),
+                     particle.q())
+              .range(kineticEnergy);
+      if (range < m_cfg.material.thickness()) {
+        return Reason::Range;
+      }
+    }
+    return Reason::Reachable;
+  }
+
+  /// @brief Check and count a particle
+  ///
+  /// @return whether the particle is to be propagated
+  template <typename particle_t> bool operator()(const particle_t &particle) {
+    Reason reason = check(particle);
+    ++m_checked;
+    if (reason == Reason::Reachable) {
+      return true;
+    }
+    ++m_skipped[static_cast<std::size_t>(reason)];
+    return false;
+  }
+
+  /// The maximal transverse radius along the trajectory
+  template <typename particle_t>
+  double maxRadius(const particle_t &particle) const {
+    if (particle.q() == 0. or m_cfg.bField == 0. or
+        not(particle.pT() > 0.)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    const double R = particle.pT() / std::abs(particle.q() * m_cfg.bField);
+    const double s = particle.q() * m_cfg.bField > 0. ? 1. : -1.;
+    const Acts::Vector3D &p = particle.momentum();
+    const double cx = particle.position().x() + s * R / particle.pT() * p.y();
+    const double cy = particle.position().y() - s * R / particle.pT() * p.x();
+    return std::hypot(cx, cy) + R;
+  }
+
+  /// A snapshot of the counters
+  Counters counters() const {
+    Counters result;
+    result.checked = m_checked;
+    for (std::size_t i = 0; i < result.skipped.size(); ++i) {
+      result.skipped[i] = m_skipped[i];
+    }
+    return result;
+  }
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  Config m_cfg;
+  RangeOut m_ranges;
+  std::atomic<std::uint64_t> m_checked{0};
+  std::array<std::atomic<std::uint64_t>, 4> m_skipped = {};
+};
+
+} // namespace Fatras
@@ -0,0 +1,146 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Helpers.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Fatras {
+
+namespace detail {
+
+/// Check if a selector can use the cache
+template <typename T, typename detector_t, typename particle_t,
+          typename cache_t, typename = void>
+struct selector_cache_check : std::false_type {};
+
+template <typename T, typename detector_t, typename particle_t,
+          typename cache_t>
+struct selector_cache_check<
+    T, detector_t, particle_t, cache_t,
+    std::void_t<decltype(std::declval<const T &>()(
+        std::declval<const detector_t &>(), std::declval<const particle_t &>(),
+        std::declval<cache_t &>()))>> : std::true_type {};
+
+/// The position of a type in a list of types
+template <typename T, typename... types> constexpr std::size_t type_index() {
+  constexpr bool matches[] = {std::is_same_v<T, types>..., false};
+  std::size_t index = 0;
+  while (index < sizeof...(types) and not matches[index]) {
+    ++index;
+  }
+  return index;
+}
+
+} // namespace detail
+
+/// @brief Cache for the evaluation of the selectors on one particle
+///
+/// The kinematic quantities used by the casts are computed on first access
+/// and then shared by all selectors that are evaluated with the same cache.
+/// The results of the memoised selector types are kept as well, these must
+/// only depend on the particle identity (pdg, charge) which the physics
+/// processes do not change. The kinematic quantities have to be invalidated
+/// whenever the particle is modified.
+///
+/// @tparam memo_ts are the selector types whose results are memoised
+template <typename... memo_ts> class SelectorCache {
+public:
+  SelectorCache() { m_memo.fill(-1); }
+
+  /// Pseudorapidity of the particle momentum
+  template <typename particle_t> double eta(const particle_t &particle) {
+    if (not(m_valid & EtaBit)) {
+      m_eta = Acts::VectorHelpers::eta(particle.momentum());
+      m_valid |= EtaBit;
+    }
+    return m_eta;
+  }
+
+  /// Transverse momentum of the particle
+  template <typename particle_t> double pT(const particle_t &particle) {
+    if (not(m_valid & PtBit)) {
+      m_pT = Acts::VectorHelpers::perp(particle.momentum());
+      m_valid |= PtBit;
+    }
+    return m_pT;
+  }
+
+  /// Momentum of the particle
+  template <typename particle_t> double p(const particle_t &particle) {
+    if (not(m_valid & PBit)) {
+      m_p = particle.momentum().norm();
+      m_valid |= PBit;
+    }
+    return m_p;
+  }
+
+  /// Transverse distance of the particle position
+  template <typename particle_t> double vR(const particle_t &particle) {
+    if (not(m_valid & VrBit)) {
+      m_vR = Acts::VectorHelpers::perp(particle.position());
+      m_valid |= VrBit;
+    }
+    return m_vR;
+  }
+
+  /// Forget the kinematic quantities after the particle was modified
+  void invalidate() { m_valid = 0; }
+
+  /// Evaluate a selector
+  ///
+  /// Memoised selectors are evaluated once, selectors that accept the
+  /// cache are handed it, all others are called directly.
+  ///
+  /// @param[in] selector is the selector to be evaluated
+  /// @param[in] detector the current detector/material information
+  /// @param[in] particle the particle to be checked
+  template <typename selector_t, typename detector_t, typename particle_t>
+  bool select(const selector_t &selector, const detector_t &detector,
+              const particle_t &particle) {
+    constexpr std::size_t index = detail::type_index<selector_t, memo_ts...>();
+    if constexpr (index < sizeof...(memo_ts)) {
+      signed char &result = m_memo[index];
+      if (result < 0) {
+        result = evaluate(selector, detector, particle);
+      }
+      return result;
+    } else {
+      return evaluate(selector, detector, particle);
+    }
+  }
+
+private:
+  template <typename selector_t, typename detector_t, typename particle_t>
+  bool evaluate(const selector_t &selector, const detector_t &detector,
+                const particle_t &particle) {
+    if constexpr (detail::selector_cache_check<selector_t, detector_t,
+                                               particle_t,
+                                               SelectorCache>::value) {
+      return selector(detector, particle, *this);
+    } else {
+      return selector(detector, particle);
+    }
+  }
+
+  enum : unsigned int { EtaBit = 1, PtBit = 2, PBit = 4, VrBit = 8 };
+
+  unsigned int m_valid = 0;
+  double m_eta = 0.;
+  double m_pT = 0.;
+  double m_p = 0.;
+  double m_vR = 0.;
+
+  std::array<signed char, sizeof...(memo_ts)> m_memo;
+};
+
+} // namespace Fatras
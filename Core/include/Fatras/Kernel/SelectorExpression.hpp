@@ -0,0 +1,252 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/detail/Extendable.hpp"
+#include "Acts/Utilities/detail/MPL/all_of.hpp"
+#include "Acts/Utilities/detail/MPL/has_duplicates.hpp"
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/detail/selector_expression_implementation.hpp"
+#include "Fatras/Kernel/detail/selector_signature_check.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief A conjunction or disjunction of selectors
+///
+/// The combination is resolved at compile time into a single short-circuit
+/// expression. Terms can be selectors, selector lists or expressions.
+/// Optionally the terms are evaluated in the order of their cost, such that
+/// cheap terms can reject (or accept) a particle before the expensive ones
+/// are evaluated; the cost of a selector is taken from its `cost` member.
+///
+/// @tparam conjunction steers && (true) or || (false) combination
+/// @tparam by_cost steers if the terms are evaluated cheapest first
+/// @tparam terms are the selectors to be combined
+template <bool conjunction, bool by_cost, typename... terms>
+struct SelectorExpression : private Acts::detail::Extendable<terms...> {
+private:
+  static_assert(not Acts::detail::has_duplicates_v<terms...>,
+                "same selector type specified several times");
+
+  using Acts::detail::Extendable<terms...>::tuple;
+
+  static constexpr auto order = detail::evaluation_order<by_cost, terms...>();
+
+public:
+  using Acts::detail::Extendable<terms...>::get;
+
+  /// The cost of the expression if all terms are evaluated
+  static constexpr unsigned int cost =
+      (detail::selector_cost_v<terms> + ... + 0);
+
+  /// The scratch mask rows needed for the batch evaluation
+  static constexpr std::size_t scratchRows =
+      1 + std::max({std::size_t(0), detail::selector_scratch_rows_v<terms>...});
+
+  /// Call operator for a single particle
+  ///
+  /// @tparam detector_t is the detector type used in simulation
+  /// @tparam particle_t is the particle type used in simulation
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] particle to be checked for further processing
+  ///
+  /// @return indicator if the particle is accepted
+  template <typename detector_t, typename particle_t>
+  bool operator()(const detector_t &detector,
+                  const particle_t &particle) const {
+    SelectorCache<> cache;
+    return (*this)(detector, particle, cache);
+  }
+
+  /// Call operator that evaluates the terms with a given cache
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] particle to be checked for further processing
+  /// @param[in,out] cache are the cached kinematics and selector results
+  ///
+  /// @return indicator if the particle is accepted
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &detector, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
+    // clang-format off
+    static_assert(Acts::detail::all_of_v<detail::selector_list_signature_check_v<terms, detector_t, particle_t>...>,
+                  "not all particle selectors support the specified interface");
+    // clang-format on
+    return evaluate(std::index_sequence_for<terms...>(), detector, particle,
+                    cache);
+  }
+
+  /// Call operator for a batch of particles
+  ///
+  /// @tparam detector_t is the detector type used in simulation
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] batch the particles to be checked
+  /// @param[out] mask is set to 1 for accepted particles, 0 otherwise
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    std::vector<std::uint8_t> scratch(scratchRows * batch.size);
+    (*this)(detector, batch, mask, scratch.data());
+  }
+
+  /// Call operator for a batch of particles with a given scratch buffer
+  ///
+  /// The terms are evaluated in the same order as for a single particle,
+  /// the evaluation stops when all particles are decided.
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] batch the particles to be checked
+  /// @param[out] mask is set to 1 for accepted particles, 0 otherwise
+  /// @param[in,out] scratch has room for scratchRows rows of the batch size
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask, std::uint8_t *scratch) const {
+    static_assert(
+        Acts::detail::all_of_v<
+            detail::selector_batch_check_v<terms, detector_t>...>,
+        "not all particle selectors support batch evaluation");
+    evaluate(std::index_sequence_for<terms...>(), detector, batch, mask,
+             scratch);
+  }
+
+private:
+  template <std::size_t... is, typename detector_t, typename particle_t,
+            typename cache_t>
+  bool evaluate(std::index_sequence<is...>, const detector_t &detector,
+                const particle_t &particle, cache_t &cache) const {
+    if constexpr (conjunction) {
+      return (cache.select(std::get<order[is]>(tuple()), detector, particle) and
+              ...);
+    } else {
+      return (cache.select(std::get<order[is]>(tuple()), detector, particle) or
+              ...);
+    }
+  }
+
+  template <std::size_t... is, typename detector_t>
+  void evaluate(std::index_sequence<is...>, const detector_t &detector,
+                const ParticleBatch &batch, std::uint8_t *mask,
+                std::uint8_t *scratch) const {
+    detail::combine_batch<conjunction>(detector, batch, mask, scratch,
+                                       std::get<order[is]>(tuple())...);
+  }
+};
+
+/// All terms have to accept the particle, true if empty
+template <typename... terms>
+using And = SelectorExpression<true, false, terms...>;
+
+/// Any of the terms has to accept the particle, false if empty
+template <typename... terms>
+using Or = SelectorExpression<false, false, terms...>;
+
+/// Conjunction that evaluates the cheapest terms first
+template <typename... terms>
+using CostOrderedAnd = SelectorExpression<true, true, terms...>;
+
+/// Disjunction that evaluates the cheapest terms first
+template <typename... terms>
+using CostOrderedOr = SelectorExpression<false, true, terms...>;
+
+/// @brief The negation of a selector
+///
+/// @tparam term_t is the selector to be negated
+template <typename term_t> struct Not {
+
+  /// The negated selector
+  term_t term;
+
+  static constexpr unsigned int cost = detail::selector_cost_v<term_t>;
+
+  static constexpr std::size_t scratchRows =
+      detail::selector_scratch_rows_v<term_t>;
+
+  /// Call operator for a single particle
+  template <typename detector_t, typename particle_t>
+  bool operator()(const detector_t &detector,
+                  const particle_t &particle) const {
+    return not term(detector, particle);
+  }
+
+  /// The same with a given cache
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &detector, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
+    return not cache.select(term, detector, particle);
+  }
+
+  /// Call operator for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    std::vector<std::uint8_t> scratch(scratchRows * batch.size);
+    (*this)(detector, batch, mask, scratch.data());
+  }
+
+  /// The same with a given scratch buffer
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask, std::uint8_t *scratch) const {
+    detail::select_batch(term, detector, batch, mask, scratch);
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = not mask[i];
+    }
+  }
+};
+
+/// @brief Select a batch of particles
+///
+/// This is the entry point for preselecting large particle samples, e.g.
+/// the generator particles of an event, before the simulation.
+///
+/// @tparam selector_t is the selector, list or expression to be applied
+/// @tparam detector_t is the detector type used in simulation
+///
+/// @param[in] selector the selection to be applied
+/// @param[in] detector the current detector/material information
+/// @param[in] batch the particles to be checked
+/// @param[out] mask is resized to the batch, 1 for accepted particles
+///
+/// @return the number of accepted particles
+template <typename selector_t, typename detector_t>
+std::size_t selectBatch(const selector_t &selector, const detector_t &detector,
+                        const ParticleBatch &batch,
+                        std::vector<std::uint8_t> &mask) {
+  std::vector<std::uint8_t> scratch;
+  return selectBatch(selector, detector, batch, mask, scratch);
+}
+
+/// @brief Select a batch of particles with a reusable scratch buffer
+///
+/// @param[in,out] scratch is the buffer for the intermediate masks, it is
+///        grown as needed and can be reused for the following batches
+template <typename selector_t, typename detector_t>
+std::size_t selectBatch(const selector_t &selector, const detector_t &detector,
+                        const ParticleBatch &batch,
+                        std::vector<std::uint8_t> &mask,
+                        std::vector<std::uint8_t> &scratch) {
+  static_assert(detail::selector_batch_check_v<selector_t, detector_t>,
+                "selector does not support batch evaluation");
+  mask.resize(batch.size);
+  constexpr std::size_t rows = detail::selector_scratch_rows_v<selector_t>;
+  if (scratch.size() < rows * batch.size) {
+    scratch.resize(rows * batch.size);
+  }
+  detail::select_batch(selector, detector, batch, mask.data(), scratch.data());
+  return std::count(mask.begin(), mask.end(), std::uint8_t(1));
+}
+
+} // namespace Fatras
@@ -12,8 +12,14 @@
 #include "Acts/Utilities/detail/MPL/all_of.hpp"
 #include "Acts/Utilities/detail/MPL/has_duplicates.hpp"
 #include "Acts/Utilities/detail/MPL/type_collector.hpp"
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/detail/selector_expression_implementation.hpp"
 #include "Fatras/Kernel/detail/selector_list_implementation.hpp"
 #include "Fatras/Kernel/detail/selector_signature_check.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace Fatras {
 
@@ -33,6 +39,11 @@ private:
 public:
   using Acts::detail::Extendable<selectors...>::get;
 
+  /// The scratch mask rows needed for the batch evaluation
+  static constexpr std::size_t scratchRows =
+      1 + std::max({std::size_t(0),
+                    detail::selector_scratch_rows_v<selectors>...});
+
   /// Call operator that is that broadcasts the call to the tuple()
   ///
   /// @tparam detector_t is the detector type used in simulation
@@ -46,14 +57,68 @@ public:
   template <typename detector_t, typename particle_t>
   bool operator()(const detector_t &detector,
                   const particle_t &particle) const {
+    // the kinematics are shared by all selectors of this evaluation
+    SelectorCache<> cache;
+    return (*this)(detector, particle, cache);
+  }
+
+  /// Call operator that evaluates the selectors with a given cache
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] particle to be checked for further processing
+  /// @param[in,out] cache are the cached kinematics and selector results
+  ///
+  /// @return indicator if the particle is accepted
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &detector, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
     // clang-format off
     static_assert(Acts::detail::all_of_v<detail::selector_list_signature_check_v<selectors, detector_t, particle_t>...>,
                   "not all particle selectors support the specified interface");
     // clang-format on
 
-    // create an emtpy particle vector
-    typedef detail::selector_list_impl<selectors...> impl;
-    return impl::select(tuple(), detector, particle, inclusive);
+    typedef detail::selector_list_impl<inclusive, selectors...> impl;
+    return impl::select(tuple(), detector, particle, cache);
+  }
+
+  /// Call operator for a batch of particles
+  ///
+  /// @tparam detector_t is the detector type used in simulation
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] batch the particles to be checked
+  /// @param[out] mask is set to 1 for accepted particles, 0 otherwise
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    std::vector<std::uint8_t> scratch(scratchRows * batch.size);
+    (*this)(detector, batch, mask, scratch.data());
+  }
+
+  /// Call operator for a batch of particles with a given scratch buffer
+  ///
+  /// @param[in] detector the current detector/material information
+  /// @param[in] batch the particles to be checked
+  /// @param[out] mask is set to 1 for accepted particles, 0 otherwise
+  /// @param[in,out] scratch has room for scratchRows rows of the batch size
+  template <typename detector_t>
+  void operator()(const detector_t &detector, const ParticleBatch &batch,
+                  std::uint8_t *mask, std::uint8_t *scratch) const {
+    static_assert(
+        Acts::detail::all_of_v<
+            detail::selector_batch_check_v<selectors, detector_t>...>,
+        "not all particle selectors support batch evaluation");
+    if constexpr (sizeof...(selectors) == 0) {
+      // empty lists accept all particles
+      detail::combine_batch<true>(detector, batch, mask, scratch);
+    } else {
+      std::apply(
+          [&](const auto &... selector) {
+            detail::combine_batch<not inclusive>(detector, batch, mask,
+                                                 scratch, selector...);
+          },
+          tuple());
+    }
   }
 };
 
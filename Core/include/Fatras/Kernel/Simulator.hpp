@@ -16,10 +16,52 @@
 #include "Acts/Propagator/detail/DebugOutputActor.hpp"
 #include "Acts/Propagator/detail/StandardAborters.hpp"
 #include "Acts/Utilities/Logger.hpp"
+#include "Fatras/Kernel/Barcode.hpp"
+#include "Fatras/Kernel/HitStore.hpp"
+#include "Fatras/Kernel/Interactor.hpp"
+#include "Fatras/Kernel/KillVolumes.hpp"
+#include "Fatras/Kernel/LocalityOrder.hpp"
+#include "Fatras/Kernel/PhysicsRegions.hpp"
+#include "Fatras/Kernel/Reachability.hpp"
+#include "Fatras/Kernel/SpeciesPhysicsList.hpp"
+#include "Fatras/Kernel/TruthGraph.hpp"
+#include <algorithm>
+#include <numeric>
 #include <optional>
+#include <type_traits>
+#include <unordered_map>
 
 namespace Fatras {
 
+namespace detail {
+
+/// Check whether a hit collection also takes the simulated particles
+template <typename T, typename particle_t, typename = void>
+struct takes_particles : std::false_type {};
+
+template <typename T, typename particle_t>
+struct takes_particles<T, particle_t,
+                       std::void_t<decltype(std::declval<T &>().finished(
+                           std::declval<const particle_t &>()))>>
+    : std::true_type {};
+
+template <typename T, typename particle_t>
+constexpr bool takes_particles_v = takes_particles<T, particle_t>::value;
+
+/// Check whether a hit collection also takes the boundary records
+template <typename T, typename = void>
+struct takes_boundaries : std::false_type {};
+
+template <typename T>
+struct takes_boundaries<T, std::void_t<decltype(std::declval<T &>().crossed(
+                               std::declval<const BoundaryRecord &>()))>>
+    : std::true_type {};
+
+template <typename T>
+constexpr bool takes_boundaries_v = takes_boundaries<T>::value;
+
+} // namespace detail
+
 struct VoidDetector {};
 
 /// @brief Fatras simulator
@@ -46,15 +88,38 @@ struct Simulator {
         mlogger(Acts::getDefaultLogger("Simulator", Acts::Logging::INFO)) {}
 
   using PhysicsList_t = typename charged_interactor_t::PhysicsList_t;
+  using Decay_t = typename charged_interactor_t::Decay_t;
   charged_propagator_t chargedPropagator;
   charged_selector_t chargedSelector;
   PhysicsList_t physicsList;
+  Decay_t decay;
 
   neutral_propagator_t neutralPropagator;
   neutral_selector_t neutralSelector;
 
   VoidDetector detector;
 
+  /// The (optional) geometric-locality order of the particles
+  std::shared_ptr<LocalityOrder> localityOrder = nullptr;
+
+  /// The (optional) range out of slow charged particles
+  std::shared_ptr<RangeOut> rangeOut = nullptr;
+
+  /// The (optional) budget and fast-forward of loopers
+  std::shared_ptr<LooperControl> looperControl = nullptr;
+
+  /// The (optional) physics list variants and production cuts per volume
+  std::shared_ptr<const PhysicsRegions> physicsRegions = nullptr;
+
+  /// The (optional) kill volumes and envelope, the particles are
+  /// terminated there and their boundary records handed to the hit
+  /// collection if it has crossed(record)
+  std::shared_ptr<KillVolumes> killVolumes = nullptr;
+
+  /// The (optional) pre-check whether a particle can reach a sensitive
+  /// layer at all, the others are not propagated
+  std::shared_ptr<Reachability> reachability = nullptr;
+
   std::shared_ptr<const Acts::Logger> mlogger = nullptr;
 
   bool debug = false;
@@ -67,7 +132,10 @@ struct Simulator {
   /// @tparam context_t Type pf the context object
   /// @tparam generator_t Type of the generator object
   /// @tparam event_collection_t Type of the event collection
-  /// @tparam hit_collection_t Type of the hit collection, needs insert()
+  /// @tparam hit_collection_t Type of the hit collection, needs insert();
+  ///         a HitStore is built at the end of the event, and if it has
+  ///         finished(particle) it gets the final state of every particle,
+  ///         if it has crossed(record) the particles at kill boundaries
   ///
   /// @param fatrasContext is the event-bound context
   /// @param fatrasGenerator is the event-bound random generator
@@ -78,6 +146,38 @@ struct Simulator {
   void operator()(context_t &fatrasContext, generator_t &fatrasGenerator,
                   event_collection_t &fatrasEvent,
                   hit_collection_t &fatrasHits) const {
+    simulate(fatrasContext, fatrasGenerator, fatrasEvent, fatrasHits,
+             nullptr);
+  }
+
+  /// @brief call operator to the simulator with truth recording
+  ///
+  /// The truth graph is reset and filled with the vertex/particle
+  /// relations of the event: every vertex of the event collection becomes
+  /// a primary vertex, and the secondaries of a particle are attached to
+  /// vertices with the particle as incoming one. The particle index is
+  /// the running index over the outgoing particles of all vertices.
+  ///
+  /// @param fatrasContext is the event-bound context
+  /// @param fatrasGenerator is the event-bound random generator
+  /// @param fatrasEvent is the truth event collection
+  /// @param fatrasHits is the hit collection
+  /// @param truthGraph is the truth record to be filled
+  template <typename context_t, typename generator_t,
+            typename event_collection_t, typename hit_collection_t>
+  void operator()(context_t &fatrasContext, generator_t &fatrasGenerator,
+                  event_collection_t &fatrasEvent, hit_collection_t &fatrasHits,
+                  TruthGraph &truthGraph) const {
+    simulate(fatrasContext, fatrasGenerator, fatrasEvent, fatrasHits,
+             &truthGraph);
+  }
+
+private:
+  template <typename context_t, typename generator_t,
+            typename event_collection_t, typename hit_collection_t>
+  void simulate(context_t &fatrasContext, generator_t &fatrasGenerator,
+                event_collection_t &fatrasEvent, hit_collection_t &fatrasHits,
+                TruthGraph *truth) const {
 
     // if screen output is required
     typedef Acts::detail::DebugOutputActor DebugOutput;
@@ -85,28 +185,106 @@ struct Simulator {
     // Action list, abort list and options
     typedef Acts::ActionList<charged_interactor_t, DebugOutput>
         ChargedActionList;
-    typedef Acts::AbortList<Acts::detail::EndOfWorldReached> ChargedAbortList;
+    typedef Acts::AbortList<Acts::detail::EndOfWorldReached,
+                            ParticleKilled<charged_interactor_t>>
+        ChargedAbortList;
     typedef Acts::PropagatorOptions<ChargedActionList, ChargedAbortList>
         ChargedOptions;
 
     // Action list, abort list and
     typedef Acts::ActionList<neutral_interactor_t, DebugOutput>
         NeutralActionList;
-    typedef Acts::AbortList<Acts::detail::EndOfWorldReached> NeutralAbortList;
+    typedef Acts::AbortList<Acts::detail::EndOfWorldReached,
+                            ParticleKilled<neutral_interactor_t>>
+        NeutralAbortList;
     typedef Acts::PropagatorOptions<NeutralActionList, NeutralAbortList>
         NeutralOptions;
 
+    // the processing order of the particles and their species
+    std::vector<std::size_t> order;
+    std::vector<int> species;
+
+    // the secondary barcodes are allocated per primary, particles without
+    // hierarchical barcode keep the barcodes given by the physics
+    std::unordered_map<barcode_type, BarcodeAllocator> barcodes;
+    auto barcodeAllocator = [&](const auto &particle) -> BarcodeAllocator * {
+      Barcode barcode(particle.barcode());
+      if (not barcode.isValid()) {
+        return nullptr;
+      }
+      Barcode primary = barcode.primaryBarcode();
+      return &barcodes.try_emplace(primary.value(), primary).first->second;
+    };
+
+    // the cache counts are collected with the locality counters
+    std::optional<CacheCounter> cacheCounter;
+    if (localityOrder) {
+      cacheCounter.emplace();
+      cacheCounter->start();
+    }
+
+    // the particle index offset of the current vertex in the truth record
+    TruthGraph::Index offset = 0;
+    if (truth) {
+      truth->clear();
+    }
+
     // loop over the input events
     // -> new secondaries will just be attached to that
     for (auto &vertex : fatrasEvent) {
+      order.clear();
+      // the primary vertex, placed at the first outgoing particle
+      if (truth and vertex.outgoing.size()) {
+        auto first = vertex.outgoing[0];
+        auto primaryVertex = truth->addVertex(first.position(), first.time());
+        for (std::size_t j = 0; j < vertex.outgoing.size(); ++j) {
+          truth->addOutgoing(primaryVertex, offset + j);
+        }
+      }
       // take care here, the simulation can change the
       // particle collection
-      for (std::size_t i = 0; i < vertex.outgoing.size(); i++) {
+      for (std::size_t n = 0; n < vertex.outgoing.size(); n++) {
+        // particles are processed in batches, the secondaries created
+        // by one batch are scheduled once it is done
+        if (n == order.size()) {
+          order.resize(vertex.outgoing.size());
+          std::iota(order.begin() + n, order.end(), n);
+          // bin by species to run the same specialised physics in a row
+          if constexpr (is_species_dispatch_v<PhysicsList_t>) {
+            species.resize(order.size());
+            for (std::size_t j = n; j < order.size(); ++j) {
+              species[j] = PhysicsList_t::speciesIndex(vertex.outgoing[j]);
+            }
+            std::stable_sort(order.begin() + n, order.end(),
+                             [&](std::size_t a, std::size_t b) {
+                               return species[a] < species[b];
+                             });
+          }
+          // tile after tile, this overrides the species; it is the last
+          // reordering, the switches are counted on the processed order
+          if (localityOrder) {
+            localityOrder->sort(vertex.outgoing, order, n);
+          }
+        }
+        const std::size_t i = order[n];
         // create a local copy since the collection can reallocate and
         // invalidate any reference.
         auto particle = vertex.outgoing[i];
-        // charged particle detected and selected
-        if (chargedSelector(detector, particle)) {
+        // the selectors are evaluated once, charged ones take precedence
+        const bool charged = chargedSelector(detector, particle);
+        const bool neutral =
+            not charged and neutralSelector(detector, particle);
+        // selected particle that can not reach a sensitive layer
+        if (reachability and (charged or neutral) and
+            not(*reachability)(particle)) {
+          if constexpr (detail::takes_particles_v<hit_collection_t,
+                                                  decltype(particle)>) {
+            if (reachability->config().record) {
+              fatrasHits.finished(particle);
+            }
+          }
+        } else if (charged) {
+          // charged particle detected and selected
           // Need to construct them per call to set the particle
           // Options and configuration
           ChargedOptions chargedOptions(fatrasContext.geoContext,
@@ -121,8 +299,17 @@ struct Simulator {
           chargedInteractor.generator = &fatrasGenerator;
           // Put all the additional information into the interactor
           chargedInteractor.initialParticle = particle;
-          // Set the physics list
+          // Set the physics list and the decay module
           chargedInteractor.physicsList = physicsList;
+          if constexpr (is_species_dispatch_v<PhysicsList_t>) {
+            chargedInteractor.physicsList.species = species[i];
+          }
+          chargedInteractor.decay = decay;
+          chargedInteractor.physicsRegions = physicsRegions.get();
+          chargedInteractor.rangeOut = rangeOut.get();
+          chargedInteractor.looperControl = looperControl.get();
+          chargedInteractor.killVolumes = killVolumes.get();
+          chargedInteractor.barcodeAllocator = barcodeAllocator(particle);
           // Create the kinematic start parameters
           Acts::CurvilinearParameters start(std::nullopt, particle.position(),
                                             particle.momentum(), particle.q(),
@@ -137,15 +324,29 @@ struct Simulator {
           for (const auto &fHit : fatrasResult.simulatedHits) {
             fatrasHits.insert(fHit);
           }
+          if constexpr (detail::takes_particles_v<
+                            hit_collection_t,
+                            decltype(fatrasResult.particle)>) {
+            fatrasHits.finished(fatrasResult.particle);
+          }
+          if constexpr (detail::takes_boundaries_v<hit_collection_t>) {
+            if (fatrasResult.boundary) {
+              fatrasHits.crossed(*fatrasResult.boundary);
+            }
+          }
           // b) deal with the particles
           const auto &simparticles = fatrasResult.outgoing;
+          if (truth) {
+            truth->addSecondaries(offset + i, offset + vertex.outgoing.size(),
+                                  simparticles);
+          }
           vertex.outgoing_insert(simparticles);
           // c) screen output if requested
           if (debug) {
             auto &fatrasDebug = result.template get<DebugOutput::result_type>();
             ACTS_INFO(fatrasDebug.debugString);
           }
-        } else if (neutralSelector(detector, particle)) {
+        } else if (neutral) {
           // Options and configuration
           NeutralOptions neutralOptions(fatrasContext.geoContext,
                                         fatrasContext.magFieldContext);
@@ -159,14 +360,37 @@ struct Simulator {
           neutralInteractor.generator = &fatrasGenerator;
           // Put all the additional information into the interactor
           neutralInteractor.initialParticle = particle;
+          neutralInteractor.physicsRegions = physicsRegions.get();
+          neutralInteractor.killVolumes = killVolumes.get();
+          neutralInteractor.barcodeAllocator = barcodeAllocator(particle);
+          // Set the decay module if it is shared with the charged particles
+          if constexpr (std::is_same_v<
+                            Decay_t, typename neutral_interactor_t::Decay_t>) {
+            neutralInteractor.decay = decay;
+          }
           // Create the kinematic start parameters
           Acts::NeutralCurvilinearParameters start(
-              std::nullopt, particle.position(), particle.momentum(), 0.);
+              std::nullopt, particle.position(), particle.momentum(),
+              particle.time());
           const auto &result =
               neutralPropagator.propagate(start, neutralOptions).value();
           auto &fatrasResult = result.template get<NeutralResult>();
+          if constexpr (detail::takes_particles_v<
+                            hit_collection_t,
+                            decltype(fatrasResult.particle)>) {
+            fatrasHits.finished(fatrasResult.particle);
+          }
+          if constexpr (detail::takes_boundaries_v<hit_collection_t>) {
+            if (fatrasResult.boundary) {
+              fatrasHits.crossed(*fatrasResult.boundary);
+            }
+          }
           // a) deal with the particles
           const auto &simparticles = fatrasResult.outgoing;
+          if (truth) {
+            truth->addSecondaries(offset + i, offset + vertex.outgoing.size(),
+                                  simparticles);
+          }
           vertex.outgoing_insert(simparticles);
           // b) screen output if requested
           if (debug) {
@@ -174,8 +398,19 @@ struct Simulator {
             ACTS_INFO(fatrasDebug.debugString);
           }
         } // neutral processing
-      }   // loop over particles
-    }     // loop over events
+      } // loop over particles
+      offset += vertex.outgoing.size();
+    } // loop over events
+    if (localityOrder) {
+      localityOrder->addCacheCounts(cacheCounter->stop());
+    }
+    if (truth) {
+      truth->build();
+    }
+    // the flat hit store is sorted once per event
+    if constexpr (is_hit_store_v<hit_collection_t>) {
+      fatrasHits.build();
+    }
   }
 };
 
@@ -0,0 +1,245 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/Kernel/SelectorExpression.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include <cstdlib>
+
+namespace Fatras {
+
+/// Compile-time particle species
+///
+/// A species tag fixes what is known about a particle at compile time,
+/// physics modules and selectors can then decide species-dependent branches
+/// statically instead of on every call.
+namespace species {
+
+/// Any particle, everything is decided at run time
+struct Any {
+  static constexpr int absPdg = 0;
+  static constexpr bool knownCharge = false;
+  static constexpr bool charged = false;
+
+  template <typename particle_t> static bool contains(const particle_t &) {
+    return true;
+  }
+};
+
+/// Electrons and positrons
+struct Electron {
+  static constexpr int absPdg = 11;
+  static constexpr bool knownCharge = true;
+  static constexpr bool charged = true;
+
+  template <typename particle_t>
+  static bool contains(const particle_t &particle) {
+    return std::abs(particle.pdg()) == absPdg;
+  }
+};
+
+/// Positive and negative muons
+struct Muon {
+  static constexpr int absPdg = 13;
+  static constexpr bool knownCharge = true;
+  static constexpr bool charged = true;
+
+  template <typename particle_t>
+  static bool contains(const particle_t &particle) {
+    return std::abs(particle.pdg()) == absPdg;
+  }
+};
+
+/// Photons
+struct Photon {
+  static constexpr int absPdg = 22;
+  static constexpr bool knownCharge = true;
+  static constexpr bool charged = false;
+
+  template <typename particle_t>
+  static bool contains(const particle_t &particle) {
+    return particle.pdg() == absPdg;
+  }
+};
+
+/// Charged particles that are neither electrons nor muons
+struct ChargedHadron {
+  static constexpr int absPdg = 0;
+  static constexpr bool knownCharge = true;
+  static constexpr bool charged = true;
+
+  template <typename particle_t>
+  static bool contains(const particle_t &particle) {
+    const int absPdg = std::abs(particle.pdg());
+    return particle.q() != 0. and absPdg != Electron::absPdg and
+           absPdg != Muon::absPdg;
+  }
+};
+
+/// The pdg code as used by the physics modules
+///
+/// This is the absolute pdg code for species with a single one, the one of
+/// the particle otherwise.
+template <typename species_t, typename particle_t>
+constexpr int physicsPdg(const particle_t &particle) {
+  if constexpr (species_t::absPdg != 0) {
+    return species_t::absPdg;
+  } else {
+    return particle.pdg();
+  }
+}
+
+/// Check for electrons, known at compile time for a fixed species
+template <typename species_t, typename particle_t>
+constexpr bool isElectron(const particle_t &particle) {
+  if constexpr (species_t::absPdg != 0) {
+    return species_t::absPdg == Electron::absPdg;
+  } else {
+    return std::abs(particle.pdg()) == Electron::absPdg;
+  }
+}
+
+} // namespace species
+
+/// The decision of a selector that is known at compile time for a species
+enum class Acceptance { Never, Always, Runtime };
+
+/// Compile-time decision of a selector for a species
+///
+/// The default is a run time decision, selectors that can be decided from
+/// the species alone are specialised below.
+template <typename selector_t, typename species_t>
+struct species_acceptance {
+  static constexpr Acceptance value = Acceptance::Runtime;
+};
+
+template <typename selector_t, typename species_t>
+constexpr Acceptance species_acceptance_v =
+    species_acceptance<selector_t, species_t>::value;
+
+namespace detail {
+
+constexpr Acceptance invert(Acceptance a) {
+  return a == Acceptance::Runtime
+             ? a
+             : (a == Acceptance::Never ? Acceptance::Always
+                                       : Acceptance::Never);
+}
+
+template <typename species_t> constexpr Acceptance charged() {
+  if constexpr (not species_t::knownCharge) {
+    return Acceptance::Runtime;
+  } else {
+    return species_t::charged ? Acceptance::Always : Acceptance::Never;
+  }
+}
+
+template <typename species_t> constexpr Acceptance absPdgIs(int absPdg) {
+  if constexpr (species_t::absPdg == 0) {
+    return Acceptance::Runtime;
+  } else {
+    return species_t::absPdg == absPdg ? Acceptance::Always
+                                       : Acceptance::Never;
+  }
+}
+
+template <typename species_t> constexpr Acceptance pdgIs(int pdg) {
+  // the sign is only known at run time
+  Acceptance a = absPdgIs<species_t>(pdg < 0 ? -pdg : pdg);
+  return a == Acceptance::Always ? Acceptance::Runtime : a;
+}
+
+} // namespace detail
+
+template <typename species_t>
+struct species_acceptance<ChargedSelector, species_t> {
+  static constexpr Acceptance value = detail::charged<species_t>();
+};
+
+template <typename species_t>
+struct species_acceptance<NeutralSelector, species_t> {
+  static constexpr Acceptance value =
+      detail::invert(detail::charged<species_t>());
+};
+
+template <int pdg_t, typename species_t>
+struct species_acceptance<AbsPdgSelector<pdg_t>, species_t> {
+  static constexpr Acceptance value =
+      detail::absPdgIs<species_t>(pdg_t < 0 ? -pdg_t : pdg_t);
+};
+
+template <int pdg_t, typename species_t>
+struct species_acceptance<AbsPdgExcluder<pdg_t>, species_t> {
+  static constexpr Acceptance value = detail::invert(
+      detail::absPdgIs<species_t>(pdg_t < 0 ? -pdg_t : pdg_t));
+};
+
+template <int pdg_t, typename species_t>
+struct species_acceptance<PdgSelector<pdg_t>, species_t> {
+  static constexpr Acceptance value = detail::pdgIs<species_t>(pdg_t);
+};
+
+template <int pdg_t, typename species_t>
+struct species_acceptance<PdgExcluder<pdg_t>, species_t> {
+  static constexpr Acceptance value =
+      detail::invert(detail::pdgIs<species_t>(pdg_t));
+};
+
+/// Selector lists combine the decisions of their members
+template <bool inclusive, typename... selectors, typename species_t>
+struct species_acceptance<SelectorListAXOR<inclusive, selectors...>,
+                          species_t> {
+private:
+  static constexpr Acceptance decisive =
+      inclusive ? Acceptance::Always : Acceptance::Never;
+  static constexpr bool anyDecisive =
+      ((species_acceptance_v<selectors, species_t> == decisive) or ...);
+  static constexpr bool allDecided =
+      ((species_acceptance_v<selectors, species_t> != Acceptance::Runtime) and
+       ...);
+
+public:
+  // an empty list accepts everything
+  static constexpr Acceptance value =
+      (sizeof...(selectors) == 0)
+          ? Acceptance::Always
+          : (anyDecisive ? decisive
+                         : (allDecided ? detail::invert(decisive)
+                                       : Acceptance::Runtime));
+};
+
+/// Selector expressions combine the decisions of their terms
+template <bool conjunction, bool by_cost, typename... terms, typename species_t>
+struct species_acceptance<SelectorExpression<conjunction, by_cost, terms...>,
+                          species_t> {
+private:
+  static constexpr Acceptance decisive =
+      conjunction ? Acceptance::Never : Acceptance::Always;
+  static constexpr bool anyDecisive =
+      ((species_acceptance_v<terms, species_t> == decisive) or ...);
+  static constexpr bool allDecided =
+      ((species_acceptance_v<terms, species_t> != Acceptance::Runtime) and
+       ...);
+
+public:
+  static constexpr Acceptance value =
+      anyDecisive ? decisive
+                  : (allDecided ? detail::invert(decisive)
+                                : Acceptance::Runtime);
+};
+
+template <typename term_t, typename species_t>
+struct species_acceptance<Not<term_t>, species_t> {
+  static constexpr Acceptance value =
+      detail::invert(species_acceptance_v<term_t, species_t>);
+};
+
+} // namespace Fatras
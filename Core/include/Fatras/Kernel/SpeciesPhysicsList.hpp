@@ -0,0 +1,149 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/detail/Extendable.hpp"
+#include "Acts/Utilities/detail/MPL/all_of.hpp"
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/detail/process_signature_check.hpp"
+#include "Fatras/Kernel/detail/selector_memo.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief A PhysicsList specialised for one particle species
+///
+/// The processes are called in order as in the PhysicsList, but the
+/// selectors that are decided by the species are resolved at compile time.
+/// Processes that never apply to the species are removed by the compiler.
+///
+/// @tparam species_t is the species the list is valid for
+/// @tparam processes are the processes of the list
+template <typename species_t, typename... processes>
+struct SpeciesPhysicsList : private Acts::detail::Extendable<processes...> {
+private:
+  using Acts::detail::Extendable<processes...>::tuple;
+
+public:
+  using Acts::detail::Extendable<processes...>::get;
+
+  /// The species this list is specialised for
+  using Species = species_t;
+
+  /// Check if the list is responsible for a particle
+  template <typename particle_t>
+  static bool contains(const particle_t &particle) {
+    return species_t::contains(particle);
+  }
+
+  /// Call operator that broadcasts the call to the processes
+  ///
+  /// @tparam generator_t is the random number generator type
+  /// @tparam detector_t is the detector information type used
+  /// @tparam particle_t is the particle type used in simulation
+  ///
+  /// @param[in] gen is the generator object
+  /// @param[in] det is the necessary detector information
+  /// @param[in] in is the ingoing particle (can be modified)
+  /// @param[in,out] out are the (eventually) outgoing particles
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out) const {
+    // clang-format off
+    static_assert(Acts::detail::all_of_v<detail::process_signature_check_v<processes, generator_t, detector_t, particle_t>...>,
+                  "not all processes support the specified interface");
+    // clang-format on
+    // the selectors shared by the processes are evaluated once
+    detail::physics_list_cache_t<processes...> cache;
+    return std::apply(
+        [&](const auto &... process) {
+          // stop at the first process that kills the particle
+          return (detail::apply_process<species_t>(process, gen, det, in, out,
+                                                   cache) or
+                  ...);
+        },
+        tuple());
+  }
+};
+
+/// @brief Dispatch to physics lists specialised per species
+///
+/// The first list that contains the particle is used, particles that are
+/// not contained in any of the lists see no physics. The species can be
+/// fixed once per particle by the caller, it is deduced per call otherwise.
+///
+/// @tparam lists are the SpeciesPhysicsList types
+template <typename... lists>
+struct SpeciesDispatch : private Acts::detail::Extendable<lists...> {
+private:
+  using Acts::detail::Extendable<lists...>::tuple;
+
+public:
+  using Acts::detail::Extendable<lists...>::get;
+
+  /// The number of species bins, the last one collects unhandled particles
+  static constexpr std::size_t nSpecies = sizeof...(lists) + 1;
+
+  /// The species bin to be used, deduced per call if negative
+  int species = -1;
+
+  /// The species bin of a particle
+  ///
+  /// @param particle is the particle to be classified
+  ///
+  /// @return the index of the first list that contains the particle
+  template <typename particle_t>
+  static int speciesIndex(const particle_t &particle) {
+    int index = 0;
+    // count the lists before the first one that contains the particle
+    ((lists::contains(particle) ? true : (++index, false)) or ...);
+    return index;
+  }
+
+  /// Call operator that is forwarded to the species list
+  ///
+  /// @return indicator which would trigger an abort
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &gen, const detector_t &det, particle_t &in,
+                  std::vector<particle_t> &out) const {
+    const int index = (species < 0) ? speciesIndex(in) : species;
+    return dispatch(std::index_sequence_for<lists...>(), index, gen, det, in,
+                    out);
+  }
+
+private:
+  template <std::size_t... is, typename generator_t, typename detector_t,
+            typename particle_t>
+  bool dispatch(std::index_sequence<is...>, int index, generator_t &gen,
+                const detector_t &det, particle_t &in,
+                std::vector<particle_t> &out) const {
+    bool kill = false;
+    ((int(is) == index
+          ? (kill = std::get<is>(tuple())(gen, det, in, out), true)
+          : false) or
+     ...);
+    return kill;
+  }
+};
+
+/// Check for a species dispatching physics list
+template <typename T> struct is_species_dispatch : std::false_type {};
+
+template <typename... lists>
+struct is_species_dispatch<SpeciesDispatch<lists...>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_species_dispatch_v = is_species_dispatch<T>::value;
+
+} // namespace Fatras
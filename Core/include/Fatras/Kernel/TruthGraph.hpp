@@ -0,0 +1,179 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Flat truth record of the vertex/particle relations of an event
+///
+/// Vertices and particles are identified by their index, the particle
+/// index is the position of the particle in the simulated event (e.g. the
+/// ParticleStore index). While the event is simulated the relations are
+/// appended as flat edge lists; build() then sorts them into compressed
+/// sparse row (CSR) tables, such that every relation is a contiguous
+/// index range:
+///
+/// - vertex -> outgoing particles
+/// - particle -> production vertex, and end vertices it interacted in
+/// - particle -> parent and children
+///
+/// The relations can only be queried after build().
+class TruthGraph {
+public:
+  /// The vertex and particle index
+  using Index = std::uint32_t;
+
+  /// The index marking a missing relation, e.g. the parent of a primary
+  static constexpr Index invalid = std::numeric_limits<Index>::max();
+
+  /// A contiguous range of indices
+  struct Range {
+    const Index *first = nullptr;
+    const Index *last = nullptr;
+
+    const Index *begin() const { return first; }
+    const Index *end() const { return last; }
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    Index operator[](std::size_t i) const { return first[i]; }
+  };
+
+  /// A truth vertex
+  struct Vertex {
+    /// The vertex position
+    Acts::Vector3D position = Acts::Vector3D(0., 0., 0.);
+    /// The vertex time
+    double time = 0.;
+    /// The incoming particle, invalid for the primary vertices
+    Index incoming = invalid;
+  };
+
+  /// Default constructor for an empty graph
+  TruthGraph() = default;
+
+  /// Reserve the edge lists
+  ///
+  /// @param vertices is the expected number of vertices
+  /// @param particles is the expected number of particles
+  void reserve(std::size_t vertices, std::size_t particles);
+
+  /// Remove all vertices and relations, the capacity is kept
+  void clear();
+
+  /// @brief Add a vertex
+  ///
+  /// @param position is the vertex position
+  /// @param time is the vertex time
+  /// @param incoming is the particle ending or interacting at the vertex
+  ///
+  /// @return the index of the vertex
+  Index addVertex(const Acts::Vector3D &position, double time,
+                  Index incoming = invalid);
+
+  /// @brief Attach an outgoing particle to a vertex
+  ///
+  /// @param vertex is the production vertex of the particle
+  /// @param particle is the particle index
+  void addOutgoing(Index vertex, Index particle);
+
+  /// @brief Record the secondaries of one simulated particle
+  ///
+  /// The secondaries are expected in the order they were created; those
+  /// created at the same position and time share one vertex.
+  ///
+  /// @tparam particle_t Type of the particle
+  ///
+  /// @param parent is the index of the simulated particle
+  /// @param first is the index of the first secondary
+  /// @param secondaries are the secondaries, with consecutive indices
+  template <typename particle_t>
+  void addSecondaries(Index parent, Index first,
+                      const std::vector<particle_t> &secondaries) {
+    Index vertex = invalid;
+    for (std::size_t i = 0; i < secondaries.size(); ++i) {
+      const auto &secondary = secondaries[i];
+      if (vertex == invalid or
+          m_vertices[vertex].position != secondary.position() or
+          m_vertices[vertex].time != secondary.time()) {
+        vertex = addVertex(secondary.position(), secondary.time(), parent);
+      }
+      addOutgoing(vertex, first + static_cast<Index>(i));
+    }
+  }
+
+  /// Sort the recorded relations into the CSR tables
+  void build();
+
+  /// The number of vertices
+  std::size_t vertices() const { return m_vertices.size(); }
+
+  /// The number of particles, i.e. the largest recorded index + 1
+  std::size_t particles() const { return m_production.size(); }
+
+  /// The vertex at an index
+  const Vertex &vertex(Index vertex) const { return m_vertices[vertex]; }
+
+  /// The particles produced at a vertex
+  Range outgoing(Index vertex) const {
+    return range(m_outgoingOffsets, m_outgoing, vertex);
+  }
+
+  /// The production vertex of a particle
+  Index productionVertex(Index particle) const {
+    return m_production[particle];
+  }
+
+  /// The vertices a particle interacted or ended in
+  Range endVertices(Index particle) const {
+    return range(m_endOffsets, m_end, particle);
+  }
+
+  /// The parent of a particle, invalid for primaries
+  Index parent(Index particle) const {
+    Index vertex = m_production[particle];
+    return vertex == invalid ? invalid : m_vertices[vertex].incoming;
+  }
+
+  /// The children of a particle from all its end vertices
+  Range children(Index particle) const {
+    return range(m_childOffsets, m_children, particle);
+  }
+
+private:
+  static Range range(const std::vector<Index> &offsets,
+                     const std::vector<Index> &indices, Index i) {
+    return {indices.data() + offsets[i], indices.data() + offsets[i + 1]};
+  }
+
+  /// The vertices
+  std::vector<Vertex> m_vertices;
+  /// The recorded (vertex, particle) production edges
+  std::vector<std::pair<Index, Index>> m_edges;
+
+  /// vertex -> outgoing particles
+  std::vector<Index> m_outgoingOffsets;
+  std::vector<Index> m_outgoing;
+  /// particle -> production vertex
+  std::vector<Index> m_production;
+  /// particle -> end vertices
+  std::vector<Index> m_endOffsets;
+  std::vector<Index> m_end;
+  /// particle -> children
+  std::vector<Index> m_childOffsets;
+  std::vector<Index> m_children;
+};
+
+} // namespace Fatras
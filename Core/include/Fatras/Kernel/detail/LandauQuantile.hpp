@@ -11,13 +11,14 @@
 #include <cmath>
 #include <limits>
 
-static inline double landau_quantile(double z, double xi) {
+template <typename scalar_t>
+static inline scalar_t landau_quantile(scalar_t z, scalar_t xi) {
   // LANDAU quantile : algorithm from CERNLIB G110 ranlan
   // with scale parameter xi
   // Converted by Rene Brun from CERNLIB routine ranlan(G110),
   // Moved and adapted to QuantFuncMathCore by B. List 29.4.2010
 
-  static double f[982] = {
+  static const scalar_t f[982] = {
       0,         0,         0,         0,         0,         -2.244733,
       -2.204365, -2.168163, -2.135219, -2.104898, -2.076740, -2.050397,
       -2.025605, -2.002150, -1.979866, -1.958612, -1.938275, -1.918760,
@@ -186,11 +187,13 @@ static inline double landau_quantile(double z, double xi) {
   if (xi <= 0)
     return 0;
   if (z <= 0)
-    return -std::numeric_limits<double>::infinity();
+    return -std::numeric_limits<scalar_t>::infinity();
   if (z >= 1)
-    return std::numeric_limits<double>::infinity();
+    return std::numeric_limits<scalar_t>::infinity();
 
-  double ranlan, u, v;
+  // keep all constants in the requested precision
+  using s = scalar_t;
+  scalar_t ranlan, u, v;
   u = 1000 * z;
   int i = int(u);
   u -= i;
@@ -199,22 +202,22 @@ static inline double landau_quantile(double z, double xi) {
   } else if (i >= 7 && i <= 980) {
     ranlan = f[i - 1] +
              u * (f[i] - f[i - 1] -
-                  0.25 * (1 - u) * (f[i + 1] - f[i] - f[i - 1] + f[i - 2]));
+                  s(0.25) * (1 - u) * (f[i + 1] - f[i] - f[i - 1] + f[i - 2]));
   } else if (i < 7) {
     v = std::log(z);
     u = 1 / v;
-    ranlan = ((0.99858950 + (3.45213058E1 + 1.70854528E1 * u) * u) /
-              (1 + (3.41760202E1 + 4.01244582 * u) * u)) *
-             (-std::log(-0.91893853 - v) - 1);
+    ranlan = ((s(0.99858950) + (s(3.45213058E1) + s(1.70854528E1) * u) * u) /
+              (1 + (s(3.41760202E1) + s(4.01244582) * u) * u)) *
+             (-std::log(s(-0.91893853) - v) - 1);
   } else {
     u = 1 - z;
     v = u * u;
-    if (z <= 0.999) {
-      ranlan = (1.00060006 + 2.63991156E2 * u + 4.37320068E3 * v) /
-               ((1 + 2.57368075E2 * u + 3.41448018E3 * v) * u);
+    if (z <= s(0.999)) {
+      ranlan = (s(1.00060006) + s(2.63991156E2) * u + s(4.37320068E3) * v) /
+               ((1 + s(2.57368075E2) * u + s(3.41448018E3) * v) * u);
     } else {
-      ranlan = (1.00001538 + 6.07514119E3 * u + 7.34266409E5 * v) /
-               ((1 + 6.06511919E3 * u + 6.94021044E5 * v) * u);
+      ranlan = (s(1.00001538) + s(6.07514119E3) * u + s(7.34266409E5) * v) /
+               ((1 + s(6.06511919E3) * u + s(6.94021044E5) * v) * u);
     }
   }
   return xi * ranlan;
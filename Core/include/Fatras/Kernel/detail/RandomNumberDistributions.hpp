@@ -13,25 +13,39 @@
 
 namespace Fatras {
 
-/// The following standard random number distributions are supported:
+/// The following standard random number distributions are supported,
+/// they are provided for a given scalar type:
 ///
-using GaussDist = std::normal_distribution<double>;         ///< Normal
-using UniformDist = std::uniform_real_distribution<double>; ///< Uniform
-using GammaDist = std::gamma_distribution<double>;          ///< Gamma
-using PoissonDist = std::poisson_distribution<int>;         ///< Poisson
+template <typename scalar_t>
+using BasicGaussDist = std::normal_distribution<scalar_t>; ///< Normal
+template <typename scalar_t>
+using BasicUniformDist = std::uniform_real_distribution<scalar_t>; ///< Uniform
+template <typename scalar_t>
+using BasicGammaDist = std::gamma_distribution<scalar_t>; ///< Gamma
+template <typename scalar_t>
+using BasicExponentialDist =
+    std::exponential_distribution<scalar_t>; ///< Exponential
+///
+/// and in double precision:
+///
+using GaussDist = BasicGaussDist<double>;             ///< Normal
+using UniformDist = BasicUniformDist<double>;         ///< Uniform
+using GammaDist = BasicGammaDist<double>;             ///< Gamma
+using ExponentialDist = BasicExponentialDist<double>; ///< Exponential
+using PoissonDist = std::poisson_distribution<int>;   ///< Poisson
 ///
 /// In addition, the Landau distribution is provided
 ///
-class LandauDist {
+template <typename scalar_t> class BasicLandauDist {
 public:
   /// A RandomNumberDistribution should provide a parameters struct
   struct param_type {
-    double mean = 0.;  ///< Mean of the Landau distribution
-    double scale = 1.; ///< Scale factor
+    scalar_t mean = 0.;  ///< Mean of the Landau distribution
+    scalar_t scale = 1.; ///< Scale factor
 
     /// Default constructor and constructor from raw parameters
     param_type() = default;
-    param_type(double mean, double scale);
+    param_type(scalar_t mean, scalar_t scale);
 
     /// Parameters should be CopyConstructible and CopyAssignable
     param_type(const param_type &) = default;
@@ -42,18 +56,18 @@ public:
     bool operator!=(const param_type &other) const { return !(*this == other); }
 
     /// Parameters should link back to the host distribution
-    using distribution_type = LandauDist;
+    using distribution_type = BasicLandauDist;
   };
 
   /// There should be a default constructor, a constructor from raw parameters,
   /// and a constructor from a parameters struct
-  LandauDist() = default;
-  LandauDist(double mean, double scale);
-  LandauDist(const param_type &cfg);
+  BasicLandauDist() = default;
+  BasicLandauDist(scalar_t mean, scalar_t scale);
+  BasicLandauDist(const param_type &cfg);
 
   /// A distribution should be copy-constructible and copy-assignable
-  LandauDist(const LandauDist &) = default;
-  LandauDist &operator=(const LandauDist &) = default;
+  BasicLandauDist(const BasicLandauDist &) = default;
+  BasicLandauDist &operator=(const BasicLandauDist &) = default;
 
   /// Some standard ways to control the distribution's state should be provided
   void reset() { /* There is currently no state to reset here */
@@ -63,7 +77,7 @@ public:
 
   /// A RandomNumberDistribution should provide a result type typedef and some
   /// bounds on the values that can be emitted as output
-  using result_type = double;
+  using result_type = scalar_t;
   result_type min() const;
   result_type max() const;
 
@@ -75,16 +89,25 @@ public:
   /// Do the same, but using custom Landau distribution parameters
   template <typename Generator>
   result_type operator()(Generator &engine, const param_type &params) {
-    double x = std::generate_canonical<float, 10>(engine);
-    double res = params.mean + landau_quantile(x, params.scale);
+    scalar_t x = std::generate_canonical<float, 10>(engine);
+    scalar_t res = params.mean + landau_quantile(x, params.scale);
     return res;
   }
 
   /// Provide standard comparison operators
-  bool operator==(const LandauDist &other) const;
-  bool operator!=(const LandauDist &other) const { return !(*this == other); }
+  bool operator==(const BasicLandauDist &other) const;
+  bool operator!=(const BasicLandauDist &other) const {
+    return !(*this == other);
+  }
 
 private:
   param_type m_cfg; ///< configuration struct
 };
+
+/// The Landau distribution is compiled for single and double precision
+extern template class BasicLandauDist<float>;
+extern template class BasicLandauDist<double>;
+
+using LandauDist = BasicLandauDist<double>;
+
 } // namespace Fatras
@@ -8,10 +8,36 @@
 
 #pragma once
 
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/detail/selector_memo.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
 namespace Fatras {
 
 namespace detail {
 
+/// Drop the secondaries of a process below the production cut
+///
+/// The energy of the dropped secondaries is not deposited anywhere, it is
+/// lost from the event: the energy is not conserved below the cut, and a
+/// sensitive surface at the interaction sees no deposit from them.
+///
+/// @param[in,out] out are the outgoing particles
+/// @param[in] first is the first secondary of the process
+/// @param[in] cut is the kinetic energy cut, not applied if not positive
+template <typename particle_t>
+void apply_production_cut(std::vector<particle_t> &out, std::size_t first,
+                          double cut) {
+  if (not(cut > 0.)) {
+    return;
+  }
+  auto below = [cut](const particle_t &p) { return p.E() - p.m() < cut; };
+  out.erase(std::remove_if(out.begin() + first, out.end(), below),
+            out.end());
+}
+
 namespace {
 
 template <typename... processes> struct physics_list_impl;
@@ -21,39 +47,43 @@ template <typename... processes> struct physics_list_impl;
 template <typename first, typename... others>
 struct physics_list_impl<first, others...> {
   template <typename T, typename generator_t, typename detector_t,
-            typename particle_t>
+            typename particle_t, typename cache_t>
   static bool process(const T &process_tuple, generator_t &gen,
                       const detector_t &det, particle_t &in,
-                      std::vector<particle_t> &out) {
+                      std::vector<particle_t> &out, cache_t &cache) {
     // pick the first process
     const auto &this_process = std::get<first>(process_tuple);
-    bool this_process_kills = this_process(gen, det, in, out);
+    bool this_process_kills =
+        apply_process<species::Any>(this_process, gen, det, in, out, cache);
     // recursive call on the remaining ones
-    return (this_process_kills || physics_list_impl<others...>::process(
-                                      process_tuple, gen, det, in, out));
+    return (this_process_kills ||
+            physics_list_impl<others...>::process(process_tuple, gen, det, in,
+                                                  out, cache));
   }
 };
 
 /// Final call pattern
 template <typename last> struct physics_list_impl<last> {
   template <typename T, typename generator_t, typename detector_t,
-            typename particle_t>
+            typename particle_t, typename cache_t>
   static bool process(const T &process_tuple, generator_t &gen,
                       const detector_t &det, particle_t &in,
-                      std::vector<particle_t> &out) {
+                      std::vector<particle_t> &out, cache_t &cache) {
     // this is the last process in the tuple
     const auto &this_process = std::get<last>(process_tuple);
-    return this_process(gen, det, in, out);
+    return apply_process<species::Any>(this_process, gen, det, in, out,
+                                       cache);
   }
 };
 
 /// Empty call pattern
 template <> struct physics_list_impl<> {
   template <typename T, typename generator_t, typename detector_t,
-            typename particle_t>
+            typename particle_t, typename cache_t>
 
   static bool process(const T &, generator_t &, const detector_t &,
-                      const particle_t &, std::vector<particle_t> &) {
+                      const particle_t &, std::vector<particle_t> &,
+                      cache_t &) {
     return false;
   }
 };
@@ -0,0 +1,34 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <type_traits>
+
+namespace Fatras {
+
+namespace detail {
+
+/// The scalar type a physics module computes with
+///
+/// This is the Scalar typedef of the module if it provides one,
+/// double precision otherwise.
+template <typename T, typename = void> struct scalar_type {
+  using type = double;
+};
+
+template <typename T>
+struct scalar_type<T, std::void_t<typename T::Scalar>> {
+  using type = typename T::Scalar;
+};
+
+template <typename T> using scalar_type_t = typename scalar_type<T>::type;
+
+} // namespace detail
+
+} // namespace Fatras
@@ -0,0 +1,151 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Fatras {
+
+namespace detail {
+
+/// The relative evaluation cost of a selector, 1 if not specified
+template <typename T, typename = void> struct selector_cost {
+  static constexpr unsigned int value = 1;
+};
+
+template <typename T>
+struct selector_cost<T, std::void_t<decltype(T::cost)>> {
+  static constexpr unsigned int value = T::cost;
+};
+
+template <typename T>
+constexpr unsigned int selector_cost_v = selector_cost<T>::value;
+
+/// The evaluation order of a list of terms
+///
+/// @tparam by_cost steers if the terms are (stable) sorted by cost or
+///         evaluated in the given order
+template <bool by_cost, typename... terms>
+constexpr std::array<std::size_t, sizeof...(terms)> evaluation_order() {
+  constexpr std::size_t n = sizeof...(terms);
+  std::array<unsigned int, n> costs{{selector_cost_v<terms>...}};
+  std::array<std::size_t, n> order{};
+  for (std::size_t i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  if (by_cost) {
+    // insertion sort keeps terms of equal cost in the given order
+    for (std::size_t i = 1; i < n; ++i) {
+      for (std::size_t j = i; j > 0 and costs[order[j]] < costs[order[j - 1]];
+           --j) {
+        std::size_t tmp = order[j];
+        order[j] = order[j - 1];
+        order[j - 1] = tmp;
+      }
+    }
+  }
+  return order;
+}
+
+/// Check if a selector can evaluate a batch of particles
+template <typename T, typename detector_t, typename = void>
+struct selector_batch_check : std::false_type {};
+
+template <typename T, typename detector_t>
+struct selector_batch_check<
+    T, detector_t,
+    std::void_t<decltype(std::declval<const T &>()(
+        std::declval<const detector_t &>(),
+        std::declval<const ParticleBatch &>(),
+        std::declval<std::uint8_t *>()))>> : std::true_type {};
+
+template <typename T, typename detector_t>
+constexpr bool selector_batch_check_v =
+    selector_batch_check<T, detector_t>::value;
+
+/// The number of scratch mask rows of a batch size a selector needs, 0 if
+/// not specified
+template <typename T, typename = void> struct selector_scratch_rows {
+  static constexpr std::size_t value = 0;
+};
+
+template <typename T>
+struct selector_scratch_rows<T, std::void_t<decltype(T::scratchRows)>> {
+  static constexpr std::size_t value = T::scratchRows;
+};
+
+template <typename T>
+constexpr std::size_t selector_scratch_rows_v = selector_scratch_rows<T>::value;
+
+/// Evaluate a selector on a batch, with the scratch rows if it needs them
+template <typename T, typename detector_t>
+void select_batch(const T &selector, const detector_t &detector,
+                  const ParticleBatch &batch, std::uint8_t *mask,
+                  std::uint8_t *scratch) {
+  if constexpr (selector_scratch_rows_v<T> > 0) {
+    selector(detector, batch, mask, scratch);
+  } else {
+    selector(detector, batch, mask);
+  }
+}
+
+/// Combine the batch masks of several selectors
+///
+/// The first selector writes the mask directly, the others are combined
+/// into it with a bitwise and (conjunction) or or (disjunction) through the
+/// first scratch row; the following rows are handed to nested selectors.
+/// The selectors are evaluated in the given order, and the evaluation
+/// stops as soon as all particles are decided.
+///
+/// @param scratch has to provide 1 + the maximal scratch rows of the
+///        selectors rows of the batch size
+template <bool conjunction, typename detector_t, typename... selectors_t>
+void combine_batch(const detector_t &detector, const ParticleBatch &batch,
+                   std::uint8_t *mask, std::uint8_t *scratch,
+                   const selectors_t &... selectors) {
+  if constexpr (sizeof...(selectors_t) == 0) {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = conjunction;
+    }
+  } else {
+    std::uint8_t *nested = scratch + batch.size;
+    bool first = true;
+    // returns whether any particle is undecided
+    auto apply = [&](const auto &selector) {
+      if (first) {
+        select_batch(selector, detector, batch, mask, nested);
+        first = false;
+      } else {
+        select_batch(selector, detector, batch, scratch, nested);
+        for (std::size_t i = 0; i < batch.size; ++i) {
+          if constexpr (conjunction) {
+            mask[i] &= scratch[i];
+          } else {
+            mask[i] |= scratch[i];
+          }
+        }
+      }
+      bool undecided = false;
+      for (std::size_t i = 0; i < batch.size; ++i) {
+        undecided |= (mask[i] == conjunction);
+      }
+      return undecided;
+    };
+    (apply(selectors) and ...);
+  }
+}
+
+} // namespace detail
+
+} // namespace Fatras
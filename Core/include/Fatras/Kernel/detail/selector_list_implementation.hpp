@@ -8,51 +8,34 @@
 
 #pragma once
 
+#include <tuple>
+
 namespace Fatras {
 
 namespace detail {
 
 namespace {
 
-template <typename... selectors> struct selector_list_impl;
-
-/// Recursive call pattern
-/// - make sure it bails out
-template <typename first, typename... others>
-struct selector_list_impl<first, others...> {
-  template <typename T, typename detector_t, typename particle_t>
-  static bool select(const T &slector_tuple, const detector_t &detector,
-                     const particle_t &particle, bool inclusive) {
-    // pick the first select
-    const auto &this_selector = std::get<first>(slector_tuple);
-    bool selected = this_selector(detector, particle);
-    // recursive call on the remaining ones, none of the selectors
-    // is allowed to fail - a single failed selector rejects the particle
-    // @todo check if rhs is actually evaluated if lhs fails (should not!)
-    if (inclusive)
-      return (selected || selector_list_impl<others...>::select(
-                              slector_tuple, detector, particle, inclusive));
-    return (selected && selector_list_impl<others...>::select(
-                            slector_tuple, detector, particle, inclusive));
-  }
-};
-
-/// Final call pattern
-template <typename last> struct selector_list_impl<last> {
-  template <typename T, typename detector_t, typename particle_t>
-  static bool select(const T &slector_tuple, const detector_t &detector,
-                     const particle_t &particle, bool) {
-    // this is the last select in the tuple
-    const auto &this_selector = std::get<last>(slector_tuple);
-    return this_selector(detector, particle);
-  }
-};
-
-/// Empty call pattern
-template <> struct selector_list_impl<> {
-  template <typename T, typename detector_t, typename particle_t>
-  static bool select(const T &, const detector_t &, const particle_t &, bool) {
-    return true;
+/// The combination is folded at compile time
+/// - the evaluation stops at the first decisive selector
+/// - all selectors share the cache of the evaluation
+template <bool inclusive, typename... selectors> struct selector_list_impl {
+  template <typename T, typename detector_t, typename particle_t,
+            typename cache_t>
+  static bool select(const T &selector_tuple, const detector_t &detector,
+                     const particle_t &particle, cache_t &cache) {
+    if constexpr (sizeof...(selectors) == 0) {
+      // empty lists accept all particles
+      return true;
+    } else if constexpr (inclusive) {
+      return (cache.select(std::get<selectors>(selector_tuple), detector,
+                           particle) ||
+              ...);
+    } else {
+      return (cache.select(std::get<selectors>(selector_tuple), detector,
+                           particle) &&
+              ...);
+    }
   }
 };
 
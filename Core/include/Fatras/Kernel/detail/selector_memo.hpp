@@ -0,0 +1,187 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/SelectorExpression.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Fatras {
+
+namespace detail {
+
+template <typename... types> struct type_list {};
+
+/// Selectors that only depend on the particle identity
+///
+/// Their result does not change when a process modifies the kinematics of
+/// the particle, so they can be memoised for the whole physics list call.
+template <typename T> struct is_identity_selector : std::false_type {};
+
+template <> struct is_identity_selector<ChargedSelector> : std::true_type {};
+template <> struct is_identity_selector<NeutralSelector> : std::true_type {};
+template <> struct is_identity_selector<PositiveSelector> : std::true_type {};
+template <> struct is_identity_selector<NegativeSelector> : std::true_type {};
+
+template <int pdg_t>
+struct is_identity_selector<AbsPdgSelector<pdg_t>> : std::true_type {};
+template <int pdg_t>
+struct is_identity_selector<PdgSelector<pdg_t>> : std::true_type {};
+template <int pdg_t>
+struct is_identity_selector<AbsPdgExcluder<pdg_t>> : std::true_type {};
+template <int pdg_t>
+struct is_identity_selector<PdgExcluder<pdg_t>> : std::true_type {};
+
+template <bool inclusive, typename... selectors>
+struct is_identity_selector<SelectorListAXOR<inclusive, selectors...>>
+    : std::bool_constant<(sizeof...(selectors) > 0) and
+                         (is_identity_selector<selectors>::value and ...)> {};
+
+template <bool conjunction, bool by_cost, typename... terms>
+struct is_identity_selector<SelectorExpression<conjunction, by_cost, terms...>>
+    : std::bool_constant<(sizeof...(terms) > 0) and
+                         (is_identity_selector<terms>::value and ...)> {};
+
+template <typename term_t>
+struct is_identity_selector<Not<term_t>> : is_identity_selector<term_t> {};
+
+/// The selectors that are combined by a list or an expression
+template <typename T> struct selector_terms { using type = type_list<>; };
+
+template <bool inclusive, typename... selectors>
+struct selector_terms<SelectorListAXOR<inclusive, selectors...>> {
+  using type = type_list<selectors...>;
+};
+
+template <bool conjunction, bool by_cost, typename... terms>
+struct selector_terms<SelectorExpression<conjunction, by_cost, terms...>> {
+  using type = type_list<terms...>;
+};
+
+template <typename term_t> struct selector_terms<Not<term_t>> {
+  using type = type_list<term_t>;
+};
+
+/// Concatenate type lists
+template <typename... lists> struct concat { using type = type_list<>; };
+
+template <typename... types> struct concat<type_list<types...>> {
+  using type = type_list<types...>;
+};
+
+template <typename... as, typename... bs, typename... lists>
+struct concat<type_list<as...>, type_list<bs...>, lists...> {
+  using type = typename concat<type_list<as..., bs...>, lists...>::type;
+};
+
+/// Remove duplicated types, keeping the first occurence
+template <typename list, typename... types> struct unique {
+  using type = list;
+};
+
+template <typename... us, typename T, typename... types>
+struct unique<type_list<us...>, T, types...> {
+  using type = typename std::conditional_t<
+      (std::is_same_v<T, us> or ...), unique<type_list<us...>, types...>,
+      unique<type_list<us..., T>, types...>>::type;
+};
+
+/// All identity selectors within a selector, including itself
+template <typename T, typename = typename selector_terms<T>::type>
+struct identity_selectors;
+
+template <typename T, typename... terms>
+struct identity_selectors<T, type_list<terms...>> {
+  using type = typename concat<
+      std::conditional_t<is_identity_selector<T>::value, type_list<T>,
+                         type_list<>>,
+      typename identity_selectors<terms>::type...>::type;
+};
+
+/// The selectors of a process that are evaluated on the ingoing particle
+template <typename T, typename = void> struct process_selectors {
+  using type = type_list<>;
+};
+
+template <typename T>
+struct process_selectors<
+    T, std::void_t<typename T::SelectorIn, typename T::SelectorOut>> {
+  using type =
+      typename concat<typename identity_selectors<typename T::SelectorIn>::type,
+                      typename identity_selectors<
+                          typename T::SelectorOut>::type>::type;
+};
+
+template <typename list> struct unique_list;
+
+template <typename... types> struct unique_list<type_list<types...>> {
+  using type = typename unique<type_list<>, types...>::type;
+};
+
+template <typename... types> struct selector_cache_of;
+
+template <typename... types> struct selector_cache_of<type_list<types...>> {
+  using type = SelectorCache<types...>;
+};
+
+/// The cache shared by the processes of a physics list
+///
+/// The identity selectors used by several processes are evaluated once.
+template <typename... processes>
+using physics_list_cache_t = typename selector_cache_of<
+    typename unique_list<typename concat<
+        typename process_selectors<processes>::type...>::type>::type>::type;
+
+/// Check if a process can be called for a species and with a cache
+template <typename process_t, typename species_t, typename generator_t,
+          typename detector_t, typename particle_t, typename cache_t,
+          typename = void>
+struct has_species_apply : std::false_type {};
+
+template <typename process_t, typename species_t, typename generator_t,
+          typename detector_t, typename particle_t, typename cache_t>
+struct has_species_apply<
+    process_t, species_t, generator_t, detector_t, particle_t, cache_t,
+    std::void_t<decltype(std::declval<const process_t &>()
+                             .template apply<species_t>(
+                                 std::declval<generator_t &>(),
+                                 std::declval<const detector_t &>(),
+                                 std::declval<particle_t &>(),
+                                 std::declval<std::vector<particle_t> &>(),
+                                 std::declval<cache_t &>()))>>
+    : std::true_type {};
+
+/// Call a process of a physics list
+///
+/// Processes that support it are called with the compile-time species and
+/// the shared selector cache, all others through their call operator.
+template <typename species_t, typename process_t, typename generator_t,
+          typename detector_t, typename particle_t, typename cache_t>
+bool apply_process(const process_t &process, generator_t &gen,
+                   const detector_t &det, particle_t &in,
+                   std::vector<particle_t> &out, cache_t &cache) {
+  if constexpr (has_species_apply<process_t, species_t, generator_t,
+                                  detector_t, particle_t, cache_t>::value) {
+    return process.template apply<species_t>(gen, det, in, out, cache);
+  } else {
+    bool kill = process(gen, det, in, out);
+    // the process may have changed the particle
+    cache.invalidate();
+    return kill;
+  }
+}
+
+} // namespace detail
+
+} // namespace Fatras
@@ -0,0 +1,151 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
+#include "Fatras/Physics/Decay/DecayTable.hpp"
+#include <cmath>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief The decay of unstable particles in flight
+///
+/// The proper decay time is sampled once when the particle enters the
+/// simulation from the tabulated lifetime of its species, it is then
+/// stored as a limit on the particle. Along the propagation only the
+/// accumulated proper time is compared to this limit, the decay kinematics
+/// are generated once the limit is passed.
+///
+/// Only two-body decays are tabulated, daughters are emitted isotropically
+/// in the rest frame of the decaying particle.
+struct Decay {
+
+  /// The flag to include decays or not
+  bool decay = true;
+
+  /// Sample the proper time limit of the particle
+  ///
+  /// @tparam generator_t is a random number generator type
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param[in] generator is the random number generator
+  /// @param[in,out] particle is the particle to which the limit is set
+  template <typename generator_t, typename particle_t>
+  void initialize(generator_t &generator, particle_t &particle) const {
+    // Do nothing if the flag is set to false
+    if (not decay) {
+      return;
+    }
+    const DecaySpecies *species = findDecaySpecies(particle.pdg());
+    if (species == nullptr or not species->decays()) {
+      return;
+    }
+    ExponentialDist lifetimeDist(1. / species->lifetime);
+    particle.setProperTimeLimit(particle.properTime() +
+                                lifetimeDist(generator));
+  }
+
+  /// @brief Call operator for the decay
+  ///
+  /// This is called on every step and only compares the proper time of the
+  /// particle with its limit, the decay is only performed beyond.
+  ///
+  /// @tparam generator_t is a random number generator type
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param[in] generator is the random number generator
+  /// @param[in] particle is the particle that is checked for the decay
+  ///
+  /// @return the daughters if the particle decayed, empty otherwise
+  template <typename generator_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &generator,
+                                     const particle_t &particle) const {
+    // this is the cheap check performed on every step
+    if (not decay or particle.properTime() < particle.properTimeLimit()) {
+      return {};
+    }
+    const DecaySpecies *species = findDecaySpecies(particle.pdg());
+    if (species == nullptr or not species->decays()) {
+      return {};
+    }
+    // pick the decay channel
+    UniformDist uniformDist(0., 1.);
+    double u = uniformDist(generator);
+    const DecayChannel *channel = species->channelsBegin;
+    while (channel + 1 != species->channelsEnd and u > channel->cumulative) {
+      ++channel;
+    }
+    // the daughter species, conjugated for antiparticles
+    bool conjugate = (particle.pdg() < 0);
+    int pdg1 = conjugate ? chargeConjugate(channel->daughters[0])
+                         : channel->daughters[0];
+    int pdg2 = conjugate ? chargeConjugate(channel->daughters[1])
+                         : channel->daughters[1];
+    const DecaySpecies *daughter1 = findDecaySpecies(pdg1);
+    const DecaySpecies *daughter2 = findDecaySpecies(pdg2);
+    if (daughter1 == nullptr or daughter2 == nullptr) {
+      return {};
+    }
+    // the tabulated charge is the one of the particle
+    double q1 = (pdg1 < 0) ? -daughter1->charge : daughter1->charge;
+    double q2 = (pdg2 < 0) ? -daughter2->charge : daughter2->charge;
+
+    // the limit is passed within the last step, move back to the decay point
+    double m = particle.m();
+    double p = particle.p();
+    Acts::Vector3D direction = particle.momentum().normalized();
+    double overshoot =
+        (particle.properTime() - particle.properTimeLimit()) * p / m;
+    Acts::Vector3D vertex =
+        particle.position() - overshoot * Acts::units::_c * direction;
+    double time = particle.time() - overshoot * particle.E() / p;
+
+    // two-body momentum in the rest frame
+    double m1 = daughter1->mass;
+    double m2 = daughter2->mass;
+    double pStar = std::sqrt((m * m - (m1 + m2) * (m1 + m2)) *
+                             (m * m - (m1 - m2) * (m1 - m2))) /
+                   (2. * m);
+    // isotropic emission in the rest frame
+    double cosTheta = 2. * uniformDist(generator) - 1.;
+    double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+    double phi = 2. * M_PI * uniformDist(generator);
+    Acts::Vector3D restMomentum(pStar * sinTheta * std::cos(phi),
+                                pStar * sinTheta * std::sin(phi),
+                                pStar * cosTheta);
+    // boost both daughters into the lab frame
+    Acts::Vector3D beta = particle.momentum() / particle.E();
+    double gamma = particle.E() / m;
+    double beta2 = beta.squaredNorm();
+    auto boost = [&](const Acts::Vector3D &restP, double restE) {
+      // no boost needed for a decay at rest
+      if (beta2 == 0.) {
+        return restP;
+      }
+      double betaP = beta.dot(restP);
+      return Acts::Vector3D(
+          restP + ((gamma - 1.) * betaP / beta2 + gamma * restE) * beta);
+    };
+    double e1 = std::sqrt(pStar * pStar + m1 * m1);
+    double e2 = std::sqrt(pStar * pStar + m2 * m2);
+
+    std::vector<particle_t> daughters;
+    daughters.reserve(2);
+    daughters.emplace_back(vertex, boost(restMomentum, e1), m1, q1, pdg1, 0,
+                           time);
+    daughters.emplace_back(vertex, boost(-restMomentum, e2), m2, q2, pdg2, 0,
+                           time);
+    return daughters;
+  }
+};
+
+} // namespace Fatras
@@ -0,0 +1,61 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+namespace Fatras {
+
+/// A tabulated two-body decay channel
+///
+/// Channels are given for the particle, i.e. the positive pdg code,
+/// the antiparticle channels follow by charge conjugation.
+struct DecayChannel {
+  /// Cumulative branching ratio, normalised to the tabulated channels
+  double cumulative;
+  /// The pdg codes of the two daughters
+  int daughters[2];
+};
+
+/// A tabulated particle species
+struct DecaySpecies {
+  /// The pdg code of the particle (always > 0)
+  int pdg;
+  /// The rest mass
+  double mass;
+  /// The charge of the particle
+  double charge;
+  /// The mean proper lifetime, infinity if stable
+  double lifetime;
+  /// The particle is its own antiparticle
+  bool selfConjugate;
+  /// The tabulated decay channels [begin, end)
+  const DecayChannel *channelsBegin = nullptr;
+  const DecayChannel *channelsEnd = nullptr;
+
+  /// Check if the species has any decay channel
+  bool decays() const { return channelsBegin != channelsEnd; }
+};
+
+/// Find the tabulated species for a pdg code
+///
+/// Particles and antiparticles share the same entry, the caller is
+/// responsible for the charge conjugation of charge and daughters.
+///
+/// @param pdg is the (signed) pdg code
+///
+/// @return the species entry or nullptr if it is not tabulated
+const DecaySpecies *findDecaySpecies(int pdg);
+
+/// Charge conjugate a pdg code
+///
+/// @param pdg is the pdg code to be conjugated
+///
+/// @return the pdg code of the antiparticle
+int chargeConjugate(int pdg);
+
+} // namespace Fatras
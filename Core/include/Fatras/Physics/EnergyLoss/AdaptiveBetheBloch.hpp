@@ -0,0 +1,140 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Material/Interactions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Bethe-Bloch energy loss switching by momentum and material regime
+///
+/// As the BetheBloch process, the full Landau distribution is sampled
+/// below a momentum and in thin layers, where its tail matters. Elsewhere
+/// a Gaussian with the most probable value and the full width at half
+/// maximum of the Landau distribution is sampled, which is cheaper and
+/// leaves out the rare large losses. If the most probable loss relative
+/// to the energy is below the resolution, no energy loss is applied.
+///
+/// The thresholds are tunable, see the AdaptivePhysics tests for their
+/// validation against the BetheBloch process.
+///
+/// @tparam scalar_t is the scalar type used for the sampling
+/// @tparam species_t is the particle species, if known at compile time
+template <typename scalar_t, typename species_t = species::Any>
+struct BasicAdaptiveBetheBloch {
+
+  /// The scalar type of the sampled energy loss
+  using Scalar = scalar_t;
+
+  /// The sampling regimes
+  enum class Regime { Skip, Fast, Accurate };
+
+  /// The flag to include BetheBloch process or not
+  bool betheBloch = true;
+
+  /// Scaling for most probable value
+  scalar_t scaleFactorMPV = 1.;
+
+  /// Scaling for Sigma
+  scalar_t scaleFactorSigma = 1.;
+
+  /// Below this momentum the Landau distribution is sampled
+  double pAccurate = 10. * Acts::units::_GeV;
+
+  /// Below this thickness in X0 the Landau distribution is sampled
+  double thinLimit = 0.;
+
+  /// Below this relative loss no energy loss is applied, 0 never skips
+  double resolution = 0.;
+
+  /// The Gaussian width in units of sigma, the Landau FWHM over 2.3548
+  scalar_t gaussianWidth = 1.7063;
+
+  /// The most probable value of the Landau(0, 1) distribution
+  scalar_t landauMode = -0.22278;
+
+  /// @brief The regime of a particle in the detector
+  ///
+  /// @param[in] detector the detector information
+  /// @param[in] particle the particle which is losing energy
+  /// @param[in] mpv the most probable energy loss
+  template <typename detector_t, typename particle_t>
+  Regime regime(const detector_t &detector, const particle_t &particle,
+                double mpv) const {
+    if (resolution > 0. and scaleFactorMPV * mpv < resolution * particle.E()) {
+      return Regime::Skip;
+    }
+    if (particle.p() < pAccurate or detector.thicknessInX0() < thinLimit) {
+      return Regime::Accurate;
+    }
+    return Regime::Fast;
+  }
+
+  /// @brief Call operator for the adaptive Bethe Bloch energy loss
+  ///
+  /// @tparam generator_t is a random number generator type
+  /// @tparam detector_t is the detector information type
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param[in] generator is the random number generator
+  /// @param[in] detector the detector information
+  /// @param[in] particle the particle which is losing energy
+  ///
+  /// @return empty vector - no secondaries created
+  template <typename generator_t, typename detector_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &generator,
+                                     const detector_t &detector,
+                                     particle_t &particle) const {
+
+    // Do nothing if the flag is set to false
+    if (not betheBloch) {
+      return {};
+    }
+
+    double qop = particle.q() / particle.p();
+    scalar_t energyLoss = std::abs(Acts::computeEnergyLossLandau(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop,
+        particle.q()));
+    Regime sampling = regime(detector, particle, energyLoss);
+    if (sampling == Regime::Skip) {
+      return {};
+    }
+    scalar_t energyLossSigma = Acts::computeEnergyLossLandauSigma(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop,
+        particle.q());
+
+    // the Landau or the Gaussian variate in units of sigma
+    scalar_t variate = 0.;
+    if (sampling == Regime::Accurate) {
+      BasicLandauDist<scalar_t> landauDist(0., 1.);
+      variate = landauDist(generator);
+    } else {
+      BasicGaussDist<scalar_t> gaussDist(0., 1.);
+      variate = landauMode + gaussianWidth * gaussDist(generator);
+    }
+    scalar_t sampledEnergyLoss = scaleFactorMPV * energyLoss +
+                                 scaleFactorSigma * energyLossSigma * variate;
+
+    // the Gaussian tail must not accelerate
+    particle.energyLoss(std::max(sampledEnergyLoss, scalar_t(0)));
+
+    // return empty children
+    return {};
+  }
+};
+
+using AdaptiveBetheBloch = BasicAdaptiveBetheBloch<double>;
+
+} // namespace Fatras
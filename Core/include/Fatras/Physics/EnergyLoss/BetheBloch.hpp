@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Acts/Material/Interactions.hpp"
+#include "Fatras/Kernel/Species.hpp"
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
 
 namespace Fatras {
@@ -22,16 +23,23 @@ namespace Fatras {
 /// that could return radiated photons for further processing,
 /// however, for the Bethe-Bloch application the return vector
 /// is always 0.
-struct BetheBloch {
+///
+/// @tparam scalar_t is the scalar type used for the sampling
+/// @tparam species_t is the particle species, if known at compile time
+template <typename scalar_t, typename species_t = species::Any>
+struct BasicBetheBloch {
+
+  /// The scalar type of the sampled energy loss
+  using Scalar = scalar_t;
 
   /// The flag to include BetheBloch process or not
   bool betheBloch = true;
 
   /// Scaling for most probable value
-  double scaleFactorMPV = 1.;
+  scalar_t scaleFactorMPV = 1.;
 
   /// Scaling for Sigma
-  double scaleFactorSigma = 1.;
+  scalar_t scaleFactorSigma = 1.;
 
   /// @brief Call operator for the Bethe Bloch energy loss
   ///
@@ -55,19 +63,21 @@ struct BetheBloch {
     }
 
     // Create a random landau distribution between in the intervall [0,1]
-    LandauDist landauDist = LandauDist(0., 1.);
-    double landau = landauDist(generator);
+    BasicLandauDist<scalar_t> landauDist(0., 1.);
+    scalar_t landau = landauDist(generator);
     double qop = particle.q() / particle.p();
 
     // @TODO Double investigate if we could do one call
-    double energyLoss = Acts::computeEnergyLossLandau(
-        detector, particle.pdg(), particle.m(), qop, particle.q());
-    double energyLossSigma = Acts::computeEnergyLossLandauSigma(
-        detector, particle.pdg(), particle.m(), qop, particle.q());
+    scalar_t energyLoss = Acts::computeEnergyLossLandau(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop,
+        particle.q());
+    scalar_t energyLossSigma = Acts::computeEnergyLossLandauSigma(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop,
+        particle.q());
 
     // Simulate the energy loss
-    double sampledEnergyLoss = scaleFactorMPV * std::fabs(energyLoss) +
-                               scaleFactorSigma * energyLossSigma * landau;
+    scalar_t sampledEnergyLoss = scaleFactorMPV * std::abs(energyLoss) +
+                                 scaleFactorSigma * energyLossSigma * landau;
 
     // Apply the energy loss
     particle.energyLoss(sampledEnergyLoss);
@@ -77,4 +87,6 @@ struct BetheBloch {
   }
 };
 
+using BetheBloch = BasicBetheBloch<double>;
+
 } // namespace Fatras
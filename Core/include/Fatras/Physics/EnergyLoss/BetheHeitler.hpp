@@ -20,13 +20,17 @@ const double log_2 = std::log(2.);
 /// "A Gaussian-mixture approximation of the Bethe–Heitler model of electron
 /// energy loss by bremsstrahlung" R. Frühwirth
 ///
-struct BetheHeitler {
+/// @tparam scalar_t is the scalar type used for the sampling
+template <typename scalar_t> struct BasicBetheHeitler {
+
+  /// The scalar type of the sampled energy loss
+  using Scalar = scalar_t;
 
   /// The flag to include BetheHeitler process or not
   bool betheHeitler = true;
 
   /// A scaling factor to
-  double scaleFactor = 1.;
+  scalar_t scaleFactor = 1.;
 
   /// @brief Call operator for the Bethe-Heitler energy loss
   ///
@@ -49,14 +53,17 @@ struct BetheHeitler {
       return {};
     }
 
-    double tInX0 = detector.thickness() / detector.material().X0();
+    scalar_t tInX0 = detector.thickness() / detector.material().X0();
 
     // Take a random gamma-distributed value - depending on t/X0
-    GammaDist gDist = GammaDist(tInX0 / log_2, 1.);
+    BasicGammaDist<scalar_t> gDist(tInX0 / scalar_t(log_2), 1.);
 
-    double u = gDist(generator);
-    double z = std::exp(-1. * u);
-    double sampledEnergyLoss = std::abs(scaleFactor * particle.E() * (z - 1.));
+    // the fraction z = exp(-u) is close to one for thin layers,
+    // z - 1 is evaluated directly to keep the precision
+    scalar_t u = gDist(generator);
+    scalar_t zMinusOne = std::expm1(-u);
+    scalar_t E = particle.E();
+    scalar_t sampledEnergyLoss = std::abs(scaleFactor * E * zMinusOne);
 
     // apply the energy loss
     particle.energyLoss(sampledEnergyLoss);
@@ -66,4 +73,6 @@ struct BetheHeitler {
   }
 };
 
+using BetheHeitler = BasicBetheHeitler<double>;
+
 } // namespace Fatras
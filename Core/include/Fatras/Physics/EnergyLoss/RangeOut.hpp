@@ -0,0 +1,175 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <tuple>
+#include <vector>
+
+namespace Fatras {
+
+/// @brief Continuous-slowing-down (CSDA) range table
+///
+/// The residual range of a particle with kinetic energy T is the path
+/// R(T) = int_0^T dT' / S(T') along which the mean stopping power S takes
+/// all of its energy. S is the Bethe formula without density effect and
+/// shell corrections, with the mean excitation energy 16 eV Z^0.9; both
+/// are small corrections at the energies where the range matters. For
+/// electrons the heavy particle formula is an approximation as well.
+///
+/// The range is tabulated at logarithmically spaced kinetic energies and
+/// interpolated linearly in between.
+class RangeTable {
+public:
+  struct Config {
+    /// The tabulated kinetic energies
+    double minEnergy = 1. * Acts::units::_keV;
+    double maxEnergy = 10. * Acts::units::_GeV;
+    std::size_t nBins = 256;
+  };
+
+  /// @brief Build the table
+  ///
+  /// @param material is the material the particle slows down in
+  /// @param mass is the particle mass
+  /// @param charge is the particle charge
+  /// @param cfg is the tabulation
+  RangeTable(const Acts::Material &material, double mass, double charge,
+             const Config &cfg);
+
+  /// The mean stopping power, i.e. the energy loss per path length
+  static double stoppingPower(const Acts::Material &material, double mass,
+                              double charge, double kineticEnergy);
+
+  /// The residual range of a kinetic energy
+  double range(double kineticEnergy) const;
+
+private:
+  double m_logMin = 0.;
+  double m_logStep = 0.;
+  /// The stopping power beyond the last bin
+  double m_lastStoppingPower = 0.;
+  std::vector<double> m_ranges;
+};
+
+/// @brief Terminate particles that cannot get much further
+///
+/// Slow charged particles lose their energy surface after surface and
+/// keep stepping until they fall to rest. The Interactor asks the range
+/// out after the physics list: if the residual range of a particle in the
+/// current material is below the cut, the particle is stopped at once and
+/// its kinetic energy is deposited. The remaining kinetic energy is booked
+/// on the hit of the current surface, if that one is sensitive, although
+/// the particle would have deposited part of it further along its path.
+///
+/// Only a constant range cut is provided: the range is not compared with
+/// the distance to the next sensitive surface, which the Interactor does
+/// not know when it is called on a surface. The cut is 0 by default, such
+/// that the range out is off until a cut is configured; it should stay
+/// below the smallest gap between sensitive layers.
+///
+/// Optionally the slab thickness is used as a cut as well. The slab is
+/// only a proxy for the distance to the next sensitive surface, which can
+/// be much larger, such that this stops particles that would still have
+/// left a hit; it is thus off by default.
+///
+/// The range tables are built on first use per material and species and
+/// shared between threads, as are the counters.
+class RangeOut {
+public:
+  struct Config {
+    /// Particles with a shorter residual range are terminated
+    double cut = 0.;
+    /// Also terminate particles that cannot cross the current slab
+    bool slabRange = false;
+    /// Faster particles are not checked
+    double maxEnergy = 100. * Acts::units::_MeV;
+    /// The tabulation of the range tables
+    RangeTable::Config table;
+  };
+
+  struct Counters {
+    std::uint64_t checked = 0;
+    std::uint64_t rangedOut = 0;
+    double depositedEnergy = 0.;
+  };
+
+  RangeOut() = default;
+  explicit RangeOut(const Config &cfg) : m_cfg(cfg) {}
+
+  /// The range table of a material and species
+  const RangeTable &table(const Acts::Material &material, int pdg,
+                          double mass, double charge);
+
+  /// @brief Terminate the particle if it is ranged out
+  ///
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param slab is the material the particle is in
+  /// @param particle is the particle, it is brought to rest if ranged out
+  ///
+  /// @return the deposited energy, 0 if the particle continues; it is
+  ///         booked on the current surface
+  template <typename particle_t>
+  double operator()(const Acts::MaterialProperties &slab,
+                    particle_t &particle) {
+    if (particle.q() == 0. or not particle) {
+      return 0.;
+    }
+    const double kineticEnergy = particle.E() - particle.m();
+    if (kineticEnergy > m_cfg.maxEnergy) {
+      return 0.;
+    }
+    ++m_checked;
+    double residual =
+        table(slab.material(), particle.pdg(), particle.m(), particle.q())
+            .range(kineticEnergy);
+    double limit = m_cfg.cut;
+    if (m_cfg.slabRange) {
+      limit = std::max(limit, double(slab.thickness()));
+    }
+    if (not(residual < limit)) {
+      return 0.;
+    }
+    particle.energyLoss(particle.E());
+    ++m_rangedOut;
+    double deposited = m_deposited.load();
+    while (not m_deposited.compare_exchange_weak(deposited,
+                                                 deposited + kineticEnergy)) {
+    }
+    return kineticEnergy;
+  }
+
+  /// A snapshot of the counters
+  Counters counters() const;
+
+  const Config &config() const { return m_cfg; }
+
+private:
+  /// Material parameters and the absolute pdg code
+  using Key = std::tuple<double, double, double, double, double, int>;
+
+  Config m_cfg;
+  std::map<Key, std::unique_ptr<const RangeTable>> m_tables;
+  std::shared_mutex m_mutex;
+  std::atomic<std::uint64_t> m_checked{0};
+  std::atomic<std::uint64_t> m_rangedOut{0};
+  std::atomic<double> m_deposited{0.};
+};
+
+} // namespace Fatras
@@ -0,0 +1,127 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Material/Interactions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/detail/scalar_type.hpp"
+#include "Fatras/Physics/Scattering/GeneralMixture.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include <cmath>
+#include <type_traits>
+
+namespace Fatras {
+
+/// @brief Scattering formula switching by momentum and material regime
+///
+/// The accurate formula is used where the shape of the angular
+/// distribution matters: below a momentum and in thin layers, where the
+/// scattering is dominated by few single scatters. The latter is the case
+/// below the single scattering limit of the general mixture,
+///
+///   t / (X0 beta^2) < thinScale * 0.6 / Z^0.6.
+///
+/// Elsewhere the fast formula is sampled. If the Highland width is below
+/// the resolution, i.e. above a momentum that scales with the square root
+/// of the thickness, the scattering is skipped and the angle is 0.
+///
+/// It is used as the formula of the Scattering process, e.g.
+///
+///   Scattering<AdaptiveAngle<GeneralMixture, Highland>>
+///
+/// The thresholds are tunable: they should be chosen such that the
+/// distributions after the detector agree with the accurate formula within
+/// the resolution, see the AdaptivePhysics tests.
+///
+/// @tparam accurate_t is the accurate scattering formula
+/// @tparam fast_t is the fast scattering formula
+/// @tparam species_t is the particle species, if known at compile time
+template <typename accurate_t = GeneralMixture, typename fast_t = Highland,
+          typename species_t = species::Any>
+struct AdaptiveAngle {
+
+  /// The scalar type of the sampled angle
+  using Scalar = std::common_type_t<detail::scalar_type_t<accurate_t>,
+                                    detail::scalar_type_t<fast_t>>;
+
+  /// The formula regimes
+  enum class Regime { Skip, Fast, Accurate };
+
+  /// The accurate formula
+  accurate_t accurate;
+
+  /// The fast formula
+  fast_t fast;
+
+  /// Below this momentum the accurate formula is used
+  double pAccurate = 1. * Acts::units::_GeV;
+
+  /// Scale of the thin layer limit, 0 switches it off
+  double thinScale = 1.;
+
+  /// Below this width no scattering is applied, 0 never skips
+  double resolution = 0.;
+
+  /// @brief The regime of a particle in the detector
+  ///
+  /// @tparam detector_t is the detector information type
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param[in] detector the detector information
+  /// @param[in] particle the particle which is being scattered
+  template <typename detector_t, typename particle_t>
+  Regime regime(const detector_t &detector, const particle_t &particle) const {
+    if (resolution > 0.) {
+      double qop = particle.q() / particle.p();
+      double theta0 = Acts::computeMultipleScatteringTheta0(
+          detector, species::physicsPdg<species_t>(particle), particle.m(),
+          qop, particle.q());
+      if (theta0 < resolution) {
+        return Regime::Skip;
+      }
+    }
+    if (particle.p() < pAccurate) {
+      return Regime::Accurate;
+    }
+    double beta = particle.beta();
+    double tob2 =
+        detector.thickness() / detector.material().X0() / (beta * beta);
+    if (tob2 < thinScale * 0.6 / std::pow(detector.material().Z(), 0.6)) {
+      return Regime::Accurate;
+    }
+    return Regime::Fast;
+  }
+
+  /// @brief Call operator to perform this scattering
+  ///
+  /// @tparam generator_t is a random number generator type
+  /// @tparam detector_t is the detector information type
+  /// @tparam particle_t is the particle information type
+  ///
+  /// @param[in] generator is the random number generator
+  /// @param[in] detector the detector information
+  /// @param[in] particle the particle which is being scattered
+  ///
+  /// @return a scattering angle in 3D
+  template <typename generator_t, typename detector_t, typename particle_t>
+  Scalar operator()(generator_t &generator, const detector_t &detector,
+                    particle_t &particle) const {
+    switch (regime(detector, particle)) {
+    case Regime::Skip:
+      return Scalar(0);
+    case Regime::Fast:
+      return fast(generator, detector, particle);
+    default:
+      return accurate(generator, detector, particle);
+    }
+  }
+};
+
+} // namespace Fatras
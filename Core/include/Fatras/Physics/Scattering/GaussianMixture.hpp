@@ -9,26 +9,34 @@
 #pragma once
 
 #include "Acts/Material/Interactions.hpp"
+#include "Fatras/Kernel/Species.hpp"
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
 
 namespace Fatras {
 
 /// @brief The struct to be provided to the Scatterer action
 /// This is the gaussian mixture
-struct GaussianMixture {
+///
+/// @tparam scalar_t is the scalar type used for the sampling
+/// @tparam species_t is the particle species, if known at compile time
+template <typename scalar_t, typename species_t = species::Any>
+struct BasicGaussianMixture {
+
+  /// The scalar type of the sampled angle
+  using Scalar = scalar_t;
 
   /// Steering parameter
   bool log_include = true;
 
-  double gausMixSigma1_a0 = 8.471e-1;
-  double gausMixSigma1_a1 = 3.347e-2;
-  double gausMixSigma1_a2 = -1.843e-3;
-  double gausMixEpsilon_a0 = 4.841e-2;
-  double gausMixEpsilon_a1 = 6.348e-3;
-  double gausMixEpsilon_a2 = 6.096e-4;
-  double gausMixEpsilon_b0 = -1.908e-2;
-  double gausMixEpsilon_b1 = 1.106e-1;
-  double gausMixEpsilon_b2 = -5.729e-3;
+  scalar_t gausMixSigma1_a0 = 8.471e-1;
+  scalar_t gausMixSigma1_a1 = 3.347e-2;
+  scalar_t gausMixSigma1_a2 = -1.843e-3;
+  scalar_t gausMixEpsilon_a0 = 4.841e-2;
+  scalar_t gausMixEpsilon_a1 = 6.348e-3;
+  scalar_t gausMixEpsilon_a2 = 6.096e-4;
+  scalar_t gausMixEpsilon_b0 = -1.908e-2;
+  scalar_t gausMixEpsilon_b1 = 1.106e-1;
+  scalar_t gausMixEpsilon_b2 = -5.729e-3;
 
   bool optGaussianMixtureG4 = false;
 
@@ -44,57 +52,59 @@ struct GaussianMixture {
   ///
   /// @return a scattering angle in 3D
   template <typename generator_t, typename detector_t, typename particle_t>
-  double operator()(generator_t &generator, const detector_t &detector,
-                    particle_t &particle) const {
-
-    // thickness in X0
-    double dInX0 = detector.thickness() / detector.material().X0();
+  scalar_t operator()(generator_t &generator, const detector_t &detector,
+                      particle_t &particle) const {
 
     /// Calculate the highland formula first
     double qop = particle.q() / particle.p();
-    double sigma = Acts::computeMultipleScatteringTheta0(
-        detector, particle.pdg(), particle.m(), qop);
+    scalar_t sigma = Acts::computeMultipleScatteringTheta0(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop);
 
-    double sigma2 = sigma * sigma;
+    scalar_t sigma2 = sigma * sigma;
 
     // Gauss distribution, will be sampled with generator
-    GaussDist gaussDist = GaussDist(0., 1.);
+    BasicGaussDist<scalar_t> gaussDist(0., 1.);
 
     // Uniform distribution, will be sampled with generator
-    UniformDist uniformDist = UniformDist(0., 1.);
+    BasicUniformDist<scalar_t> uniformDist(0., 1.);
 
     // Now correct for the tail fraction
     // d_0'
-    double beta2 = particle.beta() * particle.beta();
-    double dprime = detector.thickness() / (detector.material().X0() * beta2);
-    double log_dprime = std::log(dprime);
+    scalar_t beta = particle.beta();
+    scalar_t beta2 = beta * beta;
+    scalar_t dprime = detector.thickness() / (detector.material().X0() * beta2);
+    scalar_t log_dprime = std::log(dprime);
     // d_0''
-    double log_dprimeprime =
-        std::log(std::pow(detector.material().Z(), 2.0 / 3.0) * dprime);
+    scalar_t log_dprimeprime = std::log(
+        std::pow(scalar_t(detector.material().Z()), scalar_t(2. / 3.)) *
+        dprime);
 
     // get epsilon
-    double epsilon =
-        log_dprimeprime < 0.5
+    scalar_t epsilon =
+        log_dprimeprime < scalar_t(0.5)
             ? gausMixEpsilon_a0 + gausMixEpsilon_a1 * log_dprimeprime +
                   gausMixEpsilon_a2 * log_dprimeprime * log_dprimeprime
             : gausMixEpsilon_b0 + gausMixEpsilon_b1 * log_dprimeprime +
                   gausMixEpsilon_b2 * log_dprimeprime * log_dprimeprime;
 
     // the standard sigma
-    double sigma1square = gausMixSigma1_a0 + gausMixSigma1_a1 * log_dprime +
-                          gausMixSigma1_a2 * log_dprime * log_dprime;
+    scalar_t sigma1square = gausMixSigma1_a0 + gausMixSigma1_a1 * log_dprime +
+                            gausMixSigma1_a2 * log_dprime * log_dprime;
 
     // G4 optimised / native double Gaussian model
     if (optGaussianMixtureG4) {
-      sigma2 = 225. * dprime / (particle.p() * particle.p());
+      scalar_t p = particle.p();
+      sigma2 = scalar_t(225.) * dprime / (p * p);
     }
     // throw the random number core/tail
     if (uniformDist(generator) < epsilon) {
-      sigma2 *= (1. - (1. - epsilon) * sigma1square) / epsilon;
+      sigma2 *= (1 - (1 - epsilon) * sigma1square) / epsilon;
     }
     // return back to the
-    return M_SQRT2 * std::sqrt(sigma2) * gaussDist(generator);
+    return scalar_t(M_SQRT2) * std::sqrt(sigma2) * gaussDist(generator);
   }
 };
 
+using GaussianMixture = BasicGaussianMixture<double>;
+
 } // namespace Fatras
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Acts/Material/Interactions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Species.hpp"
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
 
 namespace Fatras {
@@ -17,13 +19,20 @@ namespace Fatras {
 ///
 /// General mixture model Fruehwirth, M. Liendl.
 /// Comp. Phys. Comm. 141 (2001) 230-246
-struct GeneralMixture {
+///
+/// @tparam scalar_t is the scalar type used for the sampling
+/// @tparam species_t is the particle species, if known at compile time
+template <typename scalar_t, typename species_t = species::Any>
+struct BasicGeneralMixture {
+
+  /// The scalar type of the sampled angle
+  using Scalar = scalar_t;
 
   /// Steering parameter
   bool log_include = true;
 
   //- Scale the mixture level
-  double genMixtureScalor = 1.;
+  scalar_t genMixtureScalor = 1.;
 
   /// @brief Call operator to perform this scattering
   ///
@@ -37,22 +46,22 @@ struct GeneralMixture {
   ///
   /// @return a scattering angle in 3D
   template <typename generator_t, typename detector_t, typename particle_t>
-  double operator()(generator_t &generator, const detector_t &detector,
-                    particle_t &particle) const {
+  scalar_t operator()(generator_t &generator, const detector_t &detector,
+                      particle_t &particle) const {
 
     // scale the path length to the radiation length
     // @todo path correction factor
-    double tInX0 = detector.thickness() / detector.material().X0();
+    scalar_t tInX0 = detector.thickness() / detector.material().X0();
 
     // material properties
-    double Z = detector.material().Z(); // charge layer material
+    scalar_t Z = detector.material().Z(); // charge layer material
 
-    double theta(0.);
+    scalar_t theta(0.);
 
-    if (std::abs(particle.pdg()) != 11) {
+    if (not species::isElectron<species_t>(particle)) {
 
       /// Uniform distribution, will be sampled with generator
-      UniformDist uniformDist = UniformDist(0., 1.);
+      BasicUniformDist<scalar_t> uniformDist(0., 1.);
 
       //----------------------------------------------------------------------------
       // see Mixture models of multiple scattering: computation and simulation.
@@ -60,97 +69,105 @@ struct GeneralMixture {
       // R.Fruehwirth, M. Liendl. -
       // Computer Physics Communications 141 (2001) 230â246
       //----------------------------------------------------------------------------
-      std::array<double, 4> scattering_params;
+      std::array<scalar_t, 4> scattering_params;
       // Decide which mixture is best
-      double beta2 = (particle.beta() * particle.beta());
-      double tob2 = tInX0 / beta2;
-      if (tob2 > 0.6 / std::pow(Z, 0.6)) {
+      scalar_t beta = particle.beta();
+      // the parametrisations take the momentum in MeV
+      scalar_t p = particle.p() / Acts::units::_MeV;
+      scalar_t beta2 = beta * beta;
+      scalar_t tob2 = tInX0 / beta2;
+      if (tob2 > scalar_t(0.6) / std::pow(Z, scalar_t(0.6))) {
         // Gaussian mixture or pure Gaussian
         if (tob2 > 10) {
-          scattering_params = getGaussian(particle.beta(), particle.p(), tInX0,
-                                          genMixtureScalor);
+          scattering_params = getGaussian(beta, p, tInX0, genMixtureScalor);
         } else {
-          scattering_params =
-              getGaussmix(particle.beta(), particle.p(), tInX0,
-                          detector.material().Z(), genMixtureScalor);
+          scattering_params = getGaussmix(beta, p, tInX0, Z, genMixtureScalor);
         }
         // Simulate
         theta = gaussmix(uniformDist, generator, scattering_params);
       } else {
         // Semigaussian mixture - get parameters
         auto scattering_params_sg =
-            getSemigauss(particle.beta(), particle.p(), tInX0,
-                         detector.material().Z(), genMixtureScalor);
+            getSemigauss(beta, p, tInX0, Z, genMixtureScalor);
         // Simulate
         theta = semigauss(uniformDist, generator, scattering_params_sg);
       }
     } else {
 
       /// Gauss distribution, will be sampled with generator
-      GaussDist gaussDist = GaussDist(0., 1.);
+      BasicGaussDist<scalar_t> gaussDist(0., 1.);
 
       // for electrons we fall back to the Highland (extension)
       // return projection factor times sigma times gauss random
       double qop = particle.q() / particle.p();
-      double theta = Acts::computeMultipleScatteringTheta0(
-          detector, particle.pdg(), particle.m(), qop);
+      scalar_t theta0 = Acts::computeMultipleScatteringTheta0(
+          detector, species::physicsPdg<species_t>(particle), particle.m(),
+          qop);
+      theta = theta0 * gaussDist(generator);
     }
     // return scaled by sqare root of two
-    return M_SQRT2 * theta;
+    return scalar_t(M_SQRT2) * theta;
   }
 
   // helper methods for getting parameters and simulating
 
-  std::array<double, 4> getGaussian(double beta, double p, double tInX0,
-                                    double scale) const {
-    std::array<double, 4> scattering_params;
+  std::array<scalar_t, 4> getGaussian(scalar_t beta, scalar_t p,
+                                      scalar_t tInX0, scalar_t scale) const {
+    std::array<scalar_t, 4> scattering_params;
     // Total standard deviation of mixture
-    scattering_params[0] = 15. / beta / p * std::sqrt(tInX0) * scale;
-    scattering_params[1] = 1.0; // Variance of core
-    scattering_params[2] = 1.0; // Variance of tails
-    scattering_params[3] = 0.5; // Mixture weight of tail component
+    scattering_params[0] = 15 / beta / p * std::sqrt(tInX0) * scale;
+    scattering_params[1] = 1; // Variance of core
+    scattering_params[2] = 1; // Variance of tails
+    scattering_params[3] = scalar_t(0.5); // Mixture weight of tail component
     return scattering_params;
   }
 
-  std::array<double, 4> getGaussmix(double beta, double p, double tInX0,
-                                    double Z, double scale) const {
-    std::array<double, 4> scattering_params;
-    scattering_params[0] = 15. / beta / p * std::sqrt(tInX0) *
+  std::array<scalar_t, 4> getGaussmix(scalar_t beta, scalar_t p,
+                                      scalar_t tInX0, scalar_t Z,
+                                      scalar_t scale) const {
+    using s = scalar_t;
+    std::array<scalar_t, 4> scattering_params;
+    scattering_params[0] = 15 / beta / p * std::sqrt(tInX0) *
                            scale; // Total standard deviation of mixture
-    double d1 = std::log(tInX0 / (beta * beta));
-    double d2 = std::log(std::pow(Z, 2.0 / 3.0) * tInX0 / (beta * beta));
-    double epsi;
-    double var1 = (-1.843e-3 * d1 + 3.347e-2) * d1 + 8.471e-1; // Variance of
-                                                               // core
-    if (d2 < 0.5)
-      epsi = (6.096e-4 * d2 + 6.348e-3) * d2 + 4.841e-2;
+    scalar_t d1 = std::log(tInX0 / (beta * beta));
+    scalar_t d2 = std::log(std::pow(Z, s(2. / 3.)) * tInX0 / (beta * beta));
+    scalar_t epsi;
+    scalar_t var1 =
+        (s(-1.843e-3) * d1 + s(3.347e-2)) * d1 + s(8.471e-1); // Variance of
+                                                              // core
+    if (d2 < s(0.5))
+      epsi = (s(6.096e-4) * d2 + s(6.348e-3)) * d2 + s(4.841e-2);
     else
-      epsi = (-5.729e-3 * d2 + 1.106e-1) * d2 - 1.908e-2;
+      epsi = (s(-5.729e-3) * d2 + s(1.106e-1)) * d2 - s(1.908e-2);
     scattering_params[1] = var1;                           // Variance of core
     scattering_params[2] = (1 - (1 - epsi) * var1) / epsi; // Variance of tails
     scattering_params[3] = epsi; // Mixture weight of tail component
     return scattering_params;
   }
 
-  std::array<double, 6> getSemigauss(double beta, double p, double tInX0,
-                                     double Z, double scale) const {
-    std::array<double, 6> scattering_params;
-    double N = tInX0 * 1.587E7 * std::pow(Z, 1.0 / 3.0) / (beta * beta) /
-               (Z + 1) / std::log(287 / std::sqrt(Z));
-    scattering_params[4] = 15. / beta / p * std::sqrt(tInX0) *
-                           scale; // Total standard deviation of mixture
-    double rho = 41000 / std::pow(Z, 2.0 / 3.0);
-    double b = rho / std::sqrt(N * (std::log(rho) - 0.5));
-    double n = std::pow(Z, 0.1) * std::log(N);
-    double var1 = (5.783E-4 * n + 3.803E-2) * n + 1.827E-1;
-    double a =
-        (((-4.590E-5 * n + 1.330E-3) * n - 1.355E-2) * n + 9.828E-2) * n +
-        2.822E-1;
-    double epsi = (1 - var1) / (a * a * (std::log(b / a) - 0.5) - var1);
+  std::array<scalar_t, 6> getSemigauss(scalar_t beta, scalar_t p,
+                                       scalar_t tInX0, scalar_t Z,
+                                       scalar_t scale) const {
+    using s = scalar_t;
+    std::array<scalar_t, 6> scattering_params;
+    scalar_t N = tInX0 * s(1.587E7) * std::pow(Z, s(1.0 / 3.0)) /
+                 (beta * beta) / (Z + 1) / std::log(287 / std::sqrt(Z));
+    scattering_params[4] =
+        15 / beta / p * std::sqrt(tInX0) * scale; // Total standard deviation
+                                                  // of mixture
+    scalar_t rho = 41000 / std::pow(Z, s(2.0 / 3.0));
+    scalar_t b = rho / std::sqrt(N * (std::log(rho) - s(0.5)));
+    scalar_t n = std::pow(Z, s(0.1)) * std::log(N);
+    scalar_t var1 = (s(5.783E-4) * n + s(3.803E-2)) * n + s(1.827E-1);
+    scalar_t a = (((s(-4.590E-5) * n + s(1.330E-3)) * n - s(1.355E-2)) * n +
+                  s(9.828E-2)) *
+                     n +
+                 s(2.822E-1);
+    scalar_t epsi = (1 - var1) / (a * a * (std::log(b / a) - s(0.5)) - var1);
     scattering_params[3] =
-        (epsi > 0) ? epsi : 0.0; // Mixture weight of tail component
-    scattering_params[0] = a;    // Parameter 1 of tails
-    scattering_params[1] = b;    // Parameter 2 of tails
+        (epsi > 0) ? epsi : 0; // Mixture weight of tail component
+    scattering_params[0] = a;  // Parameter 1 of tails
+    scattering_params[1] = b;  // Parameter 2 of tails
     scattering_params[2] = var1; // Variance of core
     scattering_params[5] = N;    // Average number of scattering processes
     return scattering_params;
@@ -163,16 +180,16 @@ struct GeneralMixture {
   /// @param udist The uniform distribution handed over by the call operator
   /// @param scattering_params the tuned parameters for the generation
   ///
-  /// @return a double value that represents the gaussian mixture
+  /// @return a scalar value that represents the gaussian mixture
   template <typename generator_t>
-  double gaussmix(UniformDist &udist, generator_t &generator,
-                  const std::array<double, 4> &scattering_params) const {
-    double sigma_tot = scattering_params[0];
-    double var1 = scattering_params[1];
-    double var2 = scattering_params[2];
-    double epsi = scattering_params[3];
+  scalar_t gaussmix(BasicUniformDist<scalar_t> &udist, generator_t &generator,
+                    const std::array<scalar_t, 4> &scattering_params) const {
+    scalar_t sigma_tot = scattering_params[0];
+    scalar_t var1 = scattering_params[1];
+    scalar_t var2 = scattering_params[2];
+    scalar_t epsi = scattering_params[3];
     bool ind = udist(generator) > epsi;
-    double u = udist(generator);
+    scalar_t u = udist(generator);
     if (ind)
       return std::sqrt(var1) * std::sqrt(-2 * std::log(u)) * sigma_tot;
     else
@@ -186,17 +203,17 @@ struct GeneralMixture {
   /// @param udist The uniform distribution handed over by the call operator
   /// @param scattering_params the tuned parameters for the generation
   ///
-  /// @return a double value that represents the gaussian mixture
+  /// @return a scalar value that represents the gaussian mixture
   template <typename generator_t>
-  double semigauss(UniformDist &udist, generator_t &generator,
-                   const std::array<double, 6> &scattering_params) const {
-    double a = scattering_params[0];
-    double b = scattering_params[1];
-    double var1 = scattering_params[2];
-    double epsi = scattering_params[3];
-    double sigma_tot = scattering_params[4];
+  scalar_t semigauss(BasicUniformDist<scalar_t> &udist, generator_t &generator,
+                     const std::array<scalar_t, 6> &scattering_params) const {
+    scalar_t a = scattering_params[0];
+    scalar_t b = scattering_params[1];
+    scalar_t var1 = scattering_params[2];
+    scalar_t epsi = scattering_params[3];
+    scalar_t sigma_tot = scattering_params[4];
     bool ind = udist(generator) > epsi;
-    double u = udist(generator);
+    scalar_t u = udist(generator);
     if (ind)
       return std::sqrt(var1) * std::sqrt(-2 * std::log(u)) * sigma_tot;
     else
@@ -204,4 +221,6 @@ struct GeneralMixture {
   }
 };
 
+using GeneralMixture = BasicGeneralMixture<double>;
+
 } // namespace Fatras
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Acts/Material/Interactions.hpp"
+#include "Fatras/Kernel/Species.hpp"
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
 
 namespace Fatras {
@@ -17,7 +18,14 @@ namespace Fatras {
 ///
 /// This will scatter particles with a single gaussian distribution
 /// according to the highland formula.
-struct Highland {
+///
+/// @tparam scalar_t is the scalar type used for the sampling
+/// @tparam species_t is the particle species, if known at compile time
+template <typename scalar_t, typename species_t = species::Any>
+struct BasicHighland {
+
+  /// The scalar type of the sampled angle
+  using Scalar = scalar_t;
 
   /// @brief Call operator to perform this scattering
   ///
@@ -31,18 +39,21 @@ struct Highland {
   ///
   /// @return a scattering angle in 3D
   template <typename generator_t, typename detector_t, typename particle_t>
-  double operator()(generator_t &generator, const detector_t &detector,
-                    particle_t &particle) const {
+  scalar_t operator()(generator_t &generator, const detector_t &detector,
+                      particle_t &particle) const {
 
     // Gauss distribution, will be sampled sampled with generator
-    GaussDist gaussDist = GaussDist(0., 1.);
+    BasicGaussDist<scalar_t> gaussDist(0., 1.);
 
     double qop = particle.q() / particle.p();
-    double theta0 = Acts::computeMultipleScatteringTheta0(
-        detector, particle.pdg(), particle.m(), qop, particle.q());
+    scalar_t theta0 = Acts::computeMultipleScatteringTheta0(
+        detector, species::physicsPdg<species_t>(particle), particle.m(), qop,
+        particle.q());
     // Return projection factor times sigma times grauss random
-    return M_SQRT2 * theta0 * gaussDist(generator);
+    return scalar_t(M_SQRT2) * theta0 * gaussDist(generator);
   }
 };
 
+using Highland = BasicHighland<double>;
+
 } // namespace Fatras
@@ -14,6 +14,7 @@
 #include "Acts/Utilities/Helpers.hpp"
 
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
+#include "Fatras/Kernel/detail/scalar_type.hpp"
 
 namespace Fatras {
 
@@ -26,14 +27,20 @@ namespace Fatras {
 /// There's two options to apply the scattering
 /// - a parametric action that relates phi and theta (default: off)
 /// - an actuall out of direction scattering applying two random numbers
+///
+/// The scalar type of the formula, if it defines one, is used throughout.
 template <typename formula_t> struct Scattering {
 
+  /// The scalar type of the formula
+  using Scalar = detail::scalar_type_t<formula_t>;
+  using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+
   /// The flag to include scattering or not
   bool scattering = true;
 
   /// Include the log term
   bool parametric = false;
-  double projectionFactor = 1. / std::sqrt(2.);
+  Scalar projectionFactor = 1. / std::sqrt(2.);
 
   /// The scattering formula
   formula_t angle;
@@ -49,69 +56,80 @@ template <typename formula_t> struct Scattering {
     }
 
     // 3D scattering angle
-    double angle3D = angle(gen, det, in);
+    Scalar angle3D = angle(gen, det, in);
+    // the formula may skip the scattering
+    if (angle3D == Scalar(0)) {
+      return {};
+    }
+    Vector3 momentum = in.momentum().template cast<Scalar>();
+    Scalar p = in.p();
 
     // parametric scattering
     if (parametric) {
 
       // the initial values
-      double theta = Acts::VectorHelpers::theta(in.momentum());
-      double phi = Acts::VectorHelpers::phi(in.momentum());
-      double sinTheta = (sin(theta) * sin(theta) > 10e-10) ? sin(theta) : 1.;
+      Scalar theta = Acts::VectorHelpers::theta(momentum);
+      Scalar phi = Acts::VectorHelpers::phi(momentum);
+      Scalar sinTheta =
+          (std::sin(theta) * std::sin(theta) > Scalar(10e-10)) ? std::sin(theta)
+                                                                : 1;
 
       // sample them in an independent way
-      double deltaTheta = projectionFactor * angle3D;
-      double numDetlaPhi = 0.; //?? @THIS IS WRONG HERE !
-      double deltaPhi = projectionFactor * numDetlaPhi / sinTheta;
+      Scalar deltaTheta = projectionFactor * angle3D;
+      Scalar numDetlaPhi = 0.; //?? @THIS IS WRONG HERE !
+      Scalar deltaPhi = projectionFactor * numDetlaPhi / sinTheta;
 
       // @todo: use bound parameter
       // (i) phi
+      const Scalar pi = M_PI;
       phi += deltaPhi;
-      if (phi >= M_PI)
-        phi -= M_PI;
-      else if (phi < -M_PI)
-        phi += M_PI;
+      if (phi >= pi)
+        phi -= pi;
+      else if (phi < -pi)
+        phi += pi;
       // (ii) theta
       theta += deltaTheta;
-      if (theta > M_PI)
-        theta -= M_PI;
-      else if (theta < 0.)
-        theta += M_PI;
+      if (theta > pi)
+        theta -= pi;
+      else if (theta < 0)
+        theta += pi;
 
-      double sphi = std::sin(phi);
-      double cphi = std::cos(phi);
-      double stheta = std::sin(theta);
-      double ctheta = std::cos(theta);
+      Scalar sphi = std::sin(phi);
+      Scalar cphi = std::cos(phi);
+      Scalar stheta = std::sin(theta);
+      Scalar ctheta = std::cos(theta);
 
       // assign the new values
-      in.scatter(in.p() * Acts::Vector3D(cphi * stheta, sphi * stheta, ctheta));
+      Vector3 nmomentum = p * Vector3(cphi * stheta, sphi * stheta, ctheta);
+      in.scatter(nmomentum.template cast<double>());
     } else {
 
       /// uniform distribution
-      UniformDist uniformDist = UniformDist(0., 1.);
+      BasicUniformDist<Scalar> uniformDist(0., 1.);
 
       // Create a random uniform distribution between in the intervall [0,1]
-      double psi = 2. * M_PI * uniformDist(gen);
+      Scalar psi = Scalar(2. * M_PI) * uniformDist(gen);
 
       // more complex but "more true"
-      Acts::Vector3D pDirection(in.momentum().normalized());
-      double x = -pDirection.y();
-      double y = pDirection.x();
-      double z = 0.;
+      Vector3 pDirection(momentum.normalized());
+      Scalar x = -pDirection.y();
+      Scalar y = pDirection.x();
+      Scalar z = 0.;
 
       // if it runs along the z axis - no good ==> take the x axis
-      if (pDirection.z() * pDirection.z() > 0.999999) {
+      if (pDirection.z() * pDirection.z() > Scalar(0.999999)) {
         x = 1.;
         y = 0.;
       }
       // deflector direction
-      Acts::Vector3D deflector(x, y, z);
+      Vector3 deflector(x, y, z);
       // rotate the new direction for scattering using theta and  psi
-      Acts::RotationMatrix3D rotation;
-      rotation = Acts::AngleAxis3D(psi, pDirection) *
-                 Acts::AngleAxis3D(angle3D, deflector);
+      Eigen::Matrix<Scalar, 3, 3> rotation;
+      rotation = Eigen::AngleAxis<Scalar>(psi, pDirection) *
+                 Eigen::AngleAxis<Scalar>(angle3D, deflector);
       // rotate and set a new direction to the cache
-      in.scatter(in.p() * rotation * pDirection.normalized());
+      Vector3 nmomentum = p * rotation * pDirection.normalized();
+      in.scatter(nmomentum.template cast<double>());
     }
     // scattering always returns an empty list
     // - it is a non-distructive process
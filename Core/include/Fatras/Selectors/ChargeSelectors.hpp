@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include <cstdint>
+
 namespace Fatras {
 
 struct ChargedSelector {
@@ -16,6 +19,15 @@ struct ChargedSelector {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return (particle.q() * particle.q() > 0.);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.q[i] * batch.q[i] > 0.);
+    }
+  }
 };
 
 struct NeutralSelector {
@@ -24,6 +36,15 @@ struct NeutralSelector {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return (particle.q() == 0.);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.q[i] == 0.);
+    }
+  }
 };
 
 struct PositiveSelector {
@@ -32,13 +53,31 @@ struct PositiveSelector {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return (particle.q() > 0.);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.q[i] > 0.);
+    }
+  }
 };
 
 struct NegativeSelector {
-  /// Return true for all particles with charge<> 0.
+  /// Return true for all particles with charge < 0.
   template <typename detector_t, typename particle_t>
   bool operator()(const detector_t &, const particle_t &particle) const {
-    return (particle.q() * particle.q() > 0.);
+    return (particle.q() < 0.);
+  }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.q[i] < 0.);
+    }
   }
 };
 
@@ -9,80 +9,185 @@
 #pragma once
 
 #include "Acts/Utilities/Helpers.hpp"
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
 #include <cmath>
 
 namespace Fatras {
 
+/// Each cast provides the value for a single particle and for a batch of
+/// particles, and an estimate of its relative evaluation cost that is used
+/// to order selector expressions. The expensive ones take their value from
+/// the SelectorCache if evaluated within a selector list.
 namespace casts {
 
 /// The Eta cast operator
 struct eta {
+  static constexpr unsigned int cost = 4;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return Acts::VectorHelpers::eta(particle.momentum());
   }
+
+  template <typename particle_t, typename... memo_ts>
+  double operator()(const particle_t &particle,
+                    SelectorCache<memo_ts...> &cache) const {
+    return cache.eta(particle);
+  }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      const double p = std::sqrt(batch.px[i] * batch.px[i] +
+                                 batch.py[i] * batch.py[i] +
+                                 batch.pz[i] * batch.pz[i]);
+      values[i] = std::atanh(batch.pz[i] / p);
+    }
+  }
 };
 
 /// The Eta cast operator
 struct absEta {
+  static constexpr unsigned int cost = 4;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return std::abs(Acts::VectorHelpers::eta(particle.momentum()));
   }
+
+  template <typename particle_t, typename... memo_ts>
+  double operator()(const particle_t &particle,
+                    SelectorCache<memo_ts...> &cache) const {
+    return std::abs(cache.eta(particle));
+  }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      const double p = std::sqrt(batch.px[i] * batch.px[i] +
+                                 batch.py[i] * batch.py[i] +
+                                 batch.pz[i] * batch.pz[i]);
+      values[i] = std::abs(std::atanh(batch.pz[i] / p));
+    }
+  }
 };
 
 /// The Pt cast operator
 struct pT {
+  static constexpr unsigned int cost = 2;
+
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return Acts::VectorHelpers::perp(particle.momentum());
   }
+
+  template <typename particle_t, typename... memo_ts>
+  double operator()(const particle_t &particle,
+                    SelectorCache<memo_ts...> &cache) const {
+    return cache.pT(particle);
+  }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] =
+          std::sqrt(batch.px[i] * batch.px[i] + batch.py[i] * batch.py[i]);
+    }
+  }
 };
 
 /// The P cast operator
 struct p {
+  static constexpr unsigned int cost = 2;
+
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return particle.momentum().norm();
   }
+
+  template <typename particle_t, typename... memo_ts>
+  double operator()(const particle_t &particle,
+                    SelectorCache<memo_ts...> &cache) const {
+    return cache.p(particle);
+  }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] = std::sqrt(batch.px[i] * batch.px[i] +
+                            batch.py[i] * batch.py[i] +
+                            batch.pz[i] * batch.pz[i]);
+    }
+  }
 };
 
 /// The E cast operator
 struct E {
+  static constexpr unsigned int cost = 2;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return particle.E();
   }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] = std::sqrt(
+          batch.px[i] * batch.px[i] + batch.py[i] * batch.py[i] +
+          batch.pz[i] * batch.pz[i] + batch.m[i] * batch.m[i]);
+    }
+  }
 };
 
 /// The E cast operator
 struct vR {
+  static constexpr unsigned int cost = 2;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return Acts::VectorHelpers::perp(particle.position());
   }
+
+  template <typename particle_t, typename... memo_ts>
+  double operator()(const particle_t &particle,
+                    SelectorCache<memo_ts...> &cache) const {
+    return cache.vR(particle);
+  }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] = std::sqrt(batch.x[i] * batch.x[i] + batch.y[i] * batch.y[i]);
+    }
+  }
 };
 
 /// The E cast operator
 struct vZ {
+  static constexpr unsigned int cost = 1;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return particle.position().z();
   }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] = batch.z[i];
+    }
+  }
 };
 
 /// The E cast operator
 struct AbsVz {
+  static constexpr unsigned int cost = 1;
 
   template <typename particle_t>
   double operator()(const particle_t &particle) const {
     return std::abs(particle.position().z());
   }
+
+  void operator()(const ParticleBatch &batch, double *values) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      values[i] = std::abs(batch.z[i]);
+    }
+  }
 };
 
 } // namespace casts
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include <cstdint>
+
 namespace Fatras {
 
 template <int pdg_t> struct AbsPdgSelector {
@@ -21,6 +24,15 @@ template <int pdg_t> struct AbsPdgSelector {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return (particle.pdg() * particle.pdg() == saPDG * saPDG);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.pdg[i] * batch.pdg[i] == saPDG * saPDG);
+    }
+  }
 };
 
 template <int pdg_t> struct PdgSelector {
@@ -34,6 +46,15 @@ template <int pdg_t> struct PdgSelector {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return (particle.pdg() == saPDG);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (batch.pdg[i] == saPDG);
+    }
+  }
 };
 
 template <int pdg_t> struct AbsPdgExcluder {
@@ -47,6 +68,15 @@ template <int pdg_t> struct AbsPdgExcluder {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return !(particle.pdg() * particle.pdg() == saPDG * saPDG);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (!(batch.pdg[i] * batch.pdg[i] == saPDG * saPDG));
+    }
+  }
 };
 
 template <int pdg_t> struct PdgExcluder {
@@ -60,6 +90,15 @@ template <int pdg_t> struct PdgExcluder {
   bool operator()(const detector_t &, const particle_t &particle) const {
     return !(particle.pdg() == saPDG);
   }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = (!(batch.pdg[i] == saPDG));
+    }
+  }
 };
 
 } // namespace Fatras
@@ -8,16 +8,59 @@
 
 #pragma once
 
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/detail/selector_expression_implementation.hpp"
+#include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <type_traits>
 
 namespace Fatras {
 
+namespace detail {
+
+/// Evaluate a cast on a batch in chunks that fit on the stack
+///
+/// @param cast is the kinematic cast
+/// @param batch are the particles to be casted
+/// @param function is called with the batch index and the value
+template <typename cast_t, typename function_t>
+void castBatch(const cast_t &cast, const ParticleBatch &batch,
+               function_t &&function) {
+  constexpr std::size_t chunk = 256;
+  double values[chunk];
+  for (std::size_t begin = 0; begin < batch.size; begin += chunk) {
+    const std::size_t n = std::min(chunk, batch.size - begin);
+    cast(batch.slice(begin, begin + n), values);
+    for (std::size_t i = 0; i < n; ++i) {
+      function(begin + i, values[i]);
+    }
+  }
+}
+
+/// Evaluate a cast, from the cache if the cast supports it
+template <typename cast_t, typename particle_t, typename cache_t>
+double castCached(const cast_t &cast, const particle_t &particle,
+                  cache_t &cache) {
+  if constexpr (std::is_invocable_r_v<double, const cast_t &,
+                                      const particle_t &, cache_t &>) {
+    return cast(particle, cache);
+  } else {
+    return cast(particle);
+  }
+}
+
+} // namespace detail
+
 // static selectors
 template <typename cast_t> struct Min {
 
   cast_t cast;
   double valMin = 0.;
 
+  static constexpr unsigned int cost = detail::selector_cost_v<cast_t>;
+
   /// Return true for all particles with transverse momentum
   /// bigger than the specified minimum value
   template <typename detector_t, typename particle_t>
@@ -25,6 +68,23 @@ template <typename cast_t> struct Min {
     double val = cast(particle);
     return (val >= valMin);
   }
+
+  /// The same with the kinematics taken from the cache
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
+    double val = detail::castCached(cast, particle, cache);
+    return (val >= valMin);
+  }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    detail::castBatch(cast, batch, [&](std::size_t i, double val) {
+      mask[i] = (val >= valMin);
+    });
+  }
 };
 
 template <typename cast_t> struct Max {
@@ -32,6 +92,8 @@ template <typename cast_t> struct Max {
   cast_t cast;
   double valMax = std::numeric_limits<double>::max();
 
+  static constexpr unsigned int cost = detail::selector_cost_v<cast_t>;
+
   /// Return true for all particles with transverse momentum
   /// bigger than the specified minimum value
   template <typename detector_t, typename particle_t>
@@ -39,6 +101,23 @@ template <typename cast_t> struct Max {
     double val = cast(particle);
     return (val <= valMax);
   }
+
+  /// The same with the kinematics taken from the cache
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
+    double val = detail::castCached(cast, particle, cache);
+    return (val <= valMax);
+  }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    detail::castBatch(cast, batch, [&](std::size_t i, double val) {
+      mask[i] = (val <= valMax);
+    });
+  }
 };
 
 template <typename cast_t> struct Range {
@@ -47,6 +126,8 @@ template <typename cast_t> struct Range {
   double valMin = 0.;
   double valMax = std::numeric_limits<double>::max();
 
+  static constexpr unsigned int cost = detail::selector_cost_v<cast_t>;
+
   /// Return true for all particles with transverse momentum
   /// within the specified range
   template <typename detector_t, typename particle_t>
@@ -54,5 +135,22 @@ template <typename cast_t> struct Range {
     double val = cast(particle);
     return (val >= valMin && val <= valMax);
   }
+
+  /// The same with the kinematics taken from the cache
+  template <typename detector_t, typename particle_t, typename... memo_ts>
+  bool operator()(const detector_t &, const particle_t &particle,
+                  SelectorCache<memo_ts...> &cache) const {
+    double val = detail::castCached(cast, particle, cache);
+    return (val >= valMin && val <= valMax);
+  }
+
+  /// The same for a batch of particles
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    detail::castBatch(cast, batch, [&](std::size_t i, double val) {
+      mask[i] = (val >= valMin && val <= valMax);
+    });
+  }
 };
 } // namespace Fatras
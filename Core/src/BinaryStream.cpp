@@ -0,0 +1,126 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/IO/BinaryStream.hpp"
+
+Fatras::AsyncWriter::AsyncWriter(const std::string &path,
+                                 std::size_t bufferSize)
+    : m_file(path, std::ios::binary | std::ios::trunc),
+      m_bufferSize(bufferSize) {
+  if (not m_file) {
+    throw std::runtime_error("Could not open stream file " + path);
+  }
+  stream::FileHeader header;
+  m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  m_front.reserve(bufferSize);
+  m_back.reserve(bufferSize);
+  m_thread = std::thread([this]() { run(); });
+}
+
+Fatras::AsyncWriter::~AsyncWriter() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+void Fatras::AsyncWriter::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // the writer thread still owns the back buffer
+  m_condition.wait(lock, [this]() { return not m_backFull; });
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+  if (m_front.empty()) {
+    return;
+  }
+  std::swap(m_front, m_back);
+  m_front.clear();
+  m_bytesWritten += m_back.size();
+  m_backFull = true;
+  m_condition.notify_all();
+}
+
+void Fatras::AsyncWriter::close() {
+  if (not m_thread.joinable()) {
+    return;
+  }
+  std::exception_ptr error = nullptr;
+  try {
+    flush();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return not m_backFull; });
+    m_stop = true;
+    m_condition.notify_all();
+  }
+  m_thread.join();
+  m_file.close();
+  if (not error) {
+    error = m_error;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void Fatras::AsyncWriter::run() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]() { return m_backFull or m_stop; });
+      if (not m_backFull) {
+        return;
+      }
+    }
+    // the back buffer is owned by this thread until it is released
+    if (not m_error) {
+      m_file.write(m_back.data(), m_back.size());
+      m_file.flush();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (not m_error and not m_file) {
+      m_error = std::make_exception_ptr(
+          std::runtime_error("Could not write to stream file"));
+    }
+    m_back.clear();
+    m_backFull = false;
+    m_condition.notify_all();
+  }
+}
+
+Fatras::BlockReader::BlockReader(const std::string &path)
+    : m_file(path, std::ios::binary) {
+  stream::FileHeader header;
+  m_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (not m_file or header.magic != stream::magic) {
+    throw std::runtime_error("Not a stream file " + path);
+  }
+  if (header.version != stream::version) {
+    throw std::runtime_error("Unsupported stream file version in " + path);
+  }
+}
+
+bool Fatras::BlockReader::next() {
+  m_file.read(reinterpret_cast<char *>(&m_header), sizeof(m_header));
+  if (m_file.gcount() == 0) {
+    return false;
+  }
+  if (not m_file) {
+    throw std::runtime_error("Truncated stream block header");
+  }
+  m_data.resize(m_header.recordSize * m_header.count);
+  m_file.read(m_data.data(), m_data.size());
+  if (not m_file) {
+    throw std::runtime_error("Truncated stream block");
+  }
+  return true;
+}
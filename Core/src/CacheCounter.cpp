@@ -0,0 +1,85 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Kernel/CacheCounter.hpp"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+/// Open a counter of the calling thread, disabled if it leads a group
+int openCounter(std::uint64_t config, int group) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = group < 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return ::syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+} // namespace
+
+Fatras::CacheCounter::CacheCounter() {
+  m_references = openCounter(PERF_COUNT_HW_CACHE_REFERENCES, -1);
+  if (m_references >= 0) {
+    m_misses = openCounter(PERF_COUNT_HW_CACHE_MISSES, m_references);
+  }
+}
+
+Fatras::CacheCounter::~CacheCounter() {
+  if (m_misses >= 0) {
+    ::close(m_misses);
+  }
+  if (m_references >= 0) {
+    ::close(m_references);
+  }
+}
+
+void Fatras::CacheCounter::start() {
+  if (available()) {
+    ::ioctl(m_references, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(m_references, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+Fatras::CacheCounter::Counts Fatras::CacheCounter::stop() {
+  Counts counts;
+  if (available()) {
+    ::ioctl(m_references, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // the group is read as the number of counters and their values
+    std::uint64_t values[3] = {0, 0, 0};
+    if (::read(m_references, values, sizeof(values)) ==
+            static_cast<ssize_t>(sizeof(values)) and
+        values[0] == 2) {
+      counts.references = values[1];
+      counts.misses = values[2];
+    }
+  }
+  return counts;
+}
+
+#else
+
+Fatras::CacheCounter::CacheCounter() = default;
+
+Fatras::CacheCounter::~CacheCounter() = default;
+
+void Fatras::CacheCounter::start() {}
+
+Fatras::CacheCounter::Counts Fatras::CacheCounter::stop() { return Counts(); }
+
+#endif
@@ -0,0 +1,155 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/IO/ColumnarFile.hpp"
+
+#include <fstream>
+
+namespace {
+
+std::size_t aligned(std::size_t offset) {
+  constexpr std::size_t alignment = Fatras::columnar::alignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// The element size of a column type, 0 for unknown types
+std::size_t elementSize(std::uint32_t type) {
+  using Fatras::columnar::Type;
+  switch (static_cast<Type>(type)) {
+  case Type::UInt64:
+    return sizeof(std::uint64_t);
+  case Type::Int32:
+    return sizeof(std::int32_t);
+  case Type::Float:
+    return sizeof(float);
+  case Type::Double:
+    return sizeof(double);
+  }
+  return 0;
+}
+
+} // namespace
+
+void *Fatras::ColumnarWriter::allocate(const std::string &name,
+                                       columnar::Type type,
+                                       std::size_t elementSize,
+                                       std::size_t count) {
+  if (name.empty() or name.size() >= sizeof(columnar::ColumnHeader::name)) {
+    throw std::invalid_argument("Invalid column name '" + name + "'");
+  }
+  for (const auto &column : m_columns) {
+    if (name == column.header.name) {
+      throw std::invalid_argument("Duplicated column name '" + name + "'");
+    }
+  }
+  m_columns.emplace_back();
+  Column &column = m_columns.back();
+  std::memcpy(column.header.name, name.data(), name.size());
+  column.header.type = static_cast<std::uint32_t>(type);
+  column.header.elementSize = elementSize;
+  column.header.count = count;
+  column.data.resize(elementSize * count);
+  return column.data.data();
+}
+
+void Fatras::ColumnarWriter::write(const std::string &path) const {
+  columnar::FileHeader fileHeader;
+  fileHeader.nColumns = m_columns.size();
+  // the column directory follows the file header, the data the directory
+  std::vector<columnar::ColumnHeader> headers;
+  std::size_t offset = aligned(sizeof(fileHeader) +
+                               m_columns.size() * sizeof(headers.front()));
+  for (const auto &column : m_columns) {
+    headers.push_back(column.header);
+    headers.back().offset = offset;
+    offset = aligned(offset + column.data.size());
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (not file) {
+    throw std::runtime_error("Could not open columnar file " + path);
+  }
+  file.write(reinterpret_cast<const char *>(&fileHeader), sizeof(fileHeader));
+  file.write(reinterpret_cast<const char *>(headers.data()),
+             headers.size() * sizeof(headers.front()));
+  const char padding[columnar::alignment] = {};
+  std::size_t position = sizeof(fileHeader) +
+                         headers.size() * sizeof(headers.front());
+  for (std::size_t i = 0; i < m_columns.size(); ++i) {
+    file.write(padding, headers[i].offset - position);
+    file.write(m_columns[i].data.data(), m_columns[i].data.size());
+    position = headers[i].offset + m_columns[i].data.size();
+  }
+  if (not file) {
+    throw std::runtime_error("Could not write columnar file " + path);
+  }
+}
+
+Fatras::ColumnarReader::ColumnarReader(const std::string &path)
+    : m_file(path) {
+  // validate everything once, such that column() needs no checks
+  const char *data = m_file.data();
+  const std::size_t size = m_file.size();
+  columnar::FileHeader header;
+  bool valid = size >= sizeof(header);
+  if (valid) {
+    std::memcpy(&header, data, sizeof(header));
+    valid = header.magic == columnar::magic and
+            header.version == columnar::version and
+            (size - sizeof(header)) / sizeof(columnar::ColumnHeader) >=
+                header.nColumns;
+  }
+  if (valid) {
+    m_columns = reinterpret_cast<const columnar::ColumnHeader *>(
+        data + sizeof(header));
+    m_nColumns = header.nColumns;
+    for (std::uint32_t i = 0; valid and i < m_nColumns; ++i) {
+      const auto &column = m_columns[i];
+      valid = column.offset % columnar::alignment == 0 and
+              column.offset <= size and
+              column.elementSize != 0 and
+              column.elementSize == elementSize(column.type) and
+              (size - column.offset) / column.elementSize >= column.count and
+              std::memchr(column.name, 0, sizeof(column.name)) != nullptr;
+    }
+  }
+  if (not valid) {
+    throw std::runtime_error("Not a columnar file " + path);
+  }
+}
+
+std::vector<std::string> Fatras::ColumnarReader::names() const {
+  std::vector<std::string> result;
+  for (std::uint32_t i = 0; i < m_nColumns; ++i) {
+    result.emplace_back(m_columns[i].name);
+  }
+  return result;
+}
+
+const Fatras::columnar::ColumnHeader *
+Fatras::ColumnarReader::find(const std::string &name) const {
+  for (std::uint32_t i = 0; i < m_nColumns; ++i) {
+    if (name == m_columns[i].name) {
+      return &m_columns[i];
+    }
+  }
+  return nullptr;
+}
+
+const Fatras::columnar::ColumnHeader *
+Fatras::ColumnarReader::get(const std::string &name,
+                            columnar::Type type) const {
+  const columnar::ColumnHeader *header = find(name);
+  if (not header) {
+    throw std::runtime_error("Missing column '" + name + "'");
+  }
+  if (header->type != static_cast<std::uint32_t>(type)) {
+    throw std::runtime_error("Type mismatch of column '" + name + "'");
+  }
+  return header;
+}
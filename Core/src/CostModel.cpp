@@ -0,0 +1,130 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Kernel/CostModel.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+
+constexpr std::size_t nClasses = 4;
+
+/// Electrons and photons, muons, charged and neutral hadrons
+std::size_t costClass(int pdg, double q) {
+  const int absPdg = std::abs(pdg);
+  if (absPdg == 11 or absPdg == 22) {
+    return 0;
+  }
+  if (absPdg == 13) {
+    return 1;
+  }
+  return q != 0. ? 2 : 3;
+}
+
+std::size_t clampedBin(double value, double min, double max,
+                       std::size_t nBins) {
+  if (not(value > min)) {
+    return 0;
+  }
+  std::size_t b = static_cast<std::size_t>((value - min) / (max - min) * nBins);
+  return std::min(b, nBins - 1);
+}
+
+} // namespace
+
+Fatras::TailReport Fatras::tailReport(const std::vector<double> &times,
+                                      std::size_t nWorkers) {
+  TailReport report;
+  report.nParticles = times.size();
+  nWorkers = std::max<std::size_t>(nWorkers, 1);
+  // the finishing times of the busy workers, the earliest on top
+  std::priority_queue<double, std::vector<double>, std::greater<double>>
+      workers;
+  for (std::size_t w = 0; w < nWorkers; ++w) {
+    workers.push(0.);
+  }
+  for (double time : times) {
+    double start = workers.top();
+    workers.pop();
+    workers.push(start + time);
+    report.total += time;
+    report.longest = std::max(report.longest, time);
+    report.makespan = std::max(report.makespan, start + time);
+  }
+  report.lowerBound = std::max(report.total / nWorkers, report.longest);
+  return report;
+}
+
+Fatras::CostModel::CostModel(const Config &cfg)
+    : m_cfg(cfg),
+      m_bins(nClasses * cfg.nEtaBins * cfg.nPTBins * cfg.nEBins),
+      m_classes(nClasses), m_frozenBins(m_bins.size()),
+      m_frozenClasses(nClasses) {}
+
+std::size_t Fatras::CostModel::bin(int pdg, double q, double absEta,
+                                   double pT, double E) const {
+  const double logPT = std::log10(pT / Acts::units::_GeV);
+  const double logE = std::log10(E / Acts::units::_GeV);
+  std::size_t etaBin = clampedBin(absEta, 0., m_cfg.maxAbsEta, m_cfg.nEtaBins);
+  std::size_t pTBin =
+      clampedBin(logPT, m_cfg.minLogPT, m_cfg.maxLogPT, m_cfg.nPTBins);
+  std::size_t EBin =
+      clampedBin(logE, m_cfg.minLogE, m_cfg.maxLogE, m_cfg.nEBins);
+  std::size_t index = costClass(pdg, q) * m_cfg.nEtaBins + etaBin;
+  index = index * m_cfg.nPTBins + pTBin;
+  return index * m_cfg.nEBins + EBin;
+}
+
+double Fatras::CostModel::estimate(int pdg, double q, double absEta,
+                                   double pT, double E) const {
+  const std::size_t b = bin(pdg, q, absEta, pT, E);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_frozenBins[b].n > 0.) {
+    return m_frozenBins[b].mean;
+  }
+  const Bin &cls = m_frozenClasses[costClass(pdg, q)];
+  return cls.n > 0. ? cls.mean : m_cfg.prior;
+}
+
+void Fatras::CostModel::learn(int pdg, double q, double absEta, double pT,
+                              double E, double time) {
+  const std::size_t b = bin(pdg, q, absEta, pT, E);
+  // running mean, which turns into an exponential average after memory
+  // measurements to follow a changing load
+  auto update = [&](Bin &bin) {
+    bin.n = std::min(bin.n + 1., m_cfg.memory);
+    bin.mean += (time - bin.mean) / bin.n;
+  };
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update(m_bins[b]);
+  update(m_classes[costClass(pdg, q)]);
+}
+
+void Fatras::CostModel::freeze() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_frozenBins = m_bins;
+  m_frozenClasses = m_classes;
+}
+
+void Fatras::CostModel::addEvent(const std::vector<double> &times) {
+  TailReport event = tailReport(times, m_cfg.nWorkers);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_report.nEvents;
+  m_report.nParticles += event.nParticles;
+  m_report.sumMakespan += event.makespan;
+  m_report.maxMakespan = std::max(m_report.maxMakespan, event.makespan);
+  m_report.sumLowerBound += event.lowerBound;
+}
+
+Fatras::CostModel::Report Fatras::CostModel::report() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_report;
+}
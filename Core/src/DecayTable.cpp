@@ -0,0 +1,107 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Physics/Decay/DecayTable.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+namespace au = Acts::units;
+
+constexpr double stable = std::numeric_limits<double>::infinity();
+
+// Two-body decay channels, values from the PDG review 2018. Only the
+// two-body channels are tabulated, the branching ratios are renormalised
+// to the tabulated channels and given as cumulative values.
+const Fatras::DecayChannel s_channels[] = {
+    // pi+ -> mu+ nu_mu
+    {1., {-13, 14}},
+    // K0S -> pi+ pi-, pi0 pi0
+    {0.6920 / 0.9989, {211, -211}},
+    {1., {111, 111}},
+    // K+ -> mu+ nu_mu, pi+ pi0
+    {0.6356 / 0.8423, {-13, 14}},
+    {1., {211, 111}},
+    // Lambda -> p pi-, n pi0
+    {0.639 / 0.997, {2212, -211}},
+    {1., {2112, 111}},
+    // Sigma- -> n pi-
+    {1., {2112, -211}},
+    // Sigma+ -> p pi0, n pi+
+    {0.5157 / 0.9988, {2212, 111}},
+    {1., {2112, 211}},
+    // Xi- -> Lambda pi-
+    {1., {3122, -211}},
+    // Xi0 -> Lambda pi0
+    {1., {3122, 111}},
+    // Omega- -> Lambda K-, Xi0 pi-, Xi- pi0
+    {0.678, {3122, -321}},
+    {0.914, {3322, -211}},
+    {1., {3312, 111}},
+};
+
+constexpr const Fatras::DecayChannel *channel(std::size_t i) {
+  return s_channels + i;
+}
+
+// The species table, sorted by pdg code for the binary search
+const Fatras::DecaySpecies s_species[] = {
+    {11, 0.51099895 * au::_MeV, -1., stable, false},
+    {12, 0., 0., stable, false},
+    {13, 105.6583745 * au::_MeV, -1., stable, false},
+    {14, 0., 0., stable, false},
+    {22, 0., 0., stable, true},
+    {111, 134.9768 * au::_MeV, 0., stable, true},
+    {130, 497.611 * au::_MeV, 0., stable, true},
+    {211, 139.57039 * au::_MeV, 1., 26.033 * au::_ns, false, channel(0),
+     channel(1)},
+    {310, 497.611 * au::_MeV, 0., 0.08954 * au::_ns, true, channel(1),
+     channel(3)},
+    {321, 493.677 * au::_MeV, 1., 12.380 * au::_ns, false, channel(3),
+     channel(5)},
+    {2112, 939.56542 * au::_MeV, 0., stable, false},
+    {2212, 938.27208 * au::_MeV, 1., stable, false},
+    {3112, 1197.449 * au::_MeV, -1., 0.1479 * au::_ns, false, channel(7),
+     channel(8)},
+    {3122, 1115.683 * au::_MeV, 0., 0.2632 * au::_ns, false, channel(5),
+     channel(7)},
+    {3222, 1189.37 * au::_MeV, 1., 0.08018 * au::_ns, false, channel(8),
+     channel(10)},
+    {3312, 1321.71 * au::_MeV, -1., 0.1639 * au::_ns, false, channel(10),
+     channel(11)},
+    {3322, 1314.86 * au::_MeV, 0., 0.290 * au::_ns, false, channel(11),
+     channel(12)},
+    {3334, 1672.45 * au::_MeV, -1., 0.0821 * au::_ns, false, channel(12),
+     channel(15)},
+};
+
+} // namespace
+
+const Fatras::DecaySpecies *Fatras::findDecaySpecies(int pdg) {
+  const int absPdg = std::abs(pdg);
+  auto it = std::lower_bound(
+      std::begin(s_species), std::end(s_species), absPdg,
+      [](const DecaySpecies &species, int p) { return species.pdg < p; });
+  if (it == std::end(s_species) or it->pdg != absPdg) {
+    return nullptr;
+  }
+  // self-conjugate species have no negative pdg code
+  if (pdg < 0 and it->selfConjugate) {
+    return nullptr;
+  }
+  return &(*it);
+}
+
+int Fatras::chargeConjugate(int pdg) {
+  const DecaySpecies *species = findDecaySpecies(pdg);
+  return (species and species->selfConjugate) ? pdg : -pdg;
+}
@@ -0,0 +1,179 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/IO/EventFile.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+/// Check that all ranges lie within [0, limit)
+bool contained(const Fatras::eventfile::Range *ranges, std::uint64_t n,
+               std::uint64_t limit) {
+  for (std::uint64_t i = 0; i < n; ++i) {
+    if (ranges[i].first > limit or ranges[i].count > limit - ranges[i].first) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+Fatras::EventFileReader::EventFileReader(const std::string &path)
+    : m_file(path) {
+  const char *data = m_file.data();
+  const std::size_t size = m_file.size();
+  bool valid = size >= sizeof(m_header);
+  if (valid) {
+    std::memcpy(&m_header, data, sizeof(m_header));
+    // the tables are checked one after the other against the file size
+    std::size_t remaining = size - sizeof(m_header);
+    valid = m_header.magic == eventfile::magic and
+            m_header.version == eventfile::version and
+            remaining / sizeof(eventfile::Range) >= m_header.nEvents;
+    if (valid) {
+      remaining -= m_header.nEvents * sizeof(eventfile::Range);
+      valid = remaining / sizeof(eventfile::Range) >= m_header.nVertices;
+    }
+    if (valid) {
+      remaining -= m_header.nVertices * sizeof(eventfile::Range);
+      valid = remaining / sizeof(PrimaryRecord) >= m_header.nParticles;
+    }
+  }
+  if (valid) {
+    m_events = reinterpret_cast<const eventfile::Range *>(data +
+                                                          sizeof(m_header));
+    m_vertices = m_events + m_header.nEvents;
+    m_primaries = reinterpret_cast<const PrimaryRecord *>(
+        m_vertices + m_header.nVertices);
+    valid = contained(m_events, m_header.nEvents, m_header.nVertices) and
+            contained(m_vertices, m_header.nVertices, m_header.nParticles);
+  }
+  if (not valid) {
+    throw std::runtime_error("Not an event file " + path);
+  }
+  m_thread = std::thread([this]() { run(); });
+}
+
+Fatras::EventFileReader::~EventFileReader() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  m_thread.join();
+}
+
+void Fatras::EventFileReader::prefetch(std::size_t index) {
+  if (index >= size()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requests.push_back(index);
+  }
+  m_condition.notify_all();
+}
+
+void Fatras::EventFileReader::run() {
+  const std::size_t page = ::sysconf(_SC_PAGESIZE);
+  while (true) {
+    std::size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock,
+                       [this]() { return m_stop or not m_requests.empty(); });
+      if (m_stop) {
+        return;
+      }
+      index = m_requests.front();
+      m_requests.erase(m_requests.begin());
+    }
+    const eventfile::Range &event = m_events[index];
+    for (std::uint64_t v = event.first; v < event.first + event.count; ++v) {
+      const char *begin =
+          reinterpret_cast<const char *>(m_primaries + m_vertices[v].first);
+      std::size_t length = m_vertices[v].count * sizeof(PrimaryRecord);
+      m_file.willNeed(begin - m_file.data(), length);
+      // touch every page, such that the simulation does not page fault
+      for (std::size_t offset = 0; offset < length; offset += page) {
+        static_cast<void>(*static_cast<const volatile char *>(begin + offset));
+      }
+    }
+    ++m_prefetched;
+  }
+}
+
+std::size_t Fatras::convertEventText(std::istream &input,
+                                     const std::string &path) {
+  std::vector<eventfile::Range> events;
+  std::vector<eventfile::Range> vertices;
+  std::vector<PrimaryRecord> primaries;
+
+  std::string line;
+  std::size_t lineNumber = 0;
+  while (std::getline(input, line)) {
+    ++lineNumber;
+    std::istringstream fields(line);
+    std::string keyword;
+    if (not(fields >> keyword) or keyword[0] == '#') {
+      continue;
+    }
+    auto fail = [&](const std::string &what) {
+      throw std::runtime_error(what + " in line " +
+                               std::to_string(lineNumber));
+    };
+    if (keyword == "event") {
+      events.push_back({vertices.size(), 0});
+    } else if (keyword == "vertex") {
+      if (events.empty()) {
+        fail("Vertex without event");
+      }
+      vertices.push_back({primaries.size(), 0});
+      ++events.back().count;
+    } else if (keyword == "particle") {
+      if (events.empty() or events.back().count == 0) {
+        fail("Particle without vertex");
+      }
+      PrimaryRecord record;
+      fields >> record.barcode >> record.pdg >> record.q >> record.m >>
+          record.x >> record.y >> record.z >> record.time >> record.px >>
+          record.py >> record.pz;
+      if (not fields) {
+        fail("Malformed particle");
+      }
+      primaries.push_back(record);
+      ++vertices.back().count;
+    } else {
+      fail("Unknown keyword '" + keyword + "'");
+    }
+  }
+
+  eventfile::FileHeader header;
+  header.nEvents = events.size();
+  header.nVertices = vertices.size();
+  header.nParticles = primaries.size();
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(events.data()),
+             events.size() * sizeof(eventfile::Range));
+  file.write(reinterpret_cast<const char *>(vertices.data()),
+             vertices.size() * sizeof(eventfile::Range));
+  file.write(reinterpret_cast<const char *>(primaries.data()),
+             primaries.size() * sizeof(PrimaryRecord));
+  if (not file) {
+    throw std::runtime_error("Could not write event file " + path);
+  }
+  return events.size();
+}
@@ -0,0 +1,51 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/IO/MappedFile.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Fatras::MappedFile::MappedFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open file " + path);
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 or status.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not map empty file " + path);
+  }
+  m_size = status.st_size;
+  void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Could not map file " + path);
+  }
+  m_data = static_cast<const char *>(data);
+}
+
+Fatras::MappedFile::~MappedFile() {
+  ::munmap(const_cast<char *>(m_data), m_size);
+}
+
+void Fatras::MappedFile::willNeed(std::size_t offset,
+                                  std::size_t length) const {
+  if (offset >= m_size) {
+    return;
+  }
+  const std::size_t page = ::sysconf(_SC_PAGESIZE);
+  std::size_t begin = offset / page * page;
+  std::size_t end = std::min(offset + length, m_size);
+  ::madvise(const_cast<char *>(m_data) + begin, end - begin, MADV_WILLNEED);
+}
@@ -0,0 +1,53 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Kernel/ParticleStore.hpp"
+
+void Fatras::ParticleStore::reserve(std::size_t n) {
+  m_x.reserve(n);
+  m_y.reserve(n);
+  m_z.reserve(n);
+  m_px.reserve(n);
+  m_py.reserve(n);
+  m_pz.reserve(n);
+  m_time.reserve(n);
+  m_m.reserve(n);
+  m_q.reserve(n);
+  m_pdg.reserve(n);
+  m_barcode.reserve(n);
+  m_status.reserve(n);
+}
+
+void Fatras::ParticleStore::clear() {
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_px.clear();
+  m_py.clear();
+  m_pz.clear();
+  m_time.clear();
+  m_m.clear();
+  m_q.clear();
+  m_pdg.clear();
+  m_barcode.clear();
+  m_status.clear();
+  m_primaries = 0;
+}
+
+Fatras::ParticleBatch Fatras::ParticleStore::batch() const {
+  return batch(0, static_cast<Index>(size()));
+}
+
+Fatras::ParticleBatch Fatras::ParticleStore::batch(Index begin,
+                                                   Index end) const {
+  ParticleBatch all{size(),      m_x.data(),  m_y.data(),
+                    m_z.data(),  m_px.data(), m_py.data(),
+                    m_pz.data(), m_m.data(),  m_q.data(),
+                    m_pdg.data()};
+  return all.slice(begin, end);
+}
@@ -0,0 +1,44 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Kernel/PhysicsRegions.hpp"
+#include <algorithm>
+
+namespace {
+
+using Record = std::pair<Acts::geo_id_value, Fatras::PhysicsRegion>;
+
+bool lessVolume(const Record &record, Acts::geo_id_value volume) {
+  return record.first < volume;
+}
+
+} // namespace
+
+Fatras::PhysicsRegions::PhysicsRegions(PhysicsRegion defaultRegion)
+    : m_default(std::move(defaultRegion)) {}
+
+void Fatras::PhysicsRegions::set(Acts::geo_id_value volume,
+                                 PhysicsRegion region) {
+  auto it =
+      std::lower_bound(m_regions.begin(), m_regions.end(), volume, lessVolume);
+  if (it != m_regions.end() and it->first == volume) {
+    it->second = std::move(region);
+  } else {
+    m_regions.emplace(it, volume, std::move(region));
+  }
+}
+
+const Fatras::PhysicsRegion &
+Fatras::PhysicsRegions::find(Acts::geo_id_value volume) const {
+  auto it =
+      std::lower_bound(m_regions.begin(), m_regions.end(), volume, lessVolume);
+  if (it == m_regions.end() or it->first != volume) {
+    return m_default;
+  }
+  return it->second;
+}
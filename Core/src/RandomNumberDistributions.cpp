@@ -8,26 +8,43 @@
 
 #include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
 
-Fatras::LandauDist::param_type::param_type(double mean, double scale)
+template <typename scalar_t>
+Fatras::BasicLandauDist<scalar_t>::param_type::param_type(scalar_t mean,
+                                                          scalar_t scale)
     : mean(mean), scale(scale) {}
 
-bool Fatras::LandauDist::param_type::operator==(const param_type &other) const {
+template <typename scalar_t>
+bool Fatras::BasicLandauDist<scalar_t>::param_type::operator==(
+    const param_type &other) const {
   return (mean == other.mean) && (scale == other.scale);
 }
 
-Fatras::LandauDist::LandauDist(double mean, double scale)
+template <typename scalar_t>
+Fatras::BasicLandauDist<scalar_t>::BasicLandauDist(scalar_t mean,
+                                                   scalar_t scale)
     : m_cfg(mean, scale) {}
 
-Fatras::LandauDist::LandauDist(const param_type &cfg) : m_cfg(cfg) {}
+template <typename scalar_t>
+Fatras::BasicLandauDist<scalar_t>::BasicLandauDist(const param_type &cfg)
+    : m_cfg(cfg) {}
 
-Fatras::LandauDist::result_type Fatras::LandauDist::min() const {
-  return -std::numeric_limits<double>::infinity();
+template <typename scalar_t>
+typename Fatras::BasicLandauDist<scalar_t>::result_type
+Fatras::BasicLandauDist<scalar_t>::min() const {
+  return -std::numeric_limits<scalar_t>::infinity();
 }
 
-Fatras::LandauDist::result_type Fatras::LandauDist::max() const {
-  return std::numeric_limits<double>::infinity();
+template <typename scalar_t>
+typename Fatras::BasicLandauDist<scalar_t>::result_type
+Fatras::BasicLandauDist<scalar_t>::max() const {
+  return std::numeric_limits<scalar_t>::infinity();
 }
 
-bool Fatras::LandauDist::operator==(const LandauDist &other) const {
+template <typename scalar_t>
+bool Fatras::BasicLandauDist<scalar_t>::operator==(
+    const BasicLandauDist &other) const {
   return (m_cfg == other.m_cfg);
 }
+
+template class Fatras::BasicLandauDist<float>;
+template class Fatras::BasicLandauDist<double>;
@@ -0,0 +1,106 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Physics/EnergyLoss/RangeOut.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+
+namespace au = Acts::units;
+
+/// K = 4 pi N_A r_e^2 m_e c^2
+constexpr double K = 0.307075 * au::_MeV * au::_cm * au::_cm;
+constexpr double electronMass = 0.51099895 * au::_MeV;
+
+} // namespace
+
+double Fatras::RangeTable::stoppingPower(const Acts::Material &material,
+                                         double mass, double charge,
+                                         double kineticEnergy) {
+  const double Z = material.Z();
+  const double E = kineticEnergy + mass;
+  const double gamma = E / mass;
+  const double beta2 = 1. - 1. / (gamma * gamma);
+  const double bg2 = beta2 * gamma * gamma;
+  const double ratio = electronMass / mass;
+  const double tMax =
+      2. * electronMass * bg2 / (1. + 2. * gamma * ratio + ratio * ratio);
+  const double I = 16e-3 * au::_keV * std::pow(Z, 0.9);
+  double bracket =
+      0.5 * std::log(2. * electronMass * bg2 * tMax / (I * I)) - beta2;
+  // the formula breaks down close to rest
+  bracket = std::max(bracket, 0.05);
+  return K * charge * charge * Z / material.A() * material.rho() / beta2 *
+         bracket;
+}
+
+Fatras::RangeTable::RangeTable(const Acts::Material &material, double mass,
+                               double charge, const Config &cfg)
+    : m_logMin(std::log(cfg.minEnergy)),
+      m_logStep(std::log(cfg.maxEnergy / cfg.minEnergy) / cfg.nBins),
+      m_ranges(cfg.nBins + 1) {
+  auto integrand = [&](double logT) {
+    const double T = std::exp(logT);
+    return T / stoppingPower(material, mass, charge, T);
+  };
+  // the range of the lowest energy as if the loss were constant
+  m_ranges[0] = integrand(m_logMin);
+  for (std::size_t i = 1; i < m_ranges.size(); ++i) {
+    const double logT = m_logMin + (i - 0.5) * m_logStep;
+    m_ranges[i] = m_ranges[i - 1] + m_logStep * integrand(logT);
+  }
+  m_lastStoppingPower = stoppingPower(material, mass, charge, cfg.maxEnergy);
+}
+
+double Fatras::RangeTable::range(double kineticEnergy) const {
+  if (not(kineticEnergy > 0.)) {
+    return 0.;
+  }
+  const double x = (std::log(kineticEnergy) - m_logMin) / m_logStep;
+  if (x <= 0.) {
+    return m_ranges[0] * kineticEnergy / std::exp(m_logMin);
+  }
+  const std::size_t last = m_ranges.size() - 1;
+  if (x >= last) {
+    const double maxEnergy = std::exp(m_logMin + last * m_logStep);
+    return m_ranges[last] + (kineticEnergy - maxEnergy) / m_lastStoppingPower;
+  }
+  const std::size_t i = static_cast<std::size_t>(x);
+  return m_ranges[i] + (x - i) * (m_ranges[i + 1] - m_ranges[i]);
+}
+
+const Fatras::RangeTable &
+Fatras::RangeOut::table(const Acts::Material &material, int pdg, double mass,
+                        double charge) {
+  Key key(material.X0(), material.L0(), material.A(), material.Z(),
+          material.rho(), std::abs(pdg));
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_tables.find(key);
+    if (it != m_tables.end()) {
+      return *it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  auto &table = m_tables[key];
+  if (not table) {
+    table = std::make_unique<const RangeTable>(material, mass,
+                                               std::abs(charge), m_cfg.table);
+  }
+  return *table;
+}
+
+Fatras::RangeOut::Counters Fatras::RangeOut::counters() const {
+  Counters result;
+  result.checked = m_checked;
+  result.rangedOut = m_rangedOut;
+  result.depositedEnergy = m_deposited;
+  return result;
+}
@@ -0,0 +1,115 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Fatras/Kernel/TruthGraph.hpp"
+#include <algorithm>
+
+namespace {
+
+using Index = Fatras::TruthGraph::Index;
+
+/// Turn per-row counts into row offsets, in place
+void countsToOffsets(std::vector<Index> &offsets) {
+  Index sum = 0;
+  for (auto &offset : offsets) {
+    Index count = offset;
+    offset = sum;
+    sum += count;
+  }
+}
+
+} // namespace
+
+void Fatras::TruthGraph::reserve(std::size_t vertices, std::size_t particles) {
+  m_vertices.reserve(vertices);
+  m_edges.reserve(particles);
+}
+
+void Fatras::TruthGraph::clear() {
+  m_vertices.clear();
+  m_edges.clear();
+  m_outgoingOffsets.clear();
+  m_outgoing.clear();
+  m_production.clear();
+  m_endOffsets.clear();
+  m_end.clear();
+  m_childOffsets.clear();
+  m_children.clear();
+}
+
+Fatras::TruthGraph::Index
+Fatras::TruthGraph::addVertex(const Acts::Vector3D &position, double time,
+                              Index incoming) {
+  m_vertices.push_back({position, time, incoming});
+  return static_cast<Index>(m_vertices.size() - 1);
+}
+
+void Fatras::TruthGraph::addOutgoing(Index vertex, Index particle) {
+  m_edges.emplace_back(vertex, particle);
+}
+
+void Fatras::TruthGraph::build() {
+  const std::size_t nVertices = m_vertices.size();
+  // the particle index space covers every recorded particle
+  std::size_t nParticles = 0;
+  for (const auto &edge : m_edges) {
+    nParticles = std::max<std::size_t>(nParticles, edge.second + 1);
+  }
+  for (const auto &vertex : m_vertices) {
+    if (vertex.incoming != invalid) {
+      nParticles = std::max<std::size_t>(nParticles, vertex.incoming + 1);
+    }
+  }
+
+  // vertex -> outgoing, a stable counting sort of the edges
+  m_outgoingOffsets.assign(nVertices + 1, 0);
+  for (const auto &edge : m_edges) {
+    ++m_outgoingOffsets[edge.first];
+  }
+  countsToOffsets(m_outgoingOffsets);
+  m_outgoing.resize(m_edges.size());
+  m_production.assign(nParticles, invalid);
+  {
+    std::vector<Index> fill(m_outgoingOffsets.begin(),
+                            m_outgoingOffsets.end() - 1);
+    for (const auto &edge : m_edges) {
+      m_outgoing[fill[edge.first]++] = edge.second;
+      m_production[edge.second] = edge.first;
+    }
+  }
+
+  // particle -> end vertices and children, in vertex order
+  m_endOffsets.assign(nParticles + 1, 0);
+  m_childOffsets.assign(nParticles + 1, 0);
+  for (Index v = 0; v < nVertices; ++v) {
+    Index incoming = m_vertices[v].incoming;
+    if (incoming != invalid) {
+      ++m_endOffsets[incoming];
+      m_childOffsets[incoming] += outgoing(v).size();
+    }
+  }
+  countsToOffsets(m_endOffsets);
+  countsToOffsets(m_childOffsets);
+  m_end.resize(m_endOffsets.back());
+  m_children.resize(m_childOffsets.back());
+  {
+    std::vector<Index> endFill(m_endOffsets.begin(), m_endOffsets.end() - 1);
+    std::vector<Index> childFill(m_childOffsets.begin(),
+                                 m_childOffsets.end() - 1);
+    for (Index v = 0; v < nVertices; ++v) {
+      Index incoming = m_vertices[v].incoming;
+      if (incoming == invalid) {
+        continue;
+      }
+      m_end[endFill[incoming]++] = v;
+      for (Index child : outgoing(v)) {
+        m_children[childFill[incoming]++] = child;
+      }
+    }
+  }
+}
@@ -0,0 +1,141 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/// Compare the compile-time and the run-time composed physics lists
+///
+/// Usage: PhysicsListBenchmark [particles] [steps] [repetitions]
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/DynamicPhysicsList.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/Process.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheBloch.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheHeitler.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include "Fatras/Physics/Scattering/Scattering.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/KinematicCasts.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include "Fatras/Selectors/SelectorHelpers.hpp"
+#include "Particle.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace Fatras;
+
+typedef std::mt19937 Generator;
+typedef Test::Particle Particle;
+
+typedef SelectorListAND<> All;
+typedef SelectorListAND<ChargedSelector> Charged;
+typedef SelectorListAND<AbsPdgSelector<11>> Electron;
+typedef Min<casts::p> Threshold;
+
+typedef Process<BetheBloch, Charged, Threshold, All> IonisationProcess;
+typedef Process<BetheHeitler, Electron, Threshold, All> RadiationProcess;
+typedef Process<Scattering<Highland>, Charged, All, All> ScatteringProcess;
+
+typedef PhysicsList<IonisationProcess, RadiationProcess, ScatteringProcess>
+    StaticList;
+typedef DynamicPhysicsList<IonisationProcess, RadiationProcess,
+                           ScatteringProcess>
+    DynamicList;
+
+/// Run the physics list on all particles and return the time in seconds
+template <typename physics_list_t>
+double run(const physics_list_t &physicsList,
+           const Acts::MaterialProperties &detector,
+           const std::vector<Particle> &particles, std::size_t steps,
+           double &checksum) {
+  Generator generator(42);
+  std::vector<Particle> out;
+  auto start = std::chrono::steady_clock::now();
+  for (auto particle : particles) {
+    for (std::size_t step = 0; step < steps; ++step) {
+      if (physicsList(generator, detector, particle, out)) {
+        break;
+      }
+    }
+    checksum += particle.p();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  std::size_t nParticles = (argc > 1) ? std::atol(argv[1]) : 10000;
+  std::size_t nSteps = (argc > 2) ? std::atol(argv[2]) : 100;
+  std::size_t nRepetitions = (argc > 3) ? std::atol(argv[3]) : 5;
+
+  Acts::Material silicon(95.7, 465.2, 28.03, 14., 2.32e-3);
+  Acts::MaterialProperties detector(silicon, 0.3 * Acts::units::_mm);
+
+  // a mix of electrons, muons and pions
+  Generator generator(23);
+  std::uniform_real_distribution<double> momentum(0.5, 10.);
+  const int pdgs[] = {11, 13, 211};
+  const double masses[] = {0.511 * Acts::units::_MeV,
+                           105.658367 * Acts::units::_MeV,
+                           139.57 * Acts::units::_MeV};
+  std::vector<Particle> particles;
+  for (std::size_t i = 0; i < nParticles; ++i) {
+    Acts::Vector3D direction(momentum(generator), momentum(generator),
+                             momentum(generator));
+    particles.emplace_back(Acts::Vector3D(0., 0., 0.),
+                           momentum(generator) * Acts::units::_GeV *
+                               direction.normalized(),
+                           masses[i % 3], -1., pdgs[i % 3], i + 1);
+  }
+
+  StaticList staticList;
+  DynamicList dynamicList;
+  dynamicList.add<IonisationProcess>();
+  dynamicList.add<RadiationProcess>();
+  dynamicList.add<ScatteringProcess>();
+  for (auto threshold : {&staticList.get<IonisationProcess>().selectorOut,
+                         &staticList.get<RadiationProcess>().selectorOut,
+                         &dynamicList.find<IonisationProcess>()->selectorOut,
+                         &dynamicList.find<RadiationProcess>()->selectorOut}) {
+    threshold->valMin = 50. * Acts::units::_MeV;
+  }
+
+  // best of several repetitions, alternating to share warm-up effects
+  double staticTime = 1e30, dynamicTime = 1e30;
+  double staticSum = 0., dynamicSum = 0.;
+  for (std::size_t r = 0; r < nRepetitions; ++r) {
+    staticSum = dynamicSum = 0.;
+    staticTime = std::min(
+        staticTime, run(staticList, detector, particles, nSteps, staticSum));
+    dynamicTime = std::min(dynamicTime, run(dynamicList, detector, particles,
+                                            nSteps, dynamicSum));
+  }
+
+  double nCalls = double(nParticles) * nSteps;
+  std::cout << "particles " << nParticles << ", steps " << nSteps
+            << ", repetitions " << nRepetitions << '\n';
+  std::cout << "static  physics list: " << staticTime << " s, "
+            << 1e9 * staticTime / nCalls << " ns/step" << '\n';
+  std::cout << "dynamic physics list: " << dynamicTime << " s, "
+            << 1e9 * dynamicTime / nCalls << " ns/step" << '\n';
+  std::cout << "relative overhead:    "
+            << 100. * (dynamicTime - staticTime) / staticTime << " %" << '\n';
+
+  // both lists have to simulate exactly the same
+  if (staticSum != dynamicSum) {
+    std::cerr << "results differ: " << staticSum << " vs " << dynamicSum
+              << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -13,19 +13,11 @@
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Helpers.hpp"
 #include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Particle.hpp"
 #include <cmath>
 
 namespace Fatras {
 
-/// Typedef the pdg code
-typedef int pdg_type;
-
-/// Typedef the process code
-typedef unsigned int process_code;
-
-/// Typedef barcode
-typedef unsigned int barcode_type;
-
 namespace Test {
 
 /// @brief Particle for testing acts-fatras core functionality
@@ -65,6 +57,18 @@ public:
     m_timeLimit = timeLimit;
   }
 
+  /// @brief Set the proper time limit, i.e. the sampled decay time
+  ///
+  /// @param properTimeLimit the proper time limit to be passed
+  void setProperTimeLimit(double properTimeLimit) {
+    m_properTimeLimit = properTimeLimit;
+  }
+
+  /// @brief Set the barcode
+  ///
+  /// @param barcode the barcode to be set
+  void setBarcode(barcode_type barcode) { m_barcode = barcode; }
+
   /// @brief Update the particle with applying energy loss
   ///
   /// @param deltaE is the energy loss to be applied
@@ -78,7 +82,7 @@ public:
   /// @param deltaE is the energy loss to be applied
   void energyLoss(double deltaE) {
     // particle falls to rest
-    if (m_E - deltaE < m_m) {
+    if (m_E - deltaE <= m_m) {
       m_E = m_m;
       m_p = 0.;
       m_pT = 0.;
@@ -86,6 +90,7 @@ public:
       m_gamma = 1.;
       m_momentum = Acts::Vector3D(0., 0., 0.);
       m_alive = false;
+      return;
     }
     // updatet the parameters
     m_E -= deltaE;
@@ -109,13 +114,13 @@ public:
   bool update(const Acts::Vector3D &position, const Acts::Vector3D &momentum,
               double deltaPahtX0 = 0., double deltaPahtL0 = 0.,
               double deltaTime = 0.) {
+    double deltaPath = (position - m_position).norm();
     m_position = position;
     m_momentum = momentum;
     m_p = momentum.norm();
     if (m_p) {
       m_pT = Acts::VectorHelpers::perp(momentum);
       m_E = std::sqrt(m_p * m_p + m_m * m_m);
-      m_timeStamp += deltaTime;
       m_beta = (m_p / m_E);
       m_gamma = (m_E / m_m);
 
@@ -123,14 +128,30 @@ public:
       m_pathInX0 += deltaPahtX0;
       m_pathInL0 += deltaPahtL0;
       m_timeStamp += deltaTime;
+      // proper time elapsed along the path
+      m_properTime += deltaPath * m_m / (m_p * Acts::units::_c);
       if (m_pathInX0 >= m_limitInX0 || m_pathInL0 >= m_limitInL0 ||
-          m_timeStamp > m_timeLimit) {
+          m_timeStamp > m_timeLimit || m_properTime >= m_properTimeLimit) {
         m_alive = false;
       }
     }
     return !m_alive;
   }
 
+  /// @brief Advance the proper time along a path the position update
+  /// does not follow, e.g. the turns of a helix
+  ///
+  /// @param deltaProperTime The proper time elapsed
+  ///
+  /// @return break condition
+  bool advanceProperTime(double deltaProperTime) {
+    m_properTime += deltaProperTime;
+    if (m_properTime >= m_properTimeLimit) {
+      m_alive = false;
+    }
+    return !m_alive;
+  }
+
   /// @brief Access methods: position
   const Acts::Vector3D &position() const { return m_position; }
 
@@ -176,8 +197,17 @@ public:
   /// @brief Access methods: barcode
   const double limitInL0() const { return m_limitInL0; }
 
+  /// @brief Access methods: time
+  const double time() const { return m_timeStamp; }
+
+  /// @brief Access methods: proper time
+  const double properTime() const { return m_properTime; }
+
+  /// @brief Access methods: proper time limit
+  const double properTimeLimit() const { return m_properTimeLimit; }
+
   /// @brief boolean operator indicating the particle to be alive
-  operator bool() { return m_alive; }
+  operator bool() const { return m_alive; }
 
 private:
   Acts::Vector3D m_position = Acts::Vector3D(0., 0., 0.); //!< kinematic info
@@ -202,6 +232,10 @@ private:
   double m_timeStamp = 0.; //!< passed time elapsed
   double m_timeLimit = std::numeric_limits<double>::max(); // time limit
 
+  double m_properTime = 0.; //!< passed proper time
+  double m_properTimeLimit =
+      std::numeric_limits<double>::max(); //!< proper time limit
+
   bool m_alive = true; //!< the particle is alive
 };
 
@@ -0,0 +1,154 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE BinaryStream Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/IO/BinaryStream.hpp"
+#include "Fatras/IO/StreamingOutput.hpp"
+#include "Particle.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+/// A simple hit
+struct Hit {
+  Acts::geo_id_value module = 0;
+  barcode_type barcode = 0;
+  Acts::Vector3D position = Acts::Vector3D(0., 0., 0.);
+  double time = 0.;
+};
+
+/// The conversion of a hit into a record
+struct HitConverter {
+  HitRecord operator()(const Hit &hit) const {
+    HitRecord record;
+    record.geoID = hit.module;
+    record.barcode = hit.barcode;
+    record.x = hit.position.x();
+    record.y = hit.position.y();
+    record.z = hit.position.z();
+    record.time = hit.time;
+    return record;
+  }
+};
+
+// This tests blocks written through many buffer hand-overs
+BOOST_AUTO_TEST_CASE(BinaryStream_blocks_test_) {
+  const std::string path = "BinaryStreamBlocks.bin";
+  // a small buffer, such that the writer thread is busy most of the time
+  {
+    AsyncWriter writer(path, 256);
+    for (std::uint32_t block = 0; block < 500; ++block) {
+      std::vector<std::uint64_t> values(block % 17, block);
+      writer.write(block % 3, values);
+    }
+    writer.close();
+    BOOST_CHECK(writer.bytesWritten() > 0);
+  }
+
+  BlockReader reader(path);
+  std::uint32_t block = 0;
+  while (reader.next()) {
+    // empty blocks are not written
+    while (block % 17 == 0) {
+      ++block;
+    }
+    BOOST_CHECK_EQUAL(reader.header().tag, block % 3);
+    auto values = reader.records<std::uint64_t>();
+    BOOST_CHECK_EQUAL(values.size(), block % 17);
+    BOOST_CHECK(values == std::vector<std::uint64_t>(block % 17, block));
+    BOOST_CHECK_THROW(reader.records<std::uint32_t>(), std::runtime_error);
+    ++block;
+  }
+  BOOST_CHECK_EQUAL(block, 500u);
+  std::remove(path.c_str());
+}
+
+// This tests the streaming of the simulation output
+BOOST_AUTO_TEST_CASE(BinaryStream_output_test_) {
+  const std::string path = "BinaryStreamOutput.bin";
+  {
+    AsyncWriter writer(path, 1024);
+    StreamingOutput<HitConverter> output(writer, HitConverter(), 10);
+    for (barcode_type barcode = 1; barcode <= 25; ++barcode) {
+      Particle particle(Acts::Vector3D(0., 0., barcode),
+                        Acts::Vector3D(1., 0., 0.), 0.1, -1., 13, barcode,
+                        0.5 * barcode);
+      for (Acts::geo_id_value module = 1; module <= 4; ++module) {
+        output.insert(Hit{module, barcode,
+                          Acts::Vector3D(10. * module, 0., barcode), 1.});
+      }
+      output.finished(particle);
+    }
+    output.flush();
+  }
+
+  BlockReader reader(path);
+  std::vector<HitRecord> hits;
+  std::vector<ParticleRecord> particles;
+  while (reader.next()) {
+    if (reader.header().tag == stream::Hits) {
+      auto records = reader.records<HitRecord>();
+      BOOST_CHECK(records.size() <= 10u);
+      hits.insert(hits.end(), records.begin(), records.end());
+    } else if (reader.header().tag == stream::Particles) {
+      auto records = reader.records<ParticleRecord>();
+      particles.insert(particles.end(), records.begin(), records.end());
+    }
+  }
+  BOOST_CHECK_EQUAL(hits.size(), 100u);
+  BOOST_CHECK_EQUAL(particles.size(), 25u);
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    BOOST_CHECK_EQUAL(hits[i].barcode, i / 4 + 1);
+    BOOST_CHECK_EQUAL(hits[i].geoID, i % 4 + 1);
+    BOOST_CHECK_EQUAL(hits[i].x, 10. * (i % 4 + 1));
+  }
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    BOOST_CHECK_EQUAL(particles[i].barcode, i + 1);
+    BOOST_CHECK_EQUAL(particles[i].pdg, 13);
+    BOOST_CHECK_EQUAL(particles[i].z, float(i + 1));
+    BOOST_CHECK_EQUAL(particles[i].time, 0.5f * (i + 1));
+  }
+  std::remove(path.c_str());
+}
+
+// This tests the error handling
+BOOST_AUTO_TEST_CASE(BinaryStream_errors_test_) {
+  BOOST_CHECK_THROW(AsyncWriter("/nonexistent/directory/file.bin"),
+                    std::runtime_error);
+
+  const std::string path = "BinaryStreamInvalid.bin";
+  {
+    std::ofstream file(path);
+    file << "this is not a stream file";
+  }
+  BOOST_CHECK_THROW(BlockReader reader(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,209 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE ColumnarFile Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/IO/ColumnarFile.hpp"
+#include "Fatras/IO/ColumnarOutput.hpp"
+#include "Particle.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+/// A simple hit
+struct Hit {
+  Acts::geo_id_value module = 0;
+  barcode_type barcode = 0;
+  Acts::Vector3D position = Acts::Vector3D(0., 0., 0.);
+  double time = 0.;
+  double deposit = 0.;
+};
+
+/// The conversion of a hit into a record
+struct HitConverter {
+  HitRecord operator()(const Hit &hit) const {
+    HitRecord record;
+    record.geoID = hit.module;
+    record.barcode = hit.barcode;
+    record.x = hit.position.x();
+    record.y = hit.position.y();
+    record.z = hit.position.z();
+    record.time = hit.time;
+    record.depositedEnergy = hit.deposit;
+    return record;
+  }
+};
+
+// This tests the columns of all types and their alignment
+BOOST_AUTO_TEST_CASE(ColumnarFile_columns_test_) {
+  const std::string path = "ColumnarFileColumns.bin";
+  std::vector<std::uint64_t> ids = {1, 2, 3};
+  std::vector<std::int32_t> pdgs = {11, -13, 211, 22, 2112};
+  std::vector<float> empty;
+  std::vector<double> values = {0.5, 1.5};
+  {
+    ColumnarWriter writer;
+    writer.add("ids", ids);
+    writer.add("pdgs", pdgs);
+    writer.add("empty", empty);
+    writer.add("values", values);
+    BOOST_CHECK_THROW(writer.add("ids", ids), std::invalid_argument);
+    BOOST_CHECK_THROW(writer.add("", ids), std::invalid_argument);
+    BOOST_CHECK_THROW(writer.add(std::string(48, 'x'), ids),
+                      std::invalid_argument);
+    writer.write(path);
+  }
+
+  ColumnarReader reader(path);
+  BOOST_CHECK(reader.names() ==
+              std::vector<std::string>({"ids", "pdgs", "empty", "values"}));
+  BOOST_CHECK(reader.has("pdgs"));
+  BOOST_CHECK(not reader.has("time"));
+
+  auto readIds = reader.column<std::uint64_t>("ids");
+  auto readPdgs = reader.column<std::int32_t>("pdgs");
+  auto readValues = reader.column<double>("values");
+  BOOST_CHECK(std::vector<std::uint64_t>(readIds.begin(), readIds.end()) ==
+              ids);
+  BOOST_CHECK(std::vector<std::int32_t>(readPdgs.begin(), readPdgs.end()) ==
+              pdgs);
+  BOOST_CHECK(std::vector<double>(readValues.begin(), readValues.end()) ==
+              values);
+  BOOST_CHECK(reader.column<float>("empty").empty());
+  // the columns are read in place
+  for (const void *data :
+       {static_cast<const void *>(readIds.data()),
+        static_cast<const void *>(readPdgs.data()),
+        static_cast<const void *>(readValues.data())}) {
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(data) %
+                          columnar::alignment,
+                      0u);
+  }
+
+  BOOST_CHECK_THROW(reader.column<float>("ids"), std::runtime_error);
+  BOOST_CHECK_THROW(reader.column<double>("time"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+// This tests that an element size not matching the type is rejected
+BOOST_AUTO_TEST_CASE(ColumnarFile_element_size_test_) {
+  const std::string path = "ColumnarFileElementSize.bin";
+  {
+    ColumnarWriter writer;
+    writer.add("values", std::vector<double>{0.5, 1.5});
+    writer.write(path);
+  }
+  BOOST_CHECK_NO_THROW(ColumnarReader{path});
+
+  // a double column claiming four byte elements
+  columnar::ColumnHeader header;
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(sizeof(columnar::FileHeader));
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    header.elementSize = 4;
+    file.seekp(sizeof(columnar::FileHeader));
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  BOOST_CHECK_THROW(ColumnarReader{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+// This tests the round trip of the simulation output
+BOOST_AUTO_TEST_CASE(ColumnarFile_output_test_) {
+  const std::string path = "ColumnarFileOutput.bin";
+  ColumnarOutput<HitConverter> output;
+  for (barcode_type barcode = 1; barcode <= 10; ++barcode) {
+    Particle particle(Acts::Vector3D(0., 0., barcode),
+                      Acts::Vector3D(1., 2., 3.), 0.1, -1., 13, barcode,
+                      0.25 * barcode);
+    for (Acts::geo_id_value module = 1; module <= 3; ++module) {
+      output.insert(Hit{module, barcode,
+                        Acts::Vector3D(10. * module, 0., barcode), 1.,
+                        0.5 * module});
+    }
+    output.finished(particle);
+  }
+  output.write(path);
+
+  ColumnarReader reader(path);
+  auto geoIDs = reader.column<std::uint64_t>("hit.geoID");
+  auto hitBarcodes = reader.column<std::uint64_t>("hit.barcode");
+  auto hitX = reader.column<double>("hit.x");
+  auto deposits = reader.column<float>("hit.depositedEnergy");
+  BOOST_CHECK_EQUAL(geoIDs.size(), 30u);
+  BOOST_CHECK_EQUAL(deposits.size(), 30u);
+  for (std::size_t i = 0; i < geoIDs.size(); ++i) {
+    BOOST_CHECK_EQUAL(geoIDs[i], output.hits()[i].geoID);
+    BOOST_CHECK_EQUAL(hitBarcodes[i], output.hits()[i].barcode);
+    BOOST_CHECK_EQUAL(hitX[i], output.hits()[i].x);
+    BOOST_CHECK_EQUAL(deposits[i], 0.5f * (i % 3 + 1));
+  }
+
+  auto barcodes = reader.column<std::uint64_t>("particle.barcode");
+  auto pdgs = reader.column<std::int32_t>("particle.pdg");
+  auto pz = reader.column<float>("particle.pz");
+  auto times = reader.column<float>("particle.time");
+  BOOST_CHECK_EQUAL(barcodes.size(), 10u);
+  for (std::size_t i = 0; i < barcodes.size(); ++i) {
+    BOOST_CHECK_EQUAL(barcodes[i], i + 1);
+    BOOST_CHECK_EQUAL(pdgs[i], 13);
+    BOOST_CHECK_EQUAL(pz[i], 3.f);
+    BOOST_CHECK_EQUAL(times[i], 0.25f * (i + 1));
+  }
+  std::remove(path.c_str());
+}
+
+// This tests the rejection of invalid files
+BOOST_AUTO_TEST_CASE(ColumnarFile_errors_test_) {
+  BOOST_CHECK_THROW(ColumnarReader("nonexistent.bin"), std::runtime_error);
+
+  const std::string path = "ColumnarFileInvalid.bin";
+  {
+    std::ofstream file(path);
+    file << "this is not a columnar file";
+  }
+  BOOST_CHECK_THROW(ColumnarReader reader(path), std::runtime_error);
+
+  // a truncated file with a valid header
+  {
+    ColumnarWriter writer;
+    writer.add("values", std::vector<double>(100, 1.));
+    writer.write(path);
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes(200);
+    in.read(bytes.data(), bytes.size());
+    in.close();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  BOOST_CHECK_THROW(ColumnarReader reader(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+} // namespace Test
+} // namespace Fatras
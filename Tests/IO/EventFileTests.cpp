@@ -0,0 +1,135 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE EventFile Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Fatras/IO/EventFile.hpp"
+#include "Particle.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+const std::string eventText = R"(# two events
+event
+vertex
+particle 1 13 -1 0.105 0 0 0 0 1 0 10
+particle 2 -211 -1 0.139 0 0 0 0 0 1 5
+
+vertex
+particle 3 22 0 0 1 2 3 0.5 0 0 2
+event
+vertex
+event
+vertex
+particle 4 11 -1 0.000511 0 0 -1 0 0.1 0.2 0.3
+)";
+
+// This tests the conversion and the event collection
+BOOST_AUTO_TEST_CASE(EventFile_read_test_) {
+  const std::string path = "EventFileRead.bin";
+  std::istringstream text(eventText);
+  BOOST_CHECK_EQUAL(convertEventText(text, path), 3u);
+
+  EventFileReader reader(path);
+  BOOST_CHECK_EQUAL(reader.size(), 3u);
+
+  auto event = reader.event<Particle>(0);
+  BOOST_CHECK_EQUAL(event.size(), 2u);
+  auto vertex = event.begin();
+  BOOST_CHECK_EQUAL(vertex->outgoing.size(), 2u);
+  Particle muon = vertex->outgoing[0];
+  BOOST_CHECK_EQUAL(muon.barcode(), 1u);
+  BOOST_CHECK_EQUAL(muon.pdg(), 13);
+  BOOST_CHECK_EQUAL(muon.q(), -1.);
+  BOOST_CHECK_EQUAL(muon.m(), 0.105);
+  BOOST_CHECK_EQUAL(muon.momentum(), Acts::Vector3D(1., 0., 10.));
+  BOOST_CHECK_EQUAL(vertex->outgoing[1].pdg(), -211);
+  ++vertex;
+  Particle photon = vertex->outgoing[0];
+  BOOST_CHECK_EQUAL(photon.position(), Acts::Vector3D(1., 2., 3.));
+  BOOST_CHECK_EQUAL(photon.time(), 0.5);
+
+  // the secondaries follow the primaries of their vertex
+  std::vector<Particle> secondaries(3, photon);
+  secondaries[2].setBarcode(42);
+  vertex->outgoing_insert(secondaries);
+  BOOST_CHECK_EQUAL(vertex->outgoing.size(), 4u);
+  BOOST_CHECK_EQUAL(vertex->outgoing.primaries(), 1u);
+  BOOST_CHECK_EQUAL(vertex->outgoing[3].barcode(), 42u);
+  BOOST_CHECK_EQUAL(vertex->outgoing.secondaries().size(), 3u);
+
+  // an event with an empty vertex
+  auto empty = reader.event<Particle>(1);
+  BOOST_CHECK_EQUAL(empty.size(), 1u);
+  BOOST_CHECK_EQUAL(empty.begin()->outgoing.size(), 0u);
+
+  auto last = reader.event<Particle>(2);
+  BOOST_CHECK_EQUAL(last.begin()->outgoing[0].barcode(), 4u);
+
+  // the events 1 and 2 were requested in the background
+  for (int i = 0; i < 1000 and reader.prefetched() < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  BOOST_CHECK_EQUAL(reader.prefetched(), 2u);
+  std::remove(path.c_str());
+}
+
+// This tests the rejection of malformed input
+BOOST_AUTO_TEST_CASE(EventFile_errors_test_) {
+  const std::string path = "EventFileErrors.bin";
+  for (const char *text :
+       {"vertex\n", "event\nparticle 1 13 -1 0.1 0 0 0 0 1 0 0\n",
+        "event\nvertex\nparticle 1 13 -1 0.1 0 0 0\n", "event\nhit\n"}) {
+    std::istringstream input(text);
+    BOOST_CHECK_THROW(convertEventText(input, path), std::runtime_error);
+  }
+
+  BOOST_CHECK_THROW(EventFileReader("nonexistent.bin"), std::runtime_error);
+  {
+    std::ofstream file(path);
+    file << "this is not an event file";
+  }
+  BOOST_CHECK_THROW(EventFileReader reader(path), std::runtime_error);
+
+  // a file which is too short for its tables
+  {
+    std::istringstream input(eventText);
+    convertEventText(input, path);
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes(100);
+    in.read(bytes.data(), bytes.size());
+    in.close();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  BOOST_CHECK_THROW(EventFileReader reader(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+} // namespace Test
+} // namespace Fatras
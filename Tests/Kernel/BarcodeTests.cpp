@@ -0,0 +1,141 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Barcode Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Fatras/Kernel/Barcode.hpp"
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+// the encoding is usable at compile time
+static_assert(Barcode(3, 7).primary() == 7);
+static_assert(Barcode(3, 7).descendant(5).generation() == 1);
+static_assert(Barcode(3, 7, 2, 9).primaryBarcode() == Barcode(3, 7));
+static_assert(Barcode().value() == 0);
+static_assert(not Barcode(1).isValid() and Barcode(0, 1).isPrimary());
+
+/// Simulate the shower of one primary: every particle up to the given
+/// generation creates two secondaries
+std::vector<barcode_type> shower(Barcode primary, unsigned int generations) {
+  BarcodeAllocator allocator(primary);
+  std::vector<Barcode> particles = {primary};
+  std::vector<barcode_type> barcodes;
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    Barcode parent = particles[i];
+    if (parent.generation() == generations) {
+      continue;
+    }
+    for (int n = 0; n < 2; ++n) {
+      Barcode secondary = allocator(parent);
+      particles.push_back(secondary);
+      barcodes.push_back(secondary.value());
+    }
+  }
+  return barcodes;
+}
+
+// This tests the encoding and decoding of the components
+BOOST_AUTO_TEST_CASE(Barcode_encoding_test_) {
+  Barcode barcode(12, 345, 6, 7890);
+  BOOST_CHECK_EQUAL(barcode.vertex(), 12u);
+  BOOST_CHECK_EQUAL(barcode.primary(), 345u);
+  BOOST_CHECK_EQUAL(barcode.generation(), 6u);
+  BOOST_CHECK_EQUAL(barcode.subParticle(), 7890u);
+  BOOST_CHECK(not barcode.isPrimary());
+  BOOST_CHECK(Barcode(barcode.value()) == barcode);
+
+  // the largest values of all fields
+  Barcode largest((1u << 14) - 1, (1u << 16) - 1, (1u << 6) - 1,
+                  (1u << 28) - 1);
+  BOOST_CHECK_EQUAL(largest.value(), ~barcode_type(0));
+  BOOST_CHECK_EQUAL(largest.vertex(), (1u << 14) - 1);
+  BOOST_CHECK_EQUAL(largest.subParticle(), (1u << 28) - 1);
+
+  // the fields do not overflow into each other
+  BOOST_CHECK_THROW(Barcode(1u << 14, 0), std::out_of_range);
+  BOOST_CHECK_THROW(Barcode(0, 1u << 16), std::out_of_range);
+  BOOST_CHECK_THROW(Barcode(0, 0, 1u << 6), std::out_of_range);
+  BOOST_CHECK_THROW(Barcode(0, 0, 0, 1u << 28), std::out_of_range);
+
+  // the ordering groups the particles by vertex and primary
+  BOOST_CHECK(Barcode(1, 2, 5, 100) < Barcode(1, 3));
+  BOOST_CHECK(Barcode(1, 65535, 5, 100) < Barcode(2, 0));
+}
+
+// This tests the descendants and the allocator
+BOOST_AUTO_TEST_CASE(Barcode_allocator_test_) {
+  Barcode primary(2, 17);
+  BOOST_CHECK(primary.isPrimary());
+
+  BarcodeAllocator allocator(primary);
+  Barcode first = allocator(primary);
+  Barcode second = allocator(first);
+  BOOST_CHECK_EQUAL(allocator.allocated(), 2u);
+  BOOST_CHECK(first.primaryBarcode() == primary);
+  BOOST_CHECK(second.primaryBarcode() == primary);
+  BOOST_CHECK_EQUAL(first.generation(), 1u);
+  BOOST_CHECK_EQUAL(second.generation(), 2u);
+  BOOST_CHECK(first != second);
+
+  // the generation saturates, the barcodes stay unique
+  Barcode deep(2, 17, (1u << 6) - 1, 5);
+  BOOST_CHECK_EQUAL(deep.descendant(6).generation(), (1u << 6) - 1);
+  BOOST_CHECK(deep.descendant(6) != deep);
+
+  // all barcodes of a shower are unique
+  auto barcodes = shower(primary, 8);
+  BOOST_CHECK_EQUAL(barcodes.size(), 510u);
+  std::set<barcode_type> unique(barcodes.begin(), barcodes.end());
+  BOOST_CHECK_EQUAL(unique.size(), barcodes.size());
+}
+
+// This tests that 0 and plain sequential barcodes are not hierarchical
+BOOST_AUTO_TEST_CASE(Barcode_plain_test_) {
+  BOOST_CHECK(not Barcode().isValid());
+  BOOST_CHECK(not Barcode().isPrimary());
+  BOOST_CHECK_THROW(BarcodeAllocator{Barcode()}, std::invalid_argument);
+  for (barcode_type plain : {1u, 2u, 3u, 1000u}) {
+    BOOST_CHECK(not Barcode(plain).isValid());
+    BOOST_CHECK(not Barcode(plain).isPrimary());
+    BOOST_CHECK_THROW(BarcodeAllocator(Barcode(plain)), std::invalid_argument);
+  }
+  // vertex 0 is a valid vertex number
+  BOOST_CHECK(Barcode(0, 1).isValid());
+  BOOST_CHECK(Barcode(0, 1).isPrimary());
+  BOOST_CHECK(Barcode(0, 1).value() != 0u);
+
+  // the allocators of different primaries give disjoint barcodes
+  std::set<barcode_type> unique;
+  for (barcode_type primary = 1; primary <= 64; ++primary) {
+    auto barcodes = shower(Barcode(0, primary), 6);
+    unique.insert(barcodes.begin(), barcodes.end());
+  }
+  BOOST_CHECK_EQUAL(unique.size(), 64u * 126);
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,198 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE CostModel Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/CostModel.hpp"
+#include "Particle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+Particle makeParticle(int pdg, double q, double pT, double pz) {
+  return Particle(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(pT, 0., pz),
+                  0.1, q, pdg, 1);
+}
+
+// This tests the makespan of a dispatch order
+BOOST_AUTO_TEST_CASE(CostModel_tail_test_) {
+  // the long one last: two workers are busy with four short ones first
+  auto late = tailReport({1., 1., 1., 1., 4.}, 2);
+  BOOST_CHECK_EQUAL(late.nParticles, 5u);
+  BOOST_CHECK_EQUAL(late.total, 8.);
+  BOOST_CHECK_EQUAL(late.longest, 4.);
+  BOOST_CHECK_EQUAL(late.lowerBound, 4.);
+  BOOST_CHECK_EQUAL(late.makespan, 6.);
+  // longest processing time first reaches the bound
+  auto first = tailReport({4., 1., 1., 1., 1.}, 2);
+  BOOST_CHECK_EQUAL(first.makespan, 4.);
+  BOOST_CHECK_EQUAL(first.efficiency(), 1.);
+
+  auto empty = tailReport({}, 4);
+  BOOST_CHECK_EQUAL(empty.makespan, 0.);
+  BOOST_CHECK_EQUAL(empty.efficiency(), 1.);
+}
+
+// This tests the learning and the fallbacks of the estimate
+BOOST_AUTO_TEST_CASE(CostModel_learn_test_) {
+  CostModel::Config cfg;
+  cfg.prior = 0.5;
+  CostModel model(cfg);
+
+  auto muon = makeParticle(13, -1., 10., 0.);
+  auto forwardMuon = makeParticle(13, -1., 10., 1000.);
+  auto pion = makeParticle(211, 1., 10., 0.);
+  BOOST_CHECK_EQUAL(model.estimate(muon), 0.5);
+
+  model.learn(muon, 2.);
+  model.learn(muon, 4.);
+  // the estimates only change when the model is frozen
+  BOOST_CHECK_EQUAL(model.estimate(muon), 0.5);
+  model.freeze();
+  BOOST_CHECK_EQUAL(model.estimate(muon), 3.);
+  // another bin of the same class uses the class mean
+  BOOST_CHECK_EQUAL(model.estimate(forwardMuon), 3.);
+  model.learn(forwardMuon, 9.);
+  BOOST_CHECK_EQUAL(model.estimate(forwardMuon), 3.);
+  model.freeze();
+  BOOST_CHECK_EQUAL(model.estimate(forwardMuon), 9.);
+  BOOST_CHECK_EQUAL(model.estimate(muon), 3.);
+  // other classes are not affected
+  BOOST_CHECK_EQUAL(model.estimate(pion), 0.5);
+  // the pT is binned logarithmically, the class mean includes all bins
+  BOOST_CHECK_EQUAL(model.estimate(makeParticle(13, 1., 11., 0.)), 3.);
+  BOOST_CHECK_EQUAL(model.estimate(makeParticle(13, 1., 0.1, 0.)), 5.);
+}
+
+// This tests that the energy separates heavy from light particles
+BOOST_AUTO_TEST_CASE(CostModel_energy_test_) {
+  CostModel model;
+  auto pion = makeParticle(211, 1., 0.02, 0.);
+  Particle deuteron(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(0.02, 0., 0.),
+                    1.876, 1., 1000010020, 2);
+  model.learn(pion, 1.);
+  model.learn(deuteron, 5.);
+  model.freeze();
+  BOOST_CHECK_EQUAL(model.estimate(pion), 1.);
+  BOOST_CHECK_EQUAL(model.estimate(deuteron), 5.);
+}
+
+// This tests that a well populated bin follows a changing time
+BOOST_AUTO_TEST_CASE(CostModel_memory_test_) {
+  CostModel::Config cfg;
+  cfg.memory = 10.;
+  CostModel model(cfg);
+  auto pion = makeParticle(211, 1., 1., 0.);
+  for (int i = 0; i < 1000; ++i) {
+    model.learn(pion, 1.);
+  }
+  for (int i = 0; i < 100; ++i) {
+    model.learn(pion, 2.);
+  }
+  model.freeze();
+  BOOST_CHECK_CLOSE(model.estimate(pion), 2., 0.01);
+}
+
+// This tests that the learned order shortens the event tail
+BOOST_AUTO_TEST_CASE(CostModel_schedule_test_) {
+  CostModel::Config cfg;
+  cfg.nWorkers = 16;
+  CostModel model(cfg);
+
+  // expensive high pT hadrons among many cheap electrons
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<double> logPT(-1., 2.);
+  std::vector<Particle> particles;
+  for (int i = 0; i < 400; ++i) {
+    bool hadron = i % 40 == 39;
+    particles.push_back(makeParticle(hadron ? 211 : 11, hadron ? 1. : -1.,
+                                     std::pow(10., logPT(generator)), 0.));
+  }
+  auto time = [](const Particle &particle) {
+    return (particle.pdg() == 211 ? 100. : 1.) *
+           (1. + std::log10(particle.pT()) + 1.);
+  };
+  for (const auto &particle : particles) {
+    model.learn(particle, time(particle));
+  }
+  model.freeze();
+
+  std::vector<std::size_t> order(particles.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return model.estimate(particles[a]) >
+                            model.estimate(particles[b]);
+                   });
+  std::vector<double> arrival;
+  std::vector<double> scheduled;
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    arrival.push_back(time(particles[i]));
+    scheduled.push_back(time(particles[order[i]]));
+  }
+  model.addEvent(arrival);
+  model.addEvent(scheduled);
+  auto arrivalTail = tailReport(arrival, cfg.nWorkers);
+  auto scheduledTail = tailReport(scheduled, cfg.nWorkers);
+  BOOST_CHECK_LT(scheduledTail.makespan, arrivalTail.makespan);
+  BOOST_CHECK_GT(scheduledTail.efficiency(), 0.95);
+
+  auto report = model.report();
+  BOOST_CHECK_EQUAL(report.nEvents, 2u);
+  BOOST_CHECK_EQUAL(report.nParticles, 800u);
+  BOOST_CHECK_EQUAL(report.maxMakespan, arrivalTail.makespan);
+  BOOST_CHECK_CLOSE(report.meanMakespan(),
+                    0.5 * (arrivalTail.makespan + scheduledTail.makespan),
+                    1e-6);
+}
+
+// This tests the concurrent learning
+BOOST_AUTO_TEST_CASE(CostModel_threads_test_) {
+  CostModel model;
+  auto muon = makeParticle(13, -1., 10., 0.);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 200; ++i) {
+        model.learn(muon, 1.);
+        model.addEvent({1., 2.});
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  model.freeze();
+  BOOST_CHECK_EQUAL(model.estimate(muon), 1.);
+  BOOST_CHECK_EQUAL(model.report().nEvents, 800u);
+  BOOST_CHECK_EQUAL(model.report().nParticles, 1600u);
+}
+
+} // namespace Test
+} // namespace Fatras
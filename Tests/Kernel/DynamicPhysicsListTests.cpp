@@ -0,0 +1,157 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE DynamicPhysicsList Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/DynamicPhysicsList.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/Process.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheBloch.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheHeitler.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include "Fatras/Physics/Scattering/Scattering.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include "Particle.hpp"
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef std::mt19937 Generator;
+
+/// Physics process that does not trigger a break
+struct SterileProcess {
+
+  int some_parameter = 0;
+
+  /// call operator
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &, const detector_t &, particle_t &,
+                  std::vector<particle_t> &) const {
+    return false;
+  }
+};
+
+/// Physics process that DOES trigger a break
+struct FatalProcess {
+
+  /// call operator
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &, const detector_t &, particle_t &,
+                  std::vector<particle_t> &) const {
+    return true;
+  }
+};
+
+typedef SelectorListAND<> All;
+typedef SelectorListAND<ChargedSelector> Charged;
+typedef SelectorListAND<AbsPdgSelector<11>> Electron;
+
+typedef Process<BetheBloch, Charged, All, All> IonisationProcess;
+typedef Process<BetheHeitler, Electron, All, All> RadiationProcess;
+typedef Process<Scattering<Highland>, Charged, All, All> ScatteringProcess;
+
+// This tests the configuration of the list
+BOOST_AUTO_TEST_CASE(DynamicPhysicsList_configuration) {
+  Generator generator;
+  Acts::MaterialProperties detector;
+  Particle in;
+  std::vector<Particle> out;
+
+  typedef DynamicPhysicsList<SterileProcess, FatalProcess> List;
+  static_assert(List::typeIndex<FatalProcess>() == 1);
+
+  List list;
+  BOOST_TEST(list.empty());
+  BOOST_TEST(!list(generator, detector, in, out));
+
+  list.add<SterileProcess>().some_parameter = 2;
+  BOOST_TEST(list.size() == 1u);
+  BOOST_TEST(list.find<SterileProcess>()->some_parameter == 2);
+  BOOST_TEST(list.find<FatalProcess>() == nullptr);
+  BOOST_TEST(!list(generator, detector, in, out));
+
+  list.addByIndex(List::typeIndex<FatalProcess>());
+  BOOST_TEST(list.size() == 2u);
+  BOOST_TEST(list(generator, detector, in, out));
+  BOOST_CHECK_THROW(list.addByIndex(2), std::out_of_range);
+
+  BOOST_TEST(list.remove<FatalProcess>() == 1u);
+  BOOST_TEST(!list(generator, detector, in, out));
+  list.clear();
+  BOOST_TEST(list.empty());
+}
+
+// This tests that the dynamic list reproduces the static one
+BOOST_AUTO_TEST_CASE(DynamicPhysicsList_static) {
+  Acts::Material berilium = Acts::Material(352.8, 407., 9.012, 4., 1.848e-3);
+  Acts::MaterialProperties detector(berilium, 1. * Acts::units::_mm);
+
+  PhysicsList<IonisationProcess, RadiationProcess, ScatteringProcess>
+      staticList;
+  DynamicPhysicsList<IonisationProcess, RadiationProcess, ScatteringProcess>
+      dynamicList;
+  dynamicList.add<IonisationProcess>();
+  dynamicList.add<RadiationProcess>();
+  dynamicList.add<ScatteringProcess>();
+
+  // a muon-only configuration without the radiation loss
+  PhysicsList<IonisationProcess, ScatteringProcess> muonList;
+  DynamicPhysicsList<IonisationProcess, RadiationProcess, ScatteringProcess>
+      dynamicMuonList = dynamicList;
+  dynamicMuonList.remove<RadiationProcess>();
+
+  Acts::Vector3D position(0., 0., 0.);
+  Acts::Vector3D momentum(1. * Acts::units::_GeV, 0.5 * Acts::units::_GeV,
+                          0.);
+  for (int pdg : {11, 13}) {
+    double m = (pdg == 11) ? 0.511 * Acts::units::_MeV
+                           : 105.658367 * Acts::units::_MeV;
+    Particle staticParticle(position, momentum, m, -1., pdg, 1);
+    Particle dynamicParticle = staticParticle;
+    Generator staticGenerator(pdg);
+    Generator dynamicGenerator(pdg);
+    std::vector<Particle> out;
+    for (unsigned int step = 0; step < 50; ++step) {
+      staticList(staticGenerator, detector, staticParticle, out);
+      dynamicList(dynamicGenerator, detector, dynamicParticle, out);
+      BOOST_CHECK_EQUAL(staticParticle.p(), dynamicParticle.p());
+      BOOST_CHECK_EQUAL(staticParticle.momentum().x(),
+                        dynamicParticle.momentum().x());
+    }
+    if (pdg == 13) {
+      for (unsigned int step = 0; step < 50; ++step) {
+        muonList(staticGenerator, detector, staticParticle, out);
+        dynamicMuonList(dynamicGenerator, detector, dynamicParticle, out);
+        BOOST_CHECK_EQUAL(staticParticle.p(), dynamicParticle.p());
+      }
+    }
+  }
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,141 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE HitSink Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Fatras/Kernel/HitSink.hpp"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+/// A simple hit
+struct Hit {
+  Acts::geo_id_value module = 0;
+  unsigned int barcode = 0;
+  double time = 0.;
+
+  bool operator==(const Hit &other) const {
+    return module == other.module and barcode == other.barcode and
+           time == other.time;
+  }
+};
+
+/// The geometry identifier of a hit
+struct HitModule {
+  Acts::geo_id_value operator()(const Hit &hit) const { return hit.module; }
+};
+
+/// A total ordering of the hits on a module
+struct HitOrder {
+  bool operator()(const Hit &a, const Hit &b) const {
+    return std::tie(a.barcode, a.time) < std::tie(b.barcode, b.time);
+  }
+};
+
+/// The hits of one particle, crossing a few modules in order
+std::vector<Hit> particleHits(unsigned int barcode) {
+  std::mt19937 generator(barcode);
+  std::uniform_int_distribution<Acts::geo_id_value> module(1, 50);
+  std::vector<Hit> hits;
+  for (int i = 0; i < 12; ++i) {
+    hits.push_back({module(generator), barcode, 0.1 * i});
+  }
+  return hits;
+}
+
+// This tests the merge of sequentially filled buffers
+BOOST_AUTO_TEST_CASE(HitSink_merge_test_) {
+  HitSink<Hit, HitModule> sink(3);
+  BOOST_CHECK_EQUAL(sink.buffers(), 3u);
+
+  sink.buffer(0).insert({5, 1, 0.});
+  sink.buffer(0).insert({2, 1, 1.});
+  sink.buffer(1).insert({5, 2, 0.});
+  sink.buffer(1).insert({1, 2, 1.});
+  sink.buffer(2).insert({2, 3, 0.});
+  sink.buffer(0).insert({5, 1, 2.});
+  BOOST_CHECK_EQUAL(sink.size(), 6u);
+
+  std::vector<Hit> hits;
+  sink.merge(hits);
+  BOOST_CHECK_EQUAL(sink.size(), 0u);
+
+  // sorted by module, then by buffer, then by insertion
+  std::vector<Hit> expected = {{1, 2, 1.}, {2, 1, 1.}, {2, 3, 0.},
+                               {5, 1, 0.}, {5, 1, 2.}, {5, 2, 0.}};
+  BOOST_CHECK(hits == expected);
+
+  // the sink is reused for the next event
+  sink.buffer(2).insert({7, 4, 0.});
+  hits.clear();
+  sink.merge(hits);
+  BOOST_CHECK_EQUAL(hits.size(), 1u);
+}
+
+// This tests that concurrent filling gives a deterministic result
+BOOST_AUTO_TEST_CASE(HitSink_threads_test_) {
+  const unsigned int nParticles = 200;
+
+  // the reference: all hits sorted by module and hit ordering
+  std::vector<Hit> reference;
+  for (unsigned int barcode = 1; barcode <= nParticles; ++barcode) {
+    auto hits = particleHits(barcode);
+    reference.insert(reference.end(), hits.begin(), hits.end());
+  }
+  std::sort(reference.begin(), reference.end(),
+            [](const Hit &a, const Hit &b) {
+              return std::tie(a.module, a.barcode, a.time) <
+                     std::tie(b.module, b.barcode, b.time);
+            });
+
+  for (std::size_t nThreads : {1, 3, 8}) {
+    HitSink<Hit, HitModule, HitOrder> sink(nThreads);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        auto &buffer = sink.buffer(t);
+        for (unsigned int barcode = 1 + t; barcode <= nParticles;
+             barcode += nThreads) {
+          for (auto &hit : particleHits(barcode)) {
+            buffer.insert(hit);
+          }
+        }
+        buffer.close();
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    std::vector<Hit> hits;
+    sink.merge(hits);
+    BOOST_CHECK_EQUAL(hits.size(), reference.size());
+    BOOST_CHECK(hits == reference);
+  }
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,114 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE HitStore Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Fatras/Kernel/HitStore.hpp"
+#include <map>
+#include <random>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+/// A simple hit
+struct Hit {
+  Acts::geo_id_value module = 0;
+  unsigned int index = 0;
+};
+
+/// The geometry identifier of a hit
+struct HitModule {
+  Acts::geo_id_value operator()(const Hit &hit) const { return hit.module; }
+};
+
+typedef HitStore<Hit, HitModule> Store;
+
+static_assert(is_hit_store_v<Store>);
+static_assert(not is_hit_store_v<std::vector<Hit>>);
+
+// This tests the module ranges against a per-module regrouping
+BOOST_AUTO_TEST_CASE(HitStore_modules_test_) {
+  std::mt19937 generator(17);
+  std::uniform_int_distribution<Acts::geo_id_value> module(1, 100);
+
+  Store store;
+  std::map<Acts::geo_id_value, std::vector<unsigned int>> reference;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    Hit hit{2 * module(generator), i};
+    store.insert(hit);
+    reference[hit.module].push_back(i);
+  }
+  // staged hits are not visible
+  BOOST_CHECK(store.empty());
+  store.build();
+  BOOST_CHECK_EQUAL(store.size(), 1000u);
+  BOOST_CHECK_EQUAL(store.modules(), reference.size());
+
+  // iterate the modules in order, the hits keep the insertion order
+  std::size_t m = 0;
+  for (const auto &[geoID, indices] : reference) {
+    BOOST_CHECK_EQUAL(store.moduleID(m), geoID);
+    auto hits = store.moduleHits(m);
+    BOOST_CHECK_EQUAL(hits.size(), indices.size());
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+      BOOST_CHECK_EQUAL(hits[i].module, geoID);
+      BOOST_CHECK_EQUAL(hits[i].index, indices[i]);
+    }
+    // the lookup finds the same range
+    BOOST_CHECK(store.find(geoID).begin() == hits.begin());
+    BOOST_CHECK(store.find(geoID).end() == hits.end());
+    ++m;
+  }
+  // the ranges are contiguous and cover all hits
+  BOOST_CHECK(store.moduleHits(0).begin() == store.hits().begin());
+  BOOST_CHECK(store.moduleHits(m - 1).end() == store.hits().end());
+
+  // modules without hits
+  BOOST_CHECK(store.find(1).empty());
+  BOOST_CHECK(store.find(1000).empty());
+}
+
+// This tests that a second build merges into the store
+BOOST_AUTO_TEST_CASE(HitStore_rebuild_test_) {
+  Store store;
+  store.insert({3, 0});
+  store.insert({1, 1});
+  store.build();
+  store.insert({3, 2});
+  store.insert({2, 3});
+  store.build();
+
+  BOOST_CHECK_EQUAL(store.size(), 4u);
+  BOOST_CHECK_EQUAL(store.modules(), 3u);
+  auto module3 = store.find(3);
+  BOOST_CHECK_EQUAL(module3.size(), 2u);
+  BOOST_CHECK_EQUAL(module3[0].index, 0u);
+  BOOST_CHECK_EQUAL(module3[1].index, 2u);
+
+  store.clear();
+  BOOST_CHECK(store.empty());
+  BOOST_CHECK_EQUAL(store.modules(), 0u);
+}
+
+} // namespace Test
+} // namespace Fatras
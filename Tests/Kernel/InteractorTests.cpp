@@ -0,0 +1,172 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Interactor Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Interactor.hpp"
+#include "Particle.hpp"
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef std::mt19937 Generator;
+
+/// The stepping state of a straight line stepper
+struct StepperState {
+  Acts::Vector3D position = Acts::Vector3D(0., 0., 0.);
+  Acts::Vector3D direction = Acts::Vector3D(1., 0., 0.);
+  double p = 1.;
+  double t = 0.;
+};
+
+/// A straight line stepper that keeps the absolute time
+struct Stepper {
+  Acts::Vector3D position(const StepperState &s) const { return s.position; }
+  Acts::Vector3D direction(const StepperState &s) const { return s.direction; }
+  double momentum(const StepperState &s) const { return s.p; }
+  double time(const StepperState &s) const { return s.t; }
+  void update(StepperState &s, const Acts::Vector3D &position,
+              const Acts::Vector3D &direction, double p, double t) const {
+    s.position = position;
+    s.direction = direction;
+    s.p = p;
+    s.t = t;
+  }
+
+  /// Move by a step at the velocity of the particle
+  void step(StepperState &s, double length, double mass) const {
+    double beta = s.p / std::sqrt(s.p * s.p + mass * mass);
+    s.position += length * s.direction;
+    s.t += length / (beta * au::_c);
+  }
+};
+
+struct NavigatorState {
+  bool targetReached = false;
+  const Acts::Surface *currentSurface = nullptr;
+};
+
+struct PropagatorState {
+  StepperState stepping;
+  NavigatorState navigation;
+};
+
+struct HitCreator {
+  template <typename particle_t>
+  int operator()(const Acts::Surface &, const Acts::Vector3D &,
+                 const Acts::Vector3D &, double, double,
+                 const particle_t &) const {
+    return 0;
+  }
+};
+
+/// A decay into a photon once the particle has left its start position
+struct DisplacedDecay {
+  template <typename generator_t, typename particle_t>
+  void initialize(generator_t &, particle_t &) const {}
+
+  template <typename generator_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &,
+                                     const particle_t &particle) const {
+    if (particle.position().norm() == 0.) {
+      return {};
+    }
+    return {particle_t(particle.position(), particle.momentum(), 0., 0., 22,
+                       2, particle.time())};
+  }
+};
+
+typedef Interactor<Generator, Particle, int, HitCreator> TestInteractor;
+typedef Interactor<Generator, Particle, int, HitCreator, VoidSelector,
+                   PhysicsList<>, DisplacedDecay>
+    DecayInteractor;
+
+// This tests that the particle follows the absolute time of the stepper
+BOOST_AUTO_TEST_CASE(Interactor_time_test_) {
+  Generator generator;
+  const double mass = 0.1;
+  const double startTime = 5. * au::_ns;
+  TestInteractor interactor;
+  interactor.generator = &generator;
+  interactor.initialParticle = Particle(Acts::Vector3D(0., 0., 0.),
+                                        Acts::Vector3D(0.2, 0., 0.), mass, 1.,
+                                        13, 1, startTime);
+  interactor.initialParticle.setLimits(1., 1., startTime + 1. * au::_ns);
+
+  PropagatorState state;
+  state.stepping.p = 0.2;
+  state.stepping.t = startTime;
+  Stepper stepper;
+  TestInteractor::result_type result;
+  interactor(state, stepper, result);
+  BOOST_CHECK_EQUAL(result.particle.time(), startTime);
+
+  const double beta = 0.2 / std::sqrt(0.2 * 0.2 + mass * mass);
+  const double dt = 100. * au::_mm / (beta * au::_c);
+  for (int i = 1; i <= 5; ++i) {
+    stepper.step(state.stepping, 100. * au::_mm, mass);
+    interactor(state, stepper, result);
+    BOOST_CHECK_CLOSE(result.particle.time(), startTime + i * dt, 1e-9);
+    BOOST_CHECK_CLOSE(state.stepping.t, startTime + i * dt, 1e-9);
+    // the readout time limit is checked against the correct time
+    BOOST_CHECK_EQUAL(bool(result.particle), i * dt <= 1. * au::_ns);
+  }
+}
+
+// This tests that a neutral started at its own time keeps it
+BOOST_AUTO_TEST_CASE(Interactor_neutral_time_test_) {
+  Generator generator;
+  const double mass = 0.5;
+  const double startTime = 20. * au::_ns;
+  DecayInteractor interactor;
+  interactor.generator = &generator;
+  interactor.initialParticle = Particle(Acts::Vector3D(0., 0., 0.),
+                                        Acts::Vector3D(1., 0., 0.), mass, 0.,
+                                        310, 1, startTime);
+
+  // the start parameters carry the time of the particle, as in the
+  // Simulator, the stepper time is thus absolute from the first step
+  PropagatorState state;
+  state.stepping.p = 1.;
+  state.stepping.t = interactor.initialParticle.time();
+  Stepper stepper;
+  DecayInteractor::result_type result;
+  interactor(state, stepper, result);
+  BOOST_CHECK_EQUAL(result.particle.time(), startTime);
+  BOOST_CHECK(result.outgoing.empty());
+
+  stepper.step(state.stepping, 100. * au::_mm, mass);
+  interactor(state, stepper, result);
+  BOOST_REQUIRE_EQUAL(result.outgoing.size(), 1u);
+  const double beta = 1. / std::sqrt(1. + mass * mass);
+  BOOST_CHECK_CLOSE(result.outgoing[0].time(),
+                    startTime + 100. * au::_mm / (beta * au::_c), 1e-9);
+}
+
+} // namespace Test
+
+} // namespace Fatras
@@ -0,0 +1,141 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE KillVolumes Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/RectangleBounds.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/KillVolumes.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+/// Create a plane surface in a volume
+std::shared_ptr<Acts::PlaneSurface> makePlane(Acts::geo_id_value volume) {
+  auto surface = Acts::Surface::makeShared<Acts::PlaneSurface>(
+      std::make_shared<const Acts::Transform3D>(
+          Acts::Transform3D::Identity()),
+      std::make_shared<const Acts::RectangleBounds>(10., 10.));
+  surface->assignGeoID(Acts::GeometryID((volume << 56) | 42));
+  return surface;
+}
+
+// This tests the termination in kill volumes
+BOOST_AUTO_TEST_CASE(KillVolumes_volume_test_) {
+  KillVolumes::Config cfg;
+  cfg.volumes = {9, 4, 9};
+  KillVolumes kill(cfg);
+  BOOST_CHECK(kill.isKillVolume(4));
+  BOOST_CHECK(not kill.isKillVolume(5));
+
+  Particle particle(Acts::Vector3D(1., 2., 3.), Acts::Vector3D(0., 1., 0.),
+                    0.1, -1., 13, 7);
+  auto tracker = makePlane(2);
+  auto calorimeter = makePlane(9);
+  BOOST_CHECK(not kill(tracker.get(), particle));
+  BOOST_CHECK(not kill(nullptr, particle));
+  auto record = kill(calorimeter.get(), particle);
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->barcode, 7u);
+  BOOST_CHECK_EQUAL(record->geoID, calorimeter->geoID().value());
+  BOOST_CHECK_EQUAL(record->pdg, 13);
+  BOOST_CHECK_EQUAL(record->z, 3.f);
+  BOOST_CHECK_EQUAL(record->py, 1.f);
+
+  auto counters = kill.counters();
+  BOOST_CHECK_EQUAL(counters.inVolume, 1u);
+  BOOST_CHECK(counters.perVolume == std::vector<std::uint64_t>({0u, 1u}));
+  BOOST_CHECK_EQUAL(counters.atEnvelope, 0u);
+}
+
+// This tests the termination at the envelope
+BOOST_AUTO_TEST_CASE(KillVolumes_envelope_test_) {
+  KillVolumes::Config cfg;
+  cfg.maxRadius = 1. * au::_m;
+  cfg.maxAbsZ = 3. * au::_m;
+  KillVolumes kill(cfg);
+  BOOST_CHECK(not kill.isOutside(Acts::Vector3D(700., 700., -2900.)));
+  BOOST_CHECK(kill.isOutside(Acts::Vector3D(800., 800., 0.)));
+  BOOST_CHECK(kill.isOutside(Acts::Vector3D(0., 0., -3100.)));
+
+  // the last step is taken back to the barrel
+  Particle barrel(Acts::Vector3D(0., 1100., 50.), Acts::Vector3D(0., 3., 4.),
+                  0., 0., 22, 1);
+  auto record = kill(nullptr, barrel);
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->geoID, 0u);
+  BOOST_CHECK_CLOSE(record->y, 1000., 1e-4);
+  BOOST_CHECK_CLOSE(record->z, 50. - 100. * 4. / 3., 1e-4);
+  BOOST_CHECK_CLOSE(record->time, -100. / 0.6 / au::_c, 1e-3);
+  // the particle itself is moved back as well
+  BOOST_CHECK_CLOSE(barrel.position().y(), 1000., 1e-4);
+  BOOST_CHECK_CLOSE(barrel.time(), record->time, 1e-3);
+
+  // and to the end cap
+  Particle endcap(Acts::Vector3D(300., 0., -3200.), Acts::Vector3D(1., 0., -1.),
+                  0., 0., 22, 2);
+  record = kill(nullptr, endcap);
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_CLOSE(record->x, 100., 1e-4);
+  BOOST_CHECK_CLOSE(record->z, -3000., 1e-4);
+
+  // but not through an end cap it is moving back into
+  Particle inward(Acts::Vector3D(0., 1010., -3300.),
+                  Acts::Vector3D(0., 3., 4.), 0., 0., 22, 4);
+  record = kill(nullptr, inward);
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_CLOSE(record->y, 1000., 1e-4);
+  BOOST_CHECK_CLOSE(record->z, -3300. - 10. * 4. / 3., 1e-4);
+
+  // inside nothing happens
+  Particle inside(Acts::Vector3D(0., 900., 0.), Acts::Vector3D(0., 1., 0.),
+                  0., 0., 22, 3);
+  BOOST_CHECK(not kill(nullptr, inside));
+
+  auto counters = kill.counters();
+  BOOST_CHECK_EQUAL(counters.inVolume, 0u);
+  BOOST_CHECK_EQUAL(counters.atEnvelope, 3u);
+}
+
+// This tests the record layout
+BOOST_AUTO_TEST_CASE(KillVolumes_record_test_) {
+  Particle particle(Acts::Vector3D(1., 2., 3.), Acts::Vector3D(4., 5., 6.),
+                    0.1, 1., 211, 5);
+  auto record = makeBoundaryRecord(particle, 12);
+  BOOST_CHECK_EQUAL(sizeof(record), 48u);
+  BOOST_CHECK_EQUAL(record.barcode, 5u);
+  BOOST_CHECK_EQUAL(record.geoID, 12u);
+  BOOST_CHECK_EQUAL(record.x, 1.f);
+  BOOST_CHECK_EQUAL(record.pz, 6.f);
+}
+
+} // namespace Test
+
+} // namespace Fatras
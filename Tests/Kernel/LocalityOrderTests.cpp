@@ -0,0 +1,125 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE LocalityOrder Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/LocalityOrder.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+Particle makeParticle(double r, double phi, double pz, barcode_type barcode) {
+  return Particle(Acts::Vector3D(r, 0., 0.),
+                  Acts::Vector3D(std::cos(phi), std::sin(phi), pz), 0.1, 1.,
+                  211, barcode);
+}
+
+// This tests the tiles of eta, phi and origin
+BOOST_AUTO_TEST_CASE(LocalityOrder_tile_test_) {
+  LocalityOrder::Config cfg;
+  cfg.nEtaTiles = 8;
+  cfg.nPhiTiles = 8;
+  cfg.originRadii = {30. * Acts::units::_mm, 200. * Acts::units::_mm};
+  LocalityOrder locality(cfg);
+
+  auto central = locality.tile(makeParticle(0., 0.1, 0., 1));
+  BOOST_CHECK_EQUAL(locality.tile(makeParticle(0., 0.15, 0.01, 2)), central);
+  BOOST_CHECK_NE(locality.tile(makeParticle(0., 2., 0., 3)), central);
+  BOOST_CHECK_NE(locality.tile(makeParticle(0., 0.1, 5., 4)), central);
+  // the origin volumes
+  auto inner = locality.tile(makeParticle(50., 0.1, 0., 5));
+  BOOST_CHECK_NE(inner, central);
+  BOOST_CHECK_EQUAL(locality.tile(makeParticle(150., 0.1, 0., 6)), inner);
+  BOOST_CHECK_NE(locality.tile(makeParticle(500., 0.1, 0., 7)), inner);
+  // outside the eta range
+  BOOST_CHECK_EQUAL(locality.tile(makeParticle(0., 0.1, 1e6, 8)),
+                    locality.tile(makeParticle(0., 0.1, 1e7, 9)));
+}
+
+// This tests the sorting and the counters
+BOOST_AUTO_TEST_CASE(LocalityOrder_sort_test_) {
+  // particles alternating between four directions
+  std::vector<Particle> particles;
+  for (barcode_type i = 0; i < 40; ++i) {
+    particles.push_back(makeParticle(0., -3. + 1.5 * (i % 4), 0., i));
+  }
+
+  for (bool sort : {true, false}) {
+    LocalityOrder::Config cfg;
+    cfg.sort = sort;
+    LocalityOrder locality(cfg);
+    // the first two particles are done already
+    std::vector<std::size_t> order(particles.size());
+    std::iota(order.begin(), order.end(), 0);
+    locality.sort(particles, order, 2);
+
+    BOOST_CHECK_EQUAL(order[0], 0u);
+    BOOST_CHECK_EQUAL(order[1], 1u);
+    auto counters = locality.counters();
+    BOOST_CHECK_EQUAL(counters.particles, 38u);
+    BOOST_CHECK_EQUAL(counters.switchesBefore, 37u);
+    if (sort) {
+      BOOST_CHECK_EQUAL(counters.switchesAfter, 3u);
+      // the order within a tile is kept
+      for (std::size_t j = 3; j < order.size(); ++j) {
+        if (locality.tile(particles[order[j]]) ==
+            locality.tile(particles[order[j - 1]])) {
+          BOOST_CHECK_LT(order[j - 1], order[j]);
+        }
+      }
+    } else {
+      BOOST_CHECK_EQUAL(counters.switchesAfter, 37u);
+      BOOST_CHECK_EQUAL(order[39], 39u);
+    }
+  }
+}
+
+// This tests the hardware cache counters
+BOOST_AUTO_TEST_CASE(LocalityOrder_cache_test_) {
+  LocalityOrder locality;
+  CacheCounter counter;
+  counter.start();
+  std::vector<double> values(1 << 20, 1.);
+  double sum = std::accumulate(values.begin(), values.end(), 0.);
+  auto counts = counter.stop();
+  BOOST_CHECK_EQUAL(sum, values.size());
+  if (counter.available()) {
+    BOOST_CHECK_GT(counts.references, 0u);
+  } else {
+    BOOST_CHECK_EQUAL(counts.references, 0u);
+    BOOST_CHECK_EQUAL(counts.misses, 0u);
+  }
+  locality.addCacheCounts(counts);
+  locality.addCacheCounts(counts);
+  auto counters = locality.counters();
+  BOOST_CHECK_EQUAL(counters.cacheReferences, 2 * counts.references);
+  BOOST_CHECK_EQUAL(counters.cacheMisses, 2 * counts.misses);
+  BOOST_CHECK_LE(counters.missRate(), 1.);
+}
+
+} // namespace Test
+} // namespace Fatras
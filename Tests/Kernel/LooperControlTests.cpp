@@ -0,0 +1,192 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE LooperControl Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/LooperControl.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef std::mt19937 Generator;
+
+const double pionMass = 139.57 * au::_MeV;
+
+Particle makePion(const Acts::Vector3D &position,
+                  const Acts::Vector3D &momentum, double q = 1.) {
+  return Particle(position, momentum, pionMass, q, 211, 1);
+}
+
+/// Move a particle by an angle along its helix
+void turn(const LooperControl &control, Particle &particle, double angle) {
+  const double R = control.radius(particle);
+  const double s = particle.q() > 0. ? -1. : 1.;
+  const Acts::Vector3D &p = particle.momentum();
+  Acts::Vector3D centre =
+      particle.position() -
+      s * R / particle.pT() * Acts::Vector3D(p.y(), -p.x(), 0.);
+  const double c = std::cos(s * angle);
+  const double sn = std::sin(s * angle);
+  Acts::Vector3D offset = particle.position() - centre;
+  Acts::Vector3D position =
+      centre + Acts::Vector3D(c * offset.x() - sn * offset.y(),
+                              sn * offset.x() + c * offset.y(), 0.);
+  position.z() = particle.position().z() + angle * R * p.z() / particle.pT();
+  Acts::Vector3D momentum(c * p.x() - sn * p.y(), sn * p.x() + c * p.y(),
+                          p.z());
+  particle.update(position, momentum);
+}
+
+// This tests the looper detection
+BOOST_AUTO_TEST_CASE(LooperControl_detection_test_) {
+  LooperControl control;
+  Acts::Vector3D origin(0., 0., 0.);
+  auto slow = makePion(origin, Acts::Vector3D(0.1, 0., 0.5));
+  BOOST_CHECK_CLOSE(control.radius(slow), 0.1 / (2. * au::_T), 1e-6);
+  BOOST_CHECK(control.isLooper(slow));
+  BOOST_CHECK(
+      not control.isLooper(makePion(origin, Acts::Vector3D(1., 0., 0.))));
+  BOOST_CHECK(
+      not control.isLooper(makePion(origin, Acts::Vector3D(0.1, 0., 0.), 0.)));
+  // a slow particle at the edge of the tracker can leave it
+  auto outer =
+      makePion(Acts::Vector3D(900., 0., 0.), Acts::Vector3D(0.1, 0., 0.));
+  BOOST_CHECK(not control.isLooper(outer));
+}
+
+// This tests the turn, path and step budgets
+BOOST_AUTO_TEST_CASE(LooperControl_budget_test_) {
+  Generator generator(17);
+  LooperControl::Config cfg;
+  cfg.maxTurns = 1.3;
+  cfg.fastForward = false;
+  LooperControl control(cfg);
+
+  for (double q : {1., -1.}) {
+    auto particle =
+        makePion(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(0.1, 0., 0.01), q);
+    LooperControl::State state;
+    int k = 0;
+    while (not control(generator, state, particle, 0.01)) {
+      turn(control, particle, 2. * M_PI / 12.);
+      ++k;
+    }
+    BOOST_CHECK_EQUAL(k, 16);
+    BOOST_CHECK_CLOSE(state.turns, 16. / 12., 1e-6);
+    BOOST_CHECK_CLOSE(state.pathInX0, 0.17, 1e-6);
+    // the particle is not touched
+    BOOST_CHECK(particle);
+  }
+
+  cfg.maxTurns = 100.;
+  cfg.maxSteps = 5;
+  LooperControl steps(cfg);
+  auto particle =
+      makePion(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(0.1, 0., 0.01));
+  LooperControl::State state;
+  int k = 0;
+  while (not steps(generator, state, particle, 0.)) {
+    turn(steps, particle, 0.1);
+    ++k;
+  }
+  BOOST_CHECK_EQUAL(k, 5);
+
+  auto counters = control.counters();
+  BOOST_CHECK_EQUAL(counters.loopers, 2u);
+  BOOST_CHECK_EQUAL(counters.stopped, 2u);
+  BOOST_CHECK_EQUAL(counters.forwarded, 0u);
+}
+
+// This tests the fast-forward on the helix
+BOOST_AUTO_TEST_CASE(LooperControl_forward_test_) {
+  Generator generator(19);
+  LooperControl::Config cfg;
+  cfg.maxTurns = 1.;
+  LooperControl control(cfg);
+
+  // two turns done with 1 MeV loss each
+  auto prepare = [&](Particle &particle, double lossPerTurn) {
+    LooperControl::State state;
+    state.initialized = true;
+    state.turns = 2.;
+    state.pathInX0 = 0.02;
+    state.initialEnergy = particle.E() + 2. * lossPerTurn;
+    state.lastPhi = Acts::VectorHelpers::phi(particle.momentum());
+    state.lastPosition = particle.position();
+    return state;
+  };
+
+  // the looper leaves the tracker at its end
+  auto particle =
+      makePion(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(0.1, 0., 0.05));
+  const double R = control.radius(particle);
+  const double pitch = 2. * M_PI * R * 0.5;
+  const double E = particle.E();
+  const double beta = particle.p() / E;
+  const double turnLength = 2. * M_PI * R * particle.p() / particle.pT();
+  auto state = prepare(particle, 1. * au::_MeV);
+  BOOST_CHECK(control(generator, state, particle, 0.));
+  const double nTurns = cfg.trackerHalfLength / pitch;
+  BOOST_CHECK(particle);
+  // the time runs along the full helix, not the chord
+  BOOST_CHECK_CLOSE(particle.time(), nTurns * turnLength / (beta * au::_c),
+                    1e-6);
+  BOOST_CHECK_CLOSE(particle.properTime(),
+                    nTurns * turnLength * pionMass / (beta * E * au::_c),
+                    1e-6);
+  BOOST_CHECK_CLOSE(particle.position().z(), cfg.trackerHalfLength, 1e-6);
+  BOOST_CHECK_CLOSE(particle.E(), E - nTurns * au::_MeV, 1e-6);
+  // still on the helix through the origin
+  Acts::Vector3D centre(0., -R, 0.);
+  BOOST_CHECK_CLOSE((particle.position() - centre).head<2>().norm(), R, 1e-6);
+
+  // a large loss stops it on the way
+  auto slow =
+      makePion(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(0.1, 0., 0.05));
+  const double kineticEnergy = slow.E() - pionMass;
+  auto slowState = prepare(slow, 20. * au::_MeV);
+  BOOST_CHECK(control(generator, slowState, slow, 0.));
+  BOOST_CHECK(not slow);
+  BOOST_CHECK_CLOSE(slow.position().z(),
+                    kineticEnergy / (20. * au::_MeV) * pitch, 1e-6);
+
+  // without longitudinal momentum and loss it stays where it is
+  auto flat =
+      makePion(Acts::Vector3D(10., 0., 0.), Acts::Vector3D(0.1, 0., 0.));
+  auto flatState = prepare(flat, 0.);
+  BOOST_CHECK(control(generator, flatState, flat, 0.));
+  BOOST_CHECK_EQUAL(flat.position(), Acts::Vector3D(10., 0., 0.));
+
+  auto counters = control.counters();
+  BOOST_CHECK_EQUAL(counters.loopers, 3u);
+  BOOST_CHECK_EQUAL(counters.forwarded, 3u);
+  BOOST_CHECK_CLOSE(counters.skippedTurns,
+                    nTurns + kineticEnergy / (20. * au::_MeV), 1e-6);
+}
+
+} // namespace Test
+} // namespace Fatras
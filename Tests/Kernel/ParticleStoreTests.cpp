@@ -0,0 +1,172 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE ParticleStore Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/ParticleStore.hpp"
+#include "Fatras/Kernel/SelectorExpression.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/KinematicCasts.hpp"
+#include "Fatras/Selectors/SelectorHelpers.hpp"
+#include "Particle.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+struct Detector {};
+
+/// Create a set of primaries, every third one is neutral
+std::vector<Particle> primaries(std::size_t n) {
+  std::vector<Particle> particles;
+  for (std::size_t i = 0; i < n; ++i) {
+    double q = (i % 3) ? -1. : 0.;
+    Acts::Vector3D position(0., 0., 0.1 * i);
+    Acts::Vector3D momentum(0.1 * i * au::_GeV, 1. * au::_GeV,
+                            0.2 * i * au::_GeV);
+    particles.emplace_back(position, momentum, 0.1 * au::_GeV, q,
+                           q ? 211 : 22, i + 1, 0.5 * i);
+  }
+  return particles;
+}
+
+// This tests the store layout and the stable indices
+BOOST_AUTO_TEST_CASE(ParticleStore_indices_test_) {
+  ParticleStore store;
+  BOOST_CHECK(store.empty());
+
+  auto particles = primaries(10);
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    BOOST_CHECK_EQUAL(store.addPrimary(particles[i]), i);
+  }
+  BOOST_CHECK_EQUAL(store.primaries(), 10u);
+  BOOST_CHECK_EQUAL(store.secondaries(), 0u);
+
+  // the secondaries are appended behind the primaries
+  std::vector<Particle> secondaries(primaries(4));
+  BOOST_CHECK_EQUAL(store.addSecondaries(secondaries), 10u);
+  BOOST_CHECK_EQUAL(store.addSecondary(particles[0]), 14u);
+  BOOST_CHECK_EQUAL(store.size(), 15u);
+  BOOST_CHECK_EQUAL(store.secondaries(), 5u);
+  BOOST_CHECK_THROW(store.addPrimary(particles[0]), std::logic_error);
+
+  // the particles are unchanged by the appending
+  for (ParticleStore::Index i = 0; i < 10; ++i) {
+    auto particle = store.particle<Particle>(i);
+    BOOST_CHECK_EQUAL(particle.position(), particles[i].position());
+    BOOST_CHECK_EQUAL(particle.momentum(), particles[i].momentum());
+    BOOST_CHECK_EQUAL(particle.m(), particles[i].m());
+    BOOST_CHECK_EQUAL(particle.q(), particles[i].q());
+    BOOST_CHECK_EQUAL(particle.pdg(), particles[i].pdg());
+    BOOST_CHECK_EQUAL(particle.barcode(), particles[i].barcode());
+    BOOST_CHECK_EQUAL(particle.time(), particles[i].time());
+    BOOST_CHECK_EQUAL(store[i].p(), particles[i].p());
+    BOOST_CHECK_EQUAL(store[i].pT(), particles[i].pT());
+    BOOST_CHECK_CLOSE(store[i].E(), particles[i].E(), 1e-10);
+  }
+
+  // the status
+  BOOST_CHECK(store[3]);
+  store.setStatus(3, ParticleStatus::Stopped);
+  BOOST_CHECK(!store[3]);
+
+  // the store is reused for the next event
+  store.clear();
+  BOOST_CHECK(store.empty());
+  BOOST_CHECK_EQUAL(store.primaries(), 0u);
+  BOOST_CHECK_EQUAL(store.addPrimary(particles[0]), 0u);
+}
+
+// This tests the selectors on the proxies and the batch view
+BOOST_AUTO_TEST_CASE(ParticleStore_selection_test_) {
+  ParticleStore store;
+  for (const auto &particle : primaries(30)) {
+    store.addPrimary(particle);
+  }
+  Detector detector;
+
+  typedef And<ChargedSelector, Min<casts::pT>> Selector;
+  Selector selector;
+  selector.get<Min<casts::pT>>().valMin = 1.5 * au::_GeV;
+
+  // the proxies are accepted by the selectors
+  std::vector<uint8_t> expected;
+  for (const auto proxy : store) {
+    auto particle = store.particle<Particle>(proxy.index());
+    BOOST_CHECK_EQUAL(selector(detector, proxy),
+                      selector(detector, particle));
+    expected.push_back(selector(detector, particle));
+  }
+
+  // the batch view is equivalent
+  std::vector<uint8_t> mask;
+  std::size_t selected = selectBatch(selector, detector, store.batch(), mask);
+  BOOST_CHECK_EQUAL_COLLECTIONS(mask.begin(), mask.end(), expected.begin(),
+                                expected.end());
+  std::size_t count = 0;
+  for (auto e : expected) {
+    count += e;
+  }
+  BOOST_CHECK_EQUAL(selected, count);
+
+  // and so is a slice of it
+  auto slice = store.batch(10, 20);
+  BOOST_CHECK_EQUAL(slice.size, 10u);
+  BOOST_CHECK_EQUAL(slice.pdg[0], store[10].pdg());
+  BOOST_CHECK_EQUAL(slice.px[3], store[13].momentum().x());
+}
+
+// This tests the event adaptor the way the simulator iterates it
+BOOST_AUTO_TEST_CASE(ParticleStore_event_test_) {
+  ParticleStore store;
+  for (const auto &particle : primaries(5)) {
+    store.addPrimary(particle);
+  }
+
+  ParticleStoreEvent<Particle> event(store);
+  std::size_t processed = 0;
+  for (auto &vertex : event) {
+    for (std::size_t n = 0; n < vertex.outgoing.size(); n++) {
+      auto particle = vertex.outgoing[n];
+      ++processed;
+      // charged primaries create one secondary each
+      if (particle.q() and particle.barcode() <= 5) {
+        Particle secondary(particle.position(), 0.5 * particle.momentum(),
+                           particle.m(), particle.q(), particle.pdg(),
+                           100 + particle.barcode(), particle.time());
+        vertex.outgoing_insert({secondary});
+      }
+    }
+  }
+  // 3 of the 5 primaries are charged
+  BOOST_CHECK_EQUAL(store.primaries(), 5u);
+  BOOST_CHECK_EQUAL(store.secondaries(), 3u);
+  BOOST_CHECK_EQUAL(processed, 8u);
+  BOOST_CHECK_EQUAL(store[5].barcode(), 102u);
+  BOOST_CHECK_EQUAL(store[7].barcode(), 105u);
+}
+
+} // namespace Test
+} // namespace Fatras
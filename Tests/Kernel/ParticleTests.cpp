@@ -0,0 +1,188 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Particle Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Particle.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/Process.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheBloch.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include "Fatras/Physics/Scattering/Scattering.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Particle.hpp"
+#include <random>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+// the generator
+typedef std::mt19937 Generator;
+
+// some material
+Acts::Material berilium = Acts::Material(352.8, 407., 9.012, 4.,
+                                         1.848 / (au::_cm * au::_cm * au::_cm));
+
+/// Test that the production particle fits into two cache lines
+BOOST_AUTO_TEST_CASE(Particle_layout_test_) {
+  BOOST_CHECK(sizeof(Fatras::Particle) <= 128);
+  BOOST_CHECK_EQUAL(alignof(Fatras::Particle), 64u);
+
+  std::vector<Fatras::Particle> particles(3);
+  for (const auto &particle : particles) {
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&particle) % 64, 0u);
+  }
+}
+
+/// Test the derived quantities against the test particle
+BOOST_DATA_TEST_CASE(
+    Particle_kinematics_test_,
+    bdata::random(
+        (bdata::seed = 30,
+         bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random(
+            (bdata::seed = 31,
+             bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random(
+            (bdata::seed = 32,
+             bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random((bdata::seed = 33,
+                       bdata::distribution =
+                           std::uniform_real_distribution<>(0.1, 10.))) ^
+        bdata::xrange(100),
+    x, y, z, p, index) {
+  (void)index;
+
+  Acts::Vector3D position(1., 2., 3.);
+  Acts::Vector3D momentum = p * au::_GeV * Acts::Vector3D(x, y, z).normalized();
+  double m = 105.658367 * au::_MeV;
+
+  Fatras::Particle particle(position, momentum, m, -1., 13, 7, 2.);
+  Particle reference(position, momentum, m, -1., 13, 7, 2.);
+
+  BOOST_CHECK_EQUAL(particle.position(), reference.position());
+  BOOST_CHECK_EQUAL(particle.momentum(), reference.momentum());
+  BOOST_CHECK_CLOSE(particle.p(), reference.p(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.pT(), reference.pT(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.E(), reference.E(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.beta(), reference.beta(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.gamma(), reference.gamma(), 1e-10);
+  BOOST_CHECK_EQUAL(particle.m(), reference.m());
+  BOOST_CHECK_EQUAL(particle.q(), reference.q());
+  BOOST_CHECK_EQUAL(particle.pdg(), reference.pdg());
+  BOOST_CHECK_EQUAL(particle.barcode(), reference.barcode());
+  BOOST_CHECK_EQUAL(particle.time(), reference.time());
+
+  // a step through the material updates the derived quantities
+  Acts::Vector3D step = position + 10. * au::_mm * momentum.normalized();
+  Acts::Vector3D stepMomentum = 0.9 * momentum;
+  BOOST_CHECK(!particle.update(step, stepMomentum, 0.1, 0.01, 0.5));
+  BOOST_CHECK(!reference.update(step, stepMomentum, 0.1, 0.01, 0.5));
+  BOOST_CHECK_CLOSE(particle.p(), reference.p(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.E(), reference.E(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.properTime(), reference.properTime(), 1e-10);
+  BOOST_CHECK_CLOSE(particle.pathInX0(), 0.1, 1e-5);
+  BOOST_CHECK_CLOSE(particle.pathInL0(), 0.01, 1e-5);
+  BOOST_CHECK_CLOSE(particle.time(), 2.5, 1e-10);
+
+  // energy loss keeps the direction
+  double E = particle.E();
+  particle.energyLoss(0.01 * E);
+  BOOST_CHECK_CLOSE(particle.E(), 0.99 * E, 1e-8);
+  BOOST_CHECK_CLOSE(particle.p(), particle.momentum().norm(), 1e-8);
+  BOOST_CHECK_CLOSE(particle.momentum().normalized().dot(momentum.normalized()),
+                    1., 1e-8);
+}
+
+/// Test the limits and the falling to rest
+BOOST_AUTO_TEST_CASE(Particle_limits_test_) {
+  Acts::Vector3D position(0., 0., 0.);
+  Acts::Vector3D momentum(0., 0., 1. * au::_GeV);
+  double m = 139.57018 * au::_MeV;
+
+  Fatras::Particle particle(position, momentum, m, 1., 211, 1);
+  // the default limits are not reached
+  BOOST_CHECK(particle);
+  BOOST_CHECK(!particle.update(Acts::Vector3D(0., 0., 1000.), momentum, 1e6,
+                               1e6, 1e6));
+
+  // the X0 limit is reached
+  Fatras::Particle absorbed(position, momentum, m, 1., 211, 4);
+  absorbed.setLimits(1., 10.);
+  BOOST_CHECK(!absorbed.update(Acts::Vector3D(0., 0., 1.), momentum, 0.5));
+  BOOST_CHECK(absorbed.update(Acts::Vector3D(0., 0., 2.), momentum, 0.5));
+  BOOST_CHECK(!absorbed);
+
+  // the proper time limit is reached
+  Fatras::Particle decaying(position, momentum, m, 1., 211, 2);
+  decaying.setProperTimeLimit(1e-3);
+  BOOST_CHECK(decaying.update(Acts::Vector3D(0., 0., 1000.), momentum));
+  BOOST_CHECK(decaying.properTime() > decaying.properTimeLimit());
+  // also when the proper time is advanced without a position update
+  Fatras::Particle turning(position, momentum, m, 1., 211, 5);
+  turning.setProperTimeLimit(1e-3);
+  BOOST_CHECK(!turning.advanceProperTime(0.5e-3));
+  BOOST_CHECK(turning.advanceProperTime(0.5e-3));
+  BOOST_CHECK_EQUAL(turning.properTime(), 1e-3);
+
+  // the particle falls to rest
+  Fatras::Particle stopping(position, momentum, m, 1., 211, 3);
+  stopping.energyLoss(10. * au::_GeV);
+  BOOST_CHECK(!stopping);
+  BOOST_CHECK_EQUAL(stopping.p(), 0.);
+  BOOST_CHECK_EQUAL(stopping.E(), m);
+  BOOST_CHECK_EQUAL(stopping.momentum(), Acts::Vector3D(0., 0., 0.));
+}
+
+/// Test that the physics modules accept the production particle
+BOOST_AUTO_TEST_CASE(Particle_physics_test_) {
+  Generator generator;
+  Acts::MaterialProperties detector(berilium, 10. * au::_mm);
+
+  Acts::Vector3D position(0., 0., 0.);
+  Acts::Vector3D momentum(1. * au::_GeV, 0., 0.);
+  double m = 105.658367 * au::_MeV;
+
+  typedef Process<BetheBloch, ChargedSelector, ChargedSelector,
+                  ChargedSelector>
+      EnergyLossProcess;
+  typedef Process<Scattering<Highland>, ChargedSelector, ChargedSelector,
+                  ChargedSelector>
+      ScatteringProcess;
+  PhysicsList<EnergyLossProcess, ScatteringProcess> physicsList;
+
+  Fatras::Particle particle(position, momentum, m, -1., 13, 1);
+  double E = particle.E();
+  std::vector<Fatras::Particle> outgoing;
+  BOOST_CHECK(!physicsList(generator, detector, particle, outgoing));
+  BOOST_CHECK(outgoing.empty());
+  BOOST_CHECK(particle.E() < E);
+  BOOST_CHECK_CLOSE(particle.p(), particle.momentum().norm(), 1e-8);
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,183 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE PhysicsRegions Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/DynamicPhysicsList.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/PhysicsRegions.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef std::mt19937 Generator;
+
+const double electronMass = 0.51099895 * au::_MeV;
+
+/// Physics process that emits electrons of 0.1, 1 and 10 MeV
+template <int tag> struct EmittingProcess {
+
+  /// call operator
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &, const detector_t &, particle_t &in,
+                  std::vector<particle_t> &out) const {
+    for (double kineticEnergy : {0.1, 1., 10.}) {
+      double E = kineticEnergy * au::_MeV + electronMass;
+      double p = std::sqrt(E * E - electronMass * electronMass);
+      out.emplace_back(in.position(), Acts::Vector3D(p, 0., 0.),
+                       electronMass, -1., 11, tag);
+    }
+    return false;
+  }
+};
+
+/// Physics process that DOES trigger a break
+struct FatalProcess {
+
+  /// call operator
+  template <typename generator_t, typename detector_t, typename particle_t>
+  bool operator()(generator_t &, const detector_t &, particle_t &,
+                  std::vector<particle_t> &) const {
+    return true;
+  }
+};
+
+typedef EmittingProcess<1> FirstProcess;
+typedef EmittingProcess<2> SecondProcess;
+
+// This tests the lookup of the regions
+BOOST_AUTO_TEST_CASE(PhysicsRegions_lookup) {
+  PhysicsRegion gas;
+  gas.variant = 1;
+  gas.cuts = {1. * au::_MeV};
+  PhysicsRegions regions(gas);
+  BOOST_TEST(regions.size() == 0u);
+  BOOST_TEST(&regions.find(7) == &regions.defaultRegion());
+
+  PhysicsRegion tracker;
+  regions.set(7, tracker);
+  regions.set(3, gas);
+  regions.set(12, gas);
+  BOOST_TEST(regions.size() == 3u);
+  BOOST_TEST(regions.find(7).variant == 0u);
+  BOOST_TEST(regions.find(3).variant == 1u);
+  BOOST_TEST(&regions.find(5) == &regions.defaultRegion());
+  // a volume is configured once
+  regions.set(7, gas);
+  BOOST_TEST(regions.size() == 3u);
+  BOOST_TEST(regions.find(7).variant == 1u);
+}
+
+// This tests the production cuts per process
+BOOST_AUTO_TEST_CASE(PhysicsRegions_cuts) {
+  Generator generator;
+  Acts::MaterialProperties detector;
+  Particle in;
+  std::vector<Particle> out;
+
+  PhysicsList<FirstProcess, SecondProcess> staticList;
+  DynamicPhysicsList<FirstProcess, SecondProcess, FatalProcess> dynamicList;
+  dynamicList.add<FirstProcess>();
+  dynamicList.add<SecondProcess>();
+
+  BOOST_TEST(!staticList(generator, detector, in, out));
+  BOOST_TEST(out.size() == 6u);
+
+  // the cuts are per process, the missing one is off
+  std::vector<double> cuts = {0.5 * au::_MeV, 5. * au::_MeV};
+  for (const auto &c : {cuts, std::vector<double>{0.5 * au::_MeV}}) {
+    std::vector<Particle> outStatic;
+    std::vector<Particle> outDynamic;
+    BOOST_TEST(!staticList(generator, detector, in, outStatic, c));
+    BOOST_TEST(!dynamicList(generator, detector, in, outDynamic, c));
+    BOOST_TEST(outStatic.size() == (c.size() == 2 ? 3u : 5u));
+    BOOST_TEST(outDynamic.size() == outStatic.size());
+    for (std::size_t i = 0; i < outStatic.size(); ++i) {
+      BOOST_TEST(outStatic[i].E() == outDynamic[i].E());
+    }
+    BOOST_TEST(outStatic[0].barcode() == 1u);
+    BOOST_TEST(outStatic.back().barcode() == 2u);
+  }
+
+  // the cuts are applied up to the process that kills the particle
+  DynamicPhysicsList<FirstProcess, SecondProcess, FatalProcess> fatalList;
+  fatalList.add<FirstProcess>();
+  fatalList.add<FatalProcess>();
+  fatalList.add<SecondProcess>();
+  out.clear();
+  BOOST_TEST(fatalList(generator, detector, in, out, cuts));
+  BOOST_TEST(out.size() == 2u);
+}
+
+// This tests the choice of the variant by region
+BOOST_AUTO_TEST_CASE(PhysicsRegions_variants) {
+  Generator generator;
+  Acts::MaterialProperties detector;
+  Particle in;
+
+  RegionPhysicsList<PhysicsList<FirstProcess, SecondProcess>, PhysicsList<>>
+      list;
+  static_assert(decltype(list)::nVariants == 2);
+  static_assert(
+      detail::physics_takes_v<decltype(list), Generator,
+                              Acts::MaterialProperties, Particle,
+                              PhysicsRegion>);
+  static_assert(
+      detail::physics_takes_v<PhysicsList<FirstProcess>, Generator,
+                              Acts::MaterialProperties, Particle,
+                              std::vector<double>>);
+  static_assert(
+      not detail::physics_takes_v<PhysicsList<FirstProcess>, Generator,
+                                  Acts::MaterialProperties, Particle,
+                                  PhysicsRegion>);
+
+  // without a region the first variant is used without cuts
+  std::vector<Particle> out;
+  BOOST_TEST(!list(generator, detector, in, out));
+  BOOST_TEST(out.size() == 6u);
+
+  PhysicsRegion region;
+  region.cuts = {0.5 * au::_MeV, 5. * au::_MeV};
+  out.clear();
+  BOOST_TEST(!list(generator, detector, in, out, region));
+  BOOST_TEST(out.size() == 3u);
+
+  // the physics is switched off
+  region.variant = 1;
+  out.clear();
+  BOOST_TEST(!list(generator, detector, in, out, region));
+  BOOST_TEST(out.empty());
+
+  region.variant = 2;
+  BOOST_CHECK_THROW(list(generator, detector, in, out, region),
+                    std::out_of_range);
+}
+
+} // namespace Test
+
+} // namespace Fatras
@@ -0,0 +1,203 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE PileUp Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/PileUp.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+struct Hit {
+  Acts::geo_id_value module = 0;
+  double z = 0.;
+  double time = 0.;
+};
+
+struct HitShifter {
+  Hit operator()(const Hit &hit, double dz, double dt) const {
+    return Hit{hit.module, hit.z + dz, hit.time + dt};
+  }
+};
+
+struct HitCollection {
+  std::vector<Hit> hits;
+
+  void insert(const Hit &hit) { hits.push_back(hit); }
+};
+
+struct HitModule {
+  Acts::geo_id_value operator()(const Hit &hit) const { return hit.module; }
+};
+
+struct Vertex {
+  std::vector<Particle> outgoing;
+
+  void outgoing_insert(const std::vector<Particle> &particles) {
+    outgoing.insert(outgoing.end(), particles.begin(), particles.end());
+  }
+};
+
+/// A simulator creating two hits per primary and one secondary per vertex
+struct FakeSimulator {
+  template <typename context_t, typename generator_t,
+            typename event_collection_t, typename hit_collection_t>
+  void operator()(context_t & /*context*/, generator_t & /*generator*/,
+                  event_collection_t &event,
+                  hit_collection_t &hits) const {
+    for (auto &vertex : event) {
+      for (const auto &particle : vertex.outgoing) {
+        hits.insert(Hit{1, particle.position().z(), particle.time()});
+        hits.insert(Hit{2, particle.position().z(), particle.time()});
+      }
+      Particle secondary = vertex.outgoing.front();
+      secondary.setBarcode(
+          Barcode(secondary.barcode()).descendant(1).value());
+      vertex.outgoing_insert({secondary});
+    }
+  }
+};
+
+struct Context {};
+
+/// A library with entries of 1, 2 and 3 primaries
+PileUpLibrary<Particle, Hit> makeLibrary() {
+  PileUpLibrary<Particle, Hit> library;
+  Context context;
+  std::mt19937 generator(42);
+  for (barcode_type nPrimaries = 1; nPrimaries <= 3; ++nPrimaries) {
+    Vertex vertex;
+    for (barcode_type primary = 1; primary <= nPrimaries; ++primary) {
+      vertex.outgoing.emplace_back(
+          Acts::Vector3D(0., 0., 0.), Acts::Vector3D(1., 0., 1.), 0.1, 1., 211,
+          Barcode(0, primary).value(), 0.);
+    }
+    library.add(FakeSimulator(), context, generator, vertex);
+  }
+  return library;
+}
+
+// This tests the simulation of the library entries
+BOOST_AUTO_TEST_CASE(PileUp_library_test_) {
+  auto library = makeLibrary();
+  BOOST_CHECK_EQUAL(library.size(), 3u);
+  for (std::size_t entry = 0; entry < 3; ++entry) {
+    BOOST_CHECK_EQUAL(library.nHits(entry), 2 * (entry + 1));
+    // the primaries and the secondary
+    BOOST_CHECK_EQUAL(library.nParticles(entry), entry + 2);
+  }
+  library.clear();
+  BOOST_CHECK_EQUAL(library.size(), 0u);
+}
+
+// This tests the overlay with shifts and unique barcodes
+BOOST_AUTO_TEST_CASE(PileUp_overlay_test_) {
+  auto library = makeLibrary();
+  std::mt19937 generator(23);
+
+  PileUpConfig cfg;
+  cfg.mu = 50.;
+  cfg.fixedNumber = true;
+  cfg.firstVertex = 7;
+  HitCollection collection;
+  const auto &hits = collection.hits;
+  std::vector<Particle> particles;
+  auto overlays = library.overlay(generator, cfg, collection, particles,
+                                  HitShifter());
+  BOOST_CHECK_EQUAL(overlays.size(), 50u);
+
+  std::size_t nHits = 0;
+  std::size_t nParticles = 0;
+  std::set<barcode_type> barcodes;
+  for (std::size_t i = 0; i < overlays.size(); ++i) {
+    const auto &ovl = overlays[i];
+    BOOST_CHECK_EQUAL(ovl.vertex, 7 + i);
+    for (std::size_t h = 0; h < library.nHits(ovl.entry); ++h) {
+      BOOST_CHECK_EQUAL(hits[nHits + h].z, ovl.dz);
+      BOOST_CHECK_EQUAL(hits[nHits + h].time, ovl.dt);
+    }
+    for (std::size_t p = 0; p < library.nParticles(ovl.entry); ++p) {
+      const Particle &particle = particles[nParticles + p];
+      BOOST_CHECK_EQUAL(particle.position().z(), ovl.dz);
+      BOOST_CHECK_EQUAL(particle.time(), ovl.dt);
+      BOOST_CHECK_EQUAL(Barcode(particle.barcode()).vertex(), ovl.vertex);
+      barcodes.insert(particle.barcode());
+    }
+    nHits += library.nHits(ovl.entry);
+    nParticles += library.nParticles(ovl.entry);
+  }
+  BOOST_CHECK_EQUAL(hits.size(), nHits);
+  BOOST_CHECK_EQUAL(particles.size(), nParticles);
+  BOOST_CHECK_EQUAL(barcodes.size(), nParticles);
+
+  // the luminous region is sampled
+  double sumZ2 = 0.;
+  for (const auto &ovl : overlays) {
+    sumZ2 += ovl.dz * ovl.dz;
+  }
+  BOOST_CHECK_CLOSE(std::sqrt(sumZ2 / overlays.size()), cfg.sigmaZ, 50.);
+}
+
+// This tests the Poisson number of vertices and the hit store
+BOOST_AUTO_TEST_CASE(PileUp_poisson_test_) {
+  auto library = makeLibrary();
+  std::mt19937 generator(5);
+
+  PileUpConfig cfg;
+  cfg.mu = 20.;
+  double sum = 0.;
+  const std::size_t nEvents = 200;
+  for (std::size_t event = 0; event < nEvents; ++event) {
+    HitStore<Hit, HitModule> hits;
+    std::vector<Particle> particles;
+    auto overlays = library.overlay(generator, cfg, hits, particles,
+                                    HitShifter());
+    sum += overlays.size();
+    // the store is built by the overlay
+    std::size_t nHits = 0;
+    for (const auto &ovl : overlays) {
+      nHits += library.nHits(ovl.entry);
+    }
+    BOOST_CHECK_EQUAL(hits.size(), nHits);
+  }
+  BOOST_CHECK_CLOSE(sum / nEvents, cfg.mu, 10.);
+
+  PileUpLibrary<Particle, Hit> empty;
+  HitCollection hits;
+  std::vector<Particle> particles;
+  BOOST_CHECK_THROW(empty.overlay(generator, cfg, hits, particles,
+                                  HitShifter()),
+                    std::logic_error);
+  cfg.mu = 0.;
+  BOOST_CHECK(
+      empty.overlay(generator, cfg, hits, particles, HitShifter()).empty());
+}
+
+} // namespace Test
+} // namespace Fatras
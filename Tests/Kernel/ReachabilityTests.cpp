@@ -0,0 +1,180 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Reachability Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/Reachability.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <limits>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef Reachability::Reason Reason;
+
+const double pionMass = 139.57 * au::_MeV;
+const double protonMass = 938.272 * au::_MeV;
+
+Particle makeParticle(const Acts::Vector3D &position,
+                      const Acts::Vector3D &momentum, double m = pionMass,
+                      double q = 1., int pdg = 211) {
+  return Particle(position, momentum, m, q, pdg, 1);
+}
+
+// This tests the helix reach against the layer radii
+BOOST_AUTO_TEST_CASE(Reachability_curling_test_) {
+  Reachability::Config cfg;
+  cfg.layerRadii = {100., 33., 70.};
+  Reachability reachability(cfg);
+  Acts::Vector3D origin(0., 0., 0.);
+
+  // from the origin the helix reaches twice its radius
+  const double R = 33. / 2.;
+  const double pT = R * 2. * au::_T;
+  for (double q : {1., -1.}) {
+    auto below = makeParticle(origin, Acts::Vector3D(0.99 * pT, 0., 1.), q);
+    auto above = makeParticle(origin, Acts::Vector3D(0., 1.01 * pT, 1.), q);
+    BOOST_CHECK_CLOSE(reachability.maxRadius(below), 2. * 0.99 * R, 1e-6);
+    BOOST_CHECK(reachability.check(below) == Reason::Curling);
+    BOOST_CHECK(reachability.check(above) == Reason::Reachable);
+  }
+
+  // the next layer is the one outside the particle, it is reached if
+  // the particle turns outwards
+  const double pT11 = 11. * 2. * au::_T;
+  Acts::Vector3D position(50., 0., 0.);
+  auto outward = makeParticle(position, Acts::Vector3D(0., pT11, 0.));
+  auto inward = makeParticle(position, Acts::Vector3D(0., pT11, 0.),
+                             pionMass, -1.);
+  auto radial = makeParticle(position, Acts::Vector3D(pT11, 0., 0.));
+  BOOST_CHECK_CLOSE(reachability.maxRadius(outward), 72., 1e-6);
+  BOOST_CHECK_CLOSE(reachability.maxRadius(inward), 50., 1e-6);
+  BOOST_CHECK(reachability.check(outward) == Reason::Reachable);
+  BOOST_CHECK(reachability.check(inward) == Reason::Curling);
+  BOOST_CHECK(reachability.check(radial) == Reason::Curling);
+
+  // neutral particles and other fields
+  auto neutral = makeParticle(origin, Acts::Vector3D(1e-3, 0., 0.), 0., 0.);
+  BOOST_CHECK(reachability.check(neutral) == Reason::Reachable);
+  cfg.bField = 0.;
+  Reachability noField(cfg);
+  auto slow = makeParticle(origin, Acts::Vector3D(1e-3, 0., 0.));
+  BOOST_CHECK(reachability.check(slow) == Reason::Curling);
+  BOOST_CHECK(noField.check(slow) == Reason::Reachable);
+}
+
+// This tests the eta envelope and the outermost layer
+BOOST_AUTO_TEST_CASE(Reachability_acceptance_test_) {
+  Reachability::Config cfg;
+  cfg.maxAbsEta = 2.5;
+  Reachability reachability(cfg);
+  Acts::Vector3D origin(0., 0., 0.);
+  for (double eta : {-3., -2., 0., 2., 3.}) {
+    Acts::Vector3D momentum(1., 0., std::sinh(eta));
+    Reason reason = reachability.check(makeParticle(origin, momentum));
+    BOOST_CHECK(reason == (std::abs(eta) > 2.5 ? Reason::Acceptance
+                                               : Reason::Reachable));
+  }
+
+  cfg.layerRadii = {33., 70.};
+  Reachability layers(cfg);
+  auto outside =
+      makeParticle(Acts::Vector3D(80., 0., 0.), Acts::Vector3D(1., 0., 0.));
+  BOOST_CHECK(layers.check(outside) == Reason::Acceptance);
+}
+
+// This tests the range in the material in front of the first layer
+BOOST_AUTO_TEST_CASE(Reachability_range_test_) {
+  const double gPerCm3 = 1. / (au::_cm * au::_cm * au::_cm);
+  Acts::Material beryllium(352.8, 407., 9.012, 4., 1.848 * gPerCm3);
+  Reachability::Config cfg;
+  cfg.material = Acts::MaterialProperties(beryllium, 1. * au::_mm);
+  Reachability reachability(cfg);
+  Acts::Vector3D origin(0., 0., 0.);
+
+  auto momentum = [](double m, double kineticEnergy) {
+    double E = m + kineticEnergy;
+    return Acts::Vector3D(std::sqrt(E * E - m * m), 0., 0.);
+  };
+  auto slow = makeParticle(origin, momentum(protonMass, 5. * au::_MeV),
+                           protonMass, 1., 2212);
+  auto fast = makeParticle(origin, momentum(protonMass, 50. * au::_MeV),
+                           protonMass, 1., 2212);
+  auto neutron = makeParticle(origin, momentum(protonMass, 1. * au::_MeV),
+                              protonMass, 0., 2112);
+  BOOST_CHECK(reachability.check(slow) == Reason::Range);
+  BOOST_CHECK(reachability.check(fast) == Reason::Reachable);
+  BOOST_CHECK(reachability.check(neutron) == Reason::Reachable);
+
+  // particles that start behind the material do not cross it
+  cfg.materialRadius = 30.;
+  Reachability withRadius(cfg);
+  Acts::Vector3D behind(40., 0., 0.);
+  auto slowBehind = makeParticle(behind, momentum(protonMass, 5. * au::_MeV),
+                                 protonMass, 1., 2212);
+  BOOST_CHECK(withRadius.check(slow) == Reason::Range);
+  BOOST_CHECK(withRadius.check(slowBehind) == Reason::Reachable);
+  cfg.materialRadius = std::numeric_limits<double>::infinity();
+  cfg.bField = 0.;
+  cfg.layerRadii = {33., 70.};
+  Reachability withLayers(cfg);
+  BOOST_CHECK(withLayers.check(slow) == Reason::Range);
+  BOOST_CHECK(withLayers.check(slowBehind) == Reason::Reachable);
+}
+
+// This tests the counters per reason
+BOOST_AUTO_TEST_CASE(Reachability_counters_test_) {
+  Reachability::Config cfg;
+  cfg.layerRadii = {33.};
+  cfg.maxAbsEta = 2.5;
+  Reachability reachability(cfg);
+  Acts::Vector3D origin(0., 0., 0.);
+
+  // without any configuration all particles are reachable
+  Reachability open;
+  BOOST_CHECK(open(makeParticle(origin, Acts::Vector3D(1e-3, 0., 1e3))));
+
+  BOOST_CHECK(reachability(makeParticle(origin, Acts::Vector3D(1., 0., 0.))));
+  BOOST_CHECK(
+      not reachability(makeParticle(origin, Acts::Vector3D(1e-3, 0., 0.))));
+  BOOST_CHECK(
+      not reachability(makeParticle(origin, Acts::Vector3D(1e-3, 0., 0.))));
+  BOOST_CHECK(
+      not reachability(makeParticle(origin, Acts::Vector3D(1., 0., 100.))));
+
+  auto counters = reachability.counters();
+  BOOST_CHECK_EQUAL(counters.checked, 4u);
+  BOOST_CHECK_EQUAL(counters.skipped[int(Reason::Reachable)], 0u);
+  BOOST_CHECK_EQUAL(counters.skipped[int(Reason::Curling)], 2u);
+  BOOST_CHECK_EQUAL(counters.skipped[int(Reason::Acceptance)], 1u);
+  BOOST_CHECK_EQUAL(counters.skipped[int(Reason::Range)], 0u);
+  BOOST_CHECK_EQUAL(open.counters().checked, 1u);
+}
+
+} // namespace Test
+
+} // namespace Fatras
@@ -0,0 +1,186 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE SelectorCache Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/Process.hpp"
+#include "Fatras/Kernel/SelectorCache.hpp"
+#include "Fatras/Kernel/SelectorExpression.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Kernel/SpeciesPhysicsList.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/KinematicCasts.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include "Fatras/Selectors/SelectorHelpers.hpp"
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+struct Generator {};
+
+struct Detector {};
+
+/// Particle that counts the access to its properties
+struct CountingParticle {
+  Acts::Vector3D m_position = Acts::Vector3D(1., 2., 3.);
+  Acts::Vector3D m_momentum = Acts::Vector3D(1., 1., 0.5);
+  double m_q = 1.;
+  int m_pdg = 211;
+
+  mutable int momentumCalls = 0;
+  mutable int chargeCalls = 0;
+
+  const Acts::Vector3D &position() const { return m_position; }
+  const Acts::Vector3D &momentum() const {
+    ++momentumCalls;
+    return m_momentum;
+  }
+  double q() const {
+    ++chargeCalls;
+    return m_q;
+  }
+  int pdg() const { return m_pdg; }
+};
+
+/// Physics that halves the momentum
+struct Halving {
+  template <typename generator_t, typename detector_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &, const detector_t &,
+                                     particle_t &particle) const {
+    particle.m_momentum *= 0.5;
+    return {};
+  }
+};
+
+/// Physics that does nothing
+struct Sterile {
+  template <typename generator_t, typename detector_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &, const detector_t &,
+                                     particle_t &) const {
+    return {};
+  }
+};
+
+typedef SelectorListAND<> All;
+typedef SelectorListAND<ChargedSelector, AbsPdgSelector<211>> ChargedPion;
+
+// the memoised selectors of a physics list
+static_assert(detail::is_identity_selector<ChargedPion>::value);
+static_assert(!detail::is_identity_selector<Min<casts::p>>::value);
+static_assert(
+    std::is_same_v<
+        detail::physics_list_cache_t<
+            Process<Sterile, ChargedPion, All, All>,
+            Process<Halving, ChargedPion, Max<casts::p>, All>>,
+        SelectorCache<ChargedPion, ChargedSelector, AbsPdgSelector<211>>>);
+
+// This tests the shared kinematics within one selector list
+BOOST_AUTO_TEST_CASE(SelectorCache_kinematics) {
+  Detector detector;
+  CountingParticle particle;
+
+  typedef SelectorListAND<Range<casts::absEta>, Min<casts::eta>,
+                          Max<casts::eta>, Min<casts::pT>, Max<casts::pT>>
+      Kinematic;
+  Kinematic kinematic;
+  kinematic.get<Min<casts::eta>>().valMin = -1.;
+  kinematic.get<Max<casts::eta>>().valMax = 1.;
+  kinematic.get<Range<casts::absEta>>().valMax = 1.;
+
+  // eta and pT are derived once each
+  BOOST_TEST(kinematic(detector, particle));
+  BOOST_TEST(particle.momentumCalls == 2);
+
+  // the same is true within expressions
+  particle.momentumCalls = 0;
+  And<Kinematic, Not<Min<casts::absEta>>> expression;
+  expression.get<Kinematic>() = kinematic;
+  expression.get<Not<Min<casts::absEta>>>().term.valMin = 1.;
+  BOOST_TEST(expression(detector, particle));
+  BOOST_TEST(particle.momentumCalls == 2);
+
+  // a cache can be handed over and invalidated
+  particle.momentumCalls = 0;
+  SelectorCache<> cache;
+  BOOST_TEST(kinematic(detector, particle, cache));
+  BOOST_TEST(kinematic(detector, particle, cache));
+  BOOST_TEST(particle.momentumCalls == 2);
+  cache.invalidate();
+  BOOST_TEST(kinematic(detector, particle, cache));
+  BOOST_TEST(particle.momentumCalls == 4);
+}
+
+// This tests the memoised selectors across the processes
+BOOST_AUTO_TEST_CASE(SelectorCache_physicsList) {
+  Generator generator;
+  Detector detector;
+  std::vector<CountingParticle> out;
+
+  typedef Process<Sterile, ChargedPion, ChargedPion, All> FirstProcess;
+  typedef Process<Sterile, ChargedPion, ChargedSelector, All> SecondProcess;
+  PhysicsList<FirstProcess, SecondProcess> physicsList;
+
+  // the charge is checked once for the four selectors,
+  // the charged selector reads it twice
+  CountingParticle particle;
+  BOOST_TEST(!physicsList(generator, detector, particle, out));
+  BOOST_TEST(particle.chargeCalls == 2);
+
+  // the same in the species specialised lists
+  particle.chargeCalls = 0;
+  SpeciesPhysicsList<species::Any, FirstProcess, SecondProcess> speciesList;
+  BOOST_TEST(!speciesList(generator, detector, particle, out));
+  BOOST_TEST(particle.chargeCalls == 2);
+
+  // a process alone evaluates both of its selectors
+  particle.chargeCalls = 0;
+  BOOST_TEST(!FirstProcess()(generator, detector, particle, out));
+  BOOST_TEST(particle.chargeCalls == 4);
+}
+
+// This tests that modified kinematics are seen by the next process
+BOOST_AUTO_TEST_CASE(SelectorCache_invalidation) {
+  Generator generator;
+  Detector detector;
+  std::vector<CountingParticle> out;
+
+  // the first process halves the momentum, the second one kills
+  // particles below the threshold
+  typedef Process<Halving, Min<casts::p>, All, All> Loss;
+  typedef Process<Sterile, All, Min<casts::p>, All> Threshold;
+  PhysicsList<Loss, Threshold> physicsList;
+  physicsList.get<Loss>().selectorIn.valMin = 1.;
+  physicsList.get<Threshold>().selectorOut.valMin = 1.;
+
+  CountingParticle particle;
+  double p = particle.m_momentum.norm();
+  BOOST_TEST(p > 1.);
+  BOOST_TEST(p < 2.);
+  // the cached momentum before the loss must not be used afterwards
+  BOOST_TEST(physicsList(generator, detector, particle, out));
+  BOOST_TEST(particle.m_momentum.norm() == 0.5 * p, tt::tolerance(1e-12));
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,284 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE SelectorExpression Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/ParticleBatch.hpp"
+#include "Fatras/Kernel/SelectorExpression.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/KinematicCasts.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include "Fatras/Selectors/SelectorHelpers.hpp"
+#include "Particle.hpp"
+#include <random>
+#include <string>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+struct Detector {};
+
+/// Selector that records its evaluation
+template <unsigned int cost_t, bool accept_t> struct Recording {
+  static constexpr unsigned int cost = cost_t;
+
+  std::string *record = nullptr;
+
+  template <typename detector_t, typename particle_t>
+  bool operator()(const detector_t &, const particle_t &) const {
+    *record += std::to_string(cost_t);
+    return accept_t;
+  }
+
+  template <typename detector_t>
+  void operator()(const detector_t &, const ParticleBatch &batch,
+                  std::uint8_t *mask) const {
+    *record += std::to_string(cost_t);
+    for (std::size_t i = 0; i < batch.size; ++i) {
+      mask[i] = accept_t;
+    }
+  }
+};
+
+/// The particle columns for the batch tests
+struct Columns {
+  std::vector<double> x, y, z, px, py, pz, m, q;
+  std::vector<int> pdg;
+
+  void push_back(const Particle &particle) {
+    x.push_back(particle.position().x());
+    y.push_back(particle.position().y());
+    z.push_back(particle.position().z());
+    px.push_back(particle.momentum().x());
+    py.push_back(particle.momentum().y());
+    pz.push_back(particle.momentum().z());
+    m.push_back(particle.m());
+    q.push_back(particle.q());
+    pdg.push_back(particle.pdg());
+  }
+
+  ParticleBatch batch() const {
+    return {x.size(), x.data(),  y.data(), z.data(), px.data(),
+            py.data(), pz.data(), m.data(), q.data(), pdg.data()};
+  }
+};
+
+/// Create random particles
+std::vector<Particle> randomParticles(std::size_t n) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> momentum(-5., 5.);
+  std::uniform_real_distribution<double> vertex(-200., 200.);
+  std::uniform_int_distribution<int> type(0, 4);
+  const int pdgs[] = {11, -13, 211, -211, 22};
+  std::vector<Particle> particles;
+  for (std::size_t i = 0; i < n; ++i) {
+    int pdg = pdgs[type(generator)];
+    double q = (pdg == 22) ? 0. : (pdg > 0 ? -1. : 1.);
+    if (pdg == 211 or pdg == -211) {
+      q = -q;
+    }
+    Acts::Vector3D position(0.1 * vertex(generator), 0.1 * vertex(generator),
+                            vertex(generator));
+    Acts::Vector3D p(momentum(generator), momentum(generator),
+                     momentum(generator));
+    particles.emplace_back(position, p * Acts::units::_GeV,
+                           0.1 * Acts::units::_GeV, q, pdg, i + 1);
+  }
+  return particles;
+}
+
+typedef Recording<1, false> CheapReject;
+typedef Recording<1, true> CheapAccept;
+typedef Recording<5, true> ExpensiveAccept;
+typedef Recording<9, false> ExpensiveReject;
+
+// the evaluation order
+static_assert(CostOrderedAnd<ExpensiveAccept, CheapReject>::cost == 6);
+constexpr auto costOrder =
+    detail::evaluation_order<true, ExpensiveReject, ExpensiveAccept,
+                             CheapReject>();
+static_assert(costOrder[0] == 2 and costOrder[1] == 1 and costOrder[2] == 0);
+constexpr auto givenOrder =
+    detail::evaluation_order<false, ExpensiveReject, CheapReject>();
+static_assert(givenOrder[0] == 0 and givenOrder[1] == 1);
+static_assert(detail::selector_cost_v<Range<casts::absEta>> ==
+              casts::absEta::cost);
+static_assert(detail::selector_cost_v<ChargedSelector> == 1);
+
+// This tests the single particle evaluation
+BOOST_AUTO_TEST_CASE(SelectorExpression_single) {
+  Detector detector;
+  Particle particle = randomParticles(1)[0];
+  std::string record;
+
+  // empty expressions are the identities
+  BOOST_TEST(And<>()(detector, particle));
+  BOOST_TEST(!Or<>()(detector, particle));
+
+  // declared order with short-circuit
+  And<ExpensiveAccept, CheapReject> andExpression;
+  andExpression.get<ExpensiveAccept>().record = &record;
+  andExpression.get<CheapReject>().record = &record;
+  BOOST_TEST(!andExpression(detector, particle));
+  BOOST_TEST(record == "51");
+
+  // the cost ordered version rejects before the expensive term
+  record.clear();
+  CostOrderedAnd<ExpensiveAccept, CheapReject> orderedAnd;
+  orderedAnd.get<ExpensiveAccept>().record = &record;
+  orderedAnd.get<CheapReject>().record = &record;
+  BOOST_TEST(!orderedAnd(detector, particle));
+  BOOST_TEST(record == "1");
+
+  // the same for the disjunction
+  record.clear();
+  CostOrderedOr<ExpensiveReject, CheapAccept> orderedOr;
+  orderedOr.get<ExpensiveReject>().record = &record;
+  orderedOr.get<CheapAccept>().record = &record;
+  BOOST_TEST(orderedOr(detector, particle));
+  BOOST_TEST(record == "1");
+
+  // negation and nesting
+  record.clear();
+  Or<Not<CheapReject>, ExpensiveReject> nested;
+  nested.get<Not<CheapReject>>().term.record = &record;
+  nested.get<ExpensiveReject>().record = &record;
+  BOOST_TEST(nested(detector, particle));
+  BOOST_TEST(record == "1");
+}
+
+// This tests that the batch evaluation agrees with the single particles
+BOOST_AUTO_TEST_CASE(SelectorExpression_batch) {
+  Detector detector;
+  // not a multiple of the cast chunk size
+  auto particles = randomParticles(1000);
+  Columns columns;
+  for (const auto &particle : particles) {
+    columns.push_back(particle);
+  }
+  ParticleBatch batch = columns.batch();
+
+  // a typical preselection
+  typedef Range<casts::absEta> EtaRange;
+  typedef Min<casts::pT> PtMin;
+  typedef Max<casts::AbsVz> VzMax;
+  typedef CostOrderedAnd<
+      EtaRange, PtMin, VzMax,
+      Or<ChargedSelector, Not<AbsPdgSelector<22>>, PdgSelector<-13>>>
+      Preselection;
+  Preselection preselection;
+  preselection.get<EtaRange>().valMax = 2.5;
+  preselection.get<PtMin>().valMin = 1. * Acts::units::_GeV;
+  preselection.get<VzMax>().valMax = 150. * Acts::units::_mm;
+
+  std::vector<std::uint8_t> mask;
+  std::size_t nSelected = selectBatch(preselection, detector, batch, mask);
+  BOOST_TEST(mask.size() == particles.size());
+
+  std::size_t nExpected = 0;
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    bool selected = preselection(detector, particles[i]);
+    nExpected += selected;
+    BOOST_TEST(bool(mask[i]) == selected);
+  }
+  BOOST_TEST(nSelected == nExpected);
+  BOOST_TEST(nSelected > 0u);
+  BOOST_TEST(nSelected < particles.size());
+
+  // the selector lists support the batch path as well
+  typedef SelectorListOR<NegativeSelector, Min<casts::E>> OrList;
+  OrList orList;
+  orList.get<Min<casts::E>>().valMin = 6. * Acts::units::_GeV;
+  typedef SelectorListAND<PositiveSelector, Range<casts::eta>,
+                          Max<casts::vR>, Min<casts::vZ>, Max<casts::p>,
+                          AbsPdgExcluder<211>, PdgExcluder<22>>
+      AndList;
+  AndList andList;
+  andList.get<Range<casts::eta>>().valMin = -1.;
+  andList.get<Range<casts::eta>>().valMax = 3.;
+  andList.get<Max<casts::vR>>().valMax = 15.;
+  andList.get<Min<casts::vZ>>().valMin = -100.;
+  andList.get<Max<casts::p>>().valMax = 7. * Acts::units::_GeV;
+
+  selectBatch(orList, detector, batch, mask);
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    BOOST_TEST(bool(mask[i]) == orList(detector, particles[i]));
+  }
+  selectBatch(andList, detector, batch, mask);
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    BOOST_TEST(bool(mask[i]) == andList(detector, particles[i]));
+  }
+  BOOST_TEST(selectBatch(SelectorListAND<>(), detector, batch, mask) ==
+             particles.size());
+  BOOST_TEST(selectBatch(Or<>(), detector, batch, mask) == 0u);
+
+  // the scratch buffer is sized once for the nesting and can be reused
+  static_assert(Preselection::scratchRows == 2);
+  std::vector<std::uint8_t> scratch;
+  BOOST_TEST(selectBatch(preselection, detector, batch, mask, scratch) ==
+             nSelected);
+  BOOST_TEST(scratch.size() == 2 * particles.size());
+  const auto *data = scratch.data();
+  BOOST_TEST(selectBatch(preselection, detector, batch, mask, scratch) ==
+             nSelected);
+  BOOST_TEST(scratch.data() == data);
+}
+
+// This tests the cost order and the early stop of the batch evaluation
+BOOST_AUTO_TEST_CASE(SelectorExpression_batch_order) {
+  Detector detector;
+  Columns columns;
+  for (const auto &particle : randomParticles(10)) {
+    columns.push_back(particle);
+  }
+  ParticleBatch batch = columns.batch();
+  std::vector<std::uint8_t> mask;
+  std::string record;
+
+  // the cheap term rejects all particles, the expensive one is skipped
+  CostOrderedAnd<ExpensiveAccept, CheapReject> costAnd;
+  costAnd.get<ExpensiveAccept>().record = &record;
+  costAnd.get<CheapReject>().record = &record;
+  BOOST_TEST(selectBatch(costAnd, detector, batch, mask) == 0u);
+  BOOST_TEST(record == "1");
+
+  // the given order is kept otherwise
+  record.clear();
+  And<ExpensiveAccept, CheapReject> plainAnd;
+  plainAnd.get<ExpensiveAccept>().record = &record;
+  plainAnd.get<CheapReject>().record = &record;
+  BOOST_TEST(selectBatch(plainAnd, detector, batch, mask) == 0u);
+  BOOST_TEST(record == "51");
+
+  // a disjunction stops when all particles are accepted
+  record.clear();
+  CostOrderedOr<ExpensiveReject, CheapAccept> costOr;
+  costOr.get<ExpensiveReject>().record = &record;
+  costOr.get<CheapAccept>().record = &record;
+  BOOST_TEST(selectBatch(costOr, detector, batch, mask) == 10u);
+  BOOST_TEST(record == "1");
+}
+
+} // namespace Test
+} // namespace Fatras
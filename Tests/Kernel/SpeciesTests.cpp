@@ -0,0 +1,252 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Species Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/PhysicsList.hpp"
+#include "Fatras/Kernel/Process.hpp"
+#include "Fatras/Kernel/SelectorList.hpp"
+#include "Fatras/Kernel/Species.hpp"
+#include "Fatras/Kernel/SpeciesPhysicsList.hpp"
+#include "Fatras/Physics/Scattering/GeneralMixture.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include "Fatras/Selectors/ChargeSelectors.hpp"
+#include "Fatras/Selectors/PdgSelectors.hpp"
+#include "Particle.hpp"
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+
+namespace Fatras {
+
+namespace Test {
+
+// the generator
+typedef std::mt19937 Generator;
+
+struct Detector {};
+
+/// Selector that is only known at run time
+struct Selector {
+  template <typename detector_t, typename particle_t>
+  bool operator()(const detector_t &, const particle_t &) const {
+    return true;
+  }
+};
+
+/// Physics that counts how often it is called
+struct CountingPhysics {
+  int *calls = nullptr;
+
+  template <typename generator_t, typename detector_t, typename particle_t>
+  std::vector<particle_t> operator()(generator_t &, const detector_t &,
+                                     particle_t &) const {
+    ++(*calls);
+    return {};
+  }
+};
+
+typedef SelectorListAND<> All;
+
+// the tri-state selector decisions
+static_assert(species_acceptance_v<AbsPdgSelector<11>, species::Electron> ==
+              Acceptance::Always);
+static_assert(species_acceptance_v<AbsPdgSelector<11>, species::Muon> ==
+              Acceptance::Never);
+static_assert(species_acceptance_v<AbsPdgSelector<11>, species::Any> ==
+              Acceptance::Runtime);
+static_assert(species_acceptance_v<AbsPdgSelector<11>,
+                                   species::ChargedHadron> ==
+              Acceptance::Runtime);
+static_assert(species_acceptance_v<PdgSelector<11>, species::Electron> ==
+              Acceptance::Runtime);
+static_assert(species_acceptance_v<PdgSelector<22>, species::Muon> ==
+              Acceptance::Never);
+static_assert(species_acceptance_v<AbsPdgExcluder<13>, species::Muon> ==
+              Acceptance::Never);
+static_assert(species_acceptance_v<ChargedSelector, species::Photon> ==
+              Acceptance::Never);
+static_assert(species_acceptance_v<NeutralSelector, species::Photon> ==
+              Acceptance::Always);
+static_assert(species_acceptance_v<ChargedSelector, species::Any> ==
+              Acceptance::Runtime);
+static_assert(species_acceptance_v<Selector, species::Muon> ==
+              Acceptance::Runtime);
+
+// the combination in selector lists
+static_assert(species_acceptance_v<All, species::Muon> == Acceptance::Always);
+static_assert(
+    species_acceptance_v<SelectorListAND<ChargedSelector, Selector>,
+                         species::Photon> == Acceptance::Never);
+static_assert(
+    species_acceptance_v<SelectorListAND<ChargedSelector, Selector>,
+                         species::Muon> == Acceptance::Runtime);
+static_assert(
+    species_acceptance_v<SelectorListAND<ChargedSelector, AbsPdgSelector<13>>,
+                         species::Muon> == Acceptance::Always);
+static_assert(
+    species_acceptance_v<SelectorListOR<Selector, AbsPdgSelector<13>>,
+                         species::Muon> == Acceptance::Always);
+static_assert(
+    species_acceptance_v<SelectorListOR<AbsPdgSelector<11>, AbsPdgSelector<22>>,
+                         species::Muon> == Acceptance::Never);
+
+Acts::Vector3D position(0., 0., 0.);
+Acts::Vector3D momentum(1. * Acts::units::_GeV, 0., 0.);
+
+Particle electron(position, momentum, 0.511 * Acts::units::_MeV, -1., 11, 1);
+Particle muon(position, momentum, 105.658367 * Acts::units::_MeV, -1., 13, 2);
+Particle pion(position, momentum, 139.57 * Acts::units::_MeV, 1., 211, 3);
+Particle photon(position, momentum, 0., 0., 22, 4);
+
+// This tests the species classification
+BOOST_AUTO_TEST_CASE(Species_contains) {
+  BOOST_TEST(species::Electron::contains(electron));
+  BOOST_TEST(!species::Electron::contains(muon));
+  BOOST_TEST(species::Muon::contains(muon));
+  BOOST_TEST(species::ChargedHadron::contains(pion));
+  BOOST_TEST(!species::ChargedHadron::contains(electron));
+  BOOST_TEST(!species::ChargedHadron::contains(photon));
+  BOOST_TEST(species::Photon::contains(photon));
+  BOOST_TEST(species::Any::contains(pion));
+
+  BOOST_TEST(species::physicsPdg<species::Muon>(muon) == 13);
+  BOOST_TEST(species::physicsPdg<species::Any>(pion) == 211);
+}
+
+// This tests that processes are dropped at compile time
+BOOST_AUTO_TEST_CASE(SpeciesPhysicsList_dropping) {
+  Generator generator;
+  Detector detector;
+  std::vector<Particle> out;
+
+  typedef Process<CountingPhysics, AbsPdgSelector<11>, All, All> ElectronOnly;
+  typedef Process<CountingPhysics, ChargedSelector, All, All> ChargedOnly;
+
+  int electronCalls = 0;
+  int chargedCalls = 0;
+
+  // the muon list never calls the electron process
+  SpeciesPhysicsList<species::Muon, ElectronOnly, ChargedOnly> muonList;
+  muonList.get<ElectronOnly>().process.calls = &electronCalls;
+  muonList.get<ChargedOnly>().process.calls = &chargedCalls;
+
+  // even when given an electron, the selection is decided by the species
+  Particle in = electron;
+  BOOST_TEST(!muonList(generator, detector, in, out));
+  BOOST_TEST(electronCalls == 0);
+  BOOST_TEST(chargedCalls == 1);
+
+  // the generic path still selects at run time
+  PhysicsList<ElectronOnly, ChargedOnly> genericList;
+  genericList.get<ElectronOnly>().process.calls = &electronCalls;
+  genericList.get<ChargedOnly>().process.calls = &chargedCalls;
+  BOOST_TEST(!genericList(generator, detector, in, out));
+  BOOST_TEST(electronCalls == 1);
+  BOOST_TEST(chargedCalls == 2);
+
+  // an out selector that is never passed kills the particle
+  typedef Process<CountingPhysics, All, NeutralSelector, All> KillCharged;
+  SpeciesPhysicsList<species::Muon, KillCharged> killList;
+  killList.get<KillCharged>().process.calls = &chargedCalls;
+  BOOST_TEST(killList(generator, detector, in, out));
+  BOOST_TEST(chargedCalls == 3);
+}
+
+// This tests the dispatch to the species lists
+BOOST_AUTO_TEST_CASE(SpeciesDispatch_routing) {
+  Generator generator;
+  Detector detector;
+  std::vector<Particle> out;
+
+  typedef Process<CountingPhysics, All, All, All> Counting;
+
+  int electronCalls = 0;
+  int muonCalls = 0;
+  int hadronCalls = 0;
+
+  typedef SpeciesPhysicsList<species::Electron, Counting> ElectronList;
+  typedef SpeciesPhysicsList<species::Muon, Counting> MuonList;
+  typedef SpeciesPhysicsList<species::ChargedHadron, Counting> HadronList;
+  typedef SpeciesDispatch<ElectronList, MuonList, HadronList> Dispatch;
+
+  static_assert(is_species_dispatch_v<Dispatch>);
+  static_assert(!is_species_dispatch_v<PhysicsList<Counting>>);
+  static_assert(Dispatch::nSpecies == 4);
+
+  Dispatch dispatch;
+  dispatch.get<ElectronList>().get<Counting>().process.calls = &electronCalls;
+  dispatch.get<MuonList>().get<Counting>().process.calls = &muonCalls;
+  dispatch.get<HadronList>().get<Counting>().process.calls = &hadronCalls;
+
+  BOOST_TEST(Dispatch::speciesIndex(electron) == 0);
+  BOOST_TEST(Dispatch::speciesIndex(muon) == 1);
+  BOOST_TEST(Dispatch::speciesIndex(pion) == 2);
+  BOOST_TEST(Dispatch::speciesIndex(photon) == 3);
+
+  // deduced per call
+  for (Particle in : {electron, muon, muon, pion, photon}) {
+    dispatch(generator, detector, in, out);
+  }
+  BOOST_TEST(electronCalls == 1);
+  BOOST_TEST(muonCalls == 2);
+  BOOST_TEST(hadronCalls == 1);
+
+  // fixed by the caller
+  dispatch.species = 2;
+  Particle in = muon;
+  dispatch(generator, detector, in, out);
+  BOOST_TEST(muonCalls == 2);
+  BOOST_TEST(hadronCalls == 2);
+}
+
+// This tests the species specialised physics modules
+BOOST_AUTO_TEST_CASE(SpeciesPhysics_modules) {
+  Generator generator;
+  Acts::Material berilium = Acts::Material(352.8, 407., 9.012, 4., 1.848e-3);
+  Acts::MaterialProperties detector(berilium, 1. * Acts::units::_mm);
+
+  // the specialised modules sample the same angles as the generic ones
+  Generator genericGenerator;
+  Particle in = muon;
+  BasicHighland<double, species::Muon> muonHighland;
+  Highland highland;
+  for (unsigned int i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(muonHighland(generator, detector, in),
+                      highland(genericGenerator, detector, in));
+  }
+
+  // electrons fall back to a gaussian scattering in the general mixture
+  in = electron;
+  BasicGeneralMixture<double, species::Electron> electronMixture;
+  GeneralMixture mixture;
+  double sum = 0.;
+  for (unsigned int i = 0; i < 100; ++i) {
+    double theta = electronMixture(generator, detector, in);
+    BOOST_CHECK_EQUAL(theta, mixture(genericGenerator, detector, in));
+    sum += std::abs(theta);
+  }
+  BOOST_TEST(sum > 0.);
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,133 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE TruthGraph Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Kernel/TruthGraph.hpp"
+#include "Particle.hpp"
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+typedef TruthGraph::Index Index;
+
+/// Collect a range for the comparison
+std::vector<Index> collect(TruthGraph::Range range) {
+  return std::vector<Index>(range.begin(), range.end());
+}
+
+// This tests an empty graph
+BOOST_AUTO_TEST_CASE(TruthGraph_empty_test_) {
+  TruthGraph graph;
+  graph.build();
+  BOOST_CHECK_EQUAL(graph.vertices(), 0u);
+  BOOST_CHECK_EQUAL(graph.particles(), 0u);
+}
+
+// This tests the relations of a small hand-made event
+//
+//  v0 -> 0, 1, 2
+//  0 -> v1 -> 3, 4
+//  2 -> v2 -> 5
+//  3 -> v3 -> 6
+//  0 -> v4 -> 7
+BOOST_AUTO_TEST_CASE(TruthGraph_relations_test_) {
+  TruthGraph graph;
+  Acts::Vector3D origin(0., 0., 0.);
+  Index v0 = graph.addVertex(origin, 0.);
+  Index v1 = graph.addVertex(Acts::Vector3D(0., 0., 10.), 1., 0);
+  Index v2 = graph.addVertex(Acts::Vector3D(0., 10., 0.), 1., 2);
+  Index v3 = graph.addVertex(Acts::Vector3D(10., 0., 0.), 2., 3);
+  Index v4 = graph.addVertex(Acts::Vector3D(0., 0., 20.), 3., 0);
+  // the edges are recorded out of vertex order
+  graph.addOutgoing(v1, 3);
+  graph.addOutgoing(v0, 0);
+  graph.addOutgoing(v0, 1);
+  graph.addOutgoing(v2, 5);
+  graph.addOutgoing(v1, 4);
+  graph.addOutgoing(v0, 2);
+  graph.addOutgoing(v3, 6);
+  graph.addOutgoing(v4, 7);
+  graph.build();
+
+  BOOST_CHECK_EQUAL(graph.vertices(), 5u);
+  BOOST_CHECK_EQUAL(graph.particles(), 8u);
+
+  // vertex -> outgoing, in recording order
+  BOOST_CHECK(collect(graph.outgoing(v0)) == std::vector<Index>({0, 1, 2}));
+  BOOST_CHECK(collect(graph.outgoing(v1)) == std::vector<Index>({3, 4}));
+  BOOST_CHECK(collect(graph.outgoing(v4)) == std::vector<Index>({7}));
+
+  // particle -> production vertex and parent
+  BOOST_CHECK_EQUAL(graph.productionVertex(1), v0);
+  BOOST_CHECK_EQUAL(graph.productionVertex(6), v3);
+  BOOST_CHECK_EQUAL(graph.parent(1), TruthGraph::invalid);
+  BOOST_CHECK_EQUAL(graph.parent(4), 0u);
+  BOOST_CHECK_EQUAL(graph.parent(6), 3u);
+  BOOST_CHECK_EQUAL(graph.vertex(graph.productionVertex(6)).time, 2.);
+
+  // particle -> end vertices and children
+  BOOST_CHECK(collect(graph.endVertices(0)) == std::vector<Index>({v1, v4}));
+  BOOST_CHECK(graph.endVertices(1).empty());
+  BOOST_CHECK(collect(graph.children(0)) == std::vector<Index>({3, 4, 7}));
+  BOOST_CHECK(collect(graph.children(2)) == std::vector<Index>({5}));
+  BOOST_CHECK(graph.children(7).empty());
+
+  // the graph is reused for the next event
+  graph.clear();
+  graph.build();
+  BOOST_CHECK_EQUAL(graph.vertices(), 0u);
+}
+
+// This tests the grouping of secondaries into vertices
+BOOST_AUTO_TEST_CASE(TruthGraph_secondaries_test_) {
+  Acts::Vector3D momentum(0., 0., 1. * au::_GeV);
+  Acts::Vector3D first(0., 0., 100.);
+  Acts::Vector3D second(0., 0., 200.);
+  std::vector<Particle> secondaries = {
+      Particle(first, momentum, 0.1, 1., 211, 0, 1.),
+      Particle(first, momentum, 0.1, -1., -211, 0, 1.),
+      Particle(second, momentum, 0., 0., 22, 0, 2.)};
+
+  TruthGraph graph;
+  Index primary = graph.addVertex(Acts::Vector3D(0., 0., 0.), 0.);
+  graph.addOutgoing(primary, 0);
+  graph.addOutgoing(primary, 1);
+  graph.addSecondaries(0, 2, secondaries);
+  graph.build();
+
+  BOOST_CHECK_EQUAL(graph.vertices(), 3u);
+  BOOST_CHECK_EQUAL(graph.particles(), 5u);
+  BOOST_CHECK(collect(graph.endVertices(0)) == std::vector<Index>({1, 2}));
+  BOOST_CHECK(collect(graph.outgoing(1)) == std::vector<Index>({2, 3}));
+  BOOST_CHECK(collect(graph.outgoing(2)) == std::vector<Index>({4}));
+  BOOST_CHECK(collect(graph.children(0)) == std::vector<Index>({2, 3, 4}));
+  BOOST_CHECK_EQUAL(graph.vertex(2).position, second);
+  BOOST_CHECK_EQUAL(graph.parent(4), 0u);
+  BOOST_CHECK(graph.children(1).empty());
+}
+
+} // namespace Test
+} // namespace Fatras
@@ -0,0 +1,260 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE AdaptivePhysics Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Physics/EnergyLoss/AdaptiveBetheBloch.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheBloch.hpp"
+#include "Fatras/Physics/Scattering/AdaptiveAngle.hpp"
+#include "Fatras/Physics/Scattering/GaussianMixture.hpp"
+#include "Fatras/Physics/Scattering/Scattering.hpp"
+#include "Particle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+// the generator
+typedef std::mt19937 Generator;
+
+// some materials
+Acts::Material silicon = Acts::Material(93.7, 465.2, 28.0855, 14.,
+                                        2.329 / (au::_cm * au::_cm * au::_cm));
+Acts::Material iron = Acts::Material(17.57, 169.8, 55.845, 26.,
+                                     7.874 / (au::_cm * au::_cm * au::_cm));
+
+// a thin tracking layer and a thick absorber
+Acts::MaterialProperties thinLayer(silicon, 0.3 * au::_mm);
+Acts::MaterialProperties thickLayer(iron, 5. * au::_mm);
+
+const double muonMass = 105.658367 * au::_MeV;
+
+Particle makeMuon(double p) {
+  return Particle(Acts::Vector3D(0., 0., 0.), p * Acts::Vector3D(1., 0., 0.),
+                  muonMass, -1., 13, 1);
+}
+
+/// A histogram with the given bin width, centred at 0, and overflows
+struct Histogram {
+  double width;
+  std::vector<double> counts = std::vector<double>(103, 0.);
+
+  void fill(double x) {
+    long bin = std::lround(x / width);
+    bin = std::max(-51l, std::min(51l, bin));
+    counts[bin + 51] += 1.;
+  }
+};
+
+/// The chi2 per degree of freedom of two histograms of equal entries
+double chi2ndf(const Histogram &a, const Histogram &b) {
+  double chi2 = 0.;
+  int nBins = 0;
+  for (std::size_t i = 0; i < a.counts.size(); ++i) {
+    double sum = a.counts[i] + b.counts[i];
+    if (sum > 0.) {
+      chi2 += (a.counts[i] - b.counts[i]) * (a.counts[i] - b.counts[i]) / sum;
+      ++nBins;
+    }
+  }
+  return chi2 / std::max(nBins - 1, 1);
+}
+
+/// @brief Simulate muons through a stack of ten layers
+///
+/// The momenta are log-uniform in [0.1, 100] GeV.
+///
+/// @param process is the physics process
+/// @param layer is the material of each layer
+/// @param seed is the seed of the generator
+/// @param observable is histogrammed after the stack
+template <typename process_t, typename observable_t>
+Histogram simulate(const process_t &process,
+                   const Acts::MaterialProperties &layer, unsigned int seed,
+                   double width, observable_t observable) {
+  Generator generator(seed);
+  std::uniform_real_distribution<double> logP(-1., 2.);
+  Histogram histogram{width};
+  for (int i = 0; i < 20000; ++i) {
+    double p = std::pow(10., logP(generator)) * au::_GeV;
+    Particle particle = makeMuon(p);
+    for (int l = 0; l < 10; ++l) {
+      process(generator, layer, particle);
+    }
+    histogram.fill(observable(particle, p));
+  }
+  return histogram;
+}
+
+// the deflection in the bending plane
+double deflection(const Particle &particle, double) {
+  return std::atan2(particle.momentum().y(), particle.momentum().x());
+}
+
+// the relative momentum loss
+double momentumLoss(const Particle &particle, double p) {
+  return 1. - particle.p() / p;
+}
+
+// This tests the choice of the scattering formula
+BOOST_AUTO_TEST_CASE(AdaptiveAngle_regime_test_) {
+  using Regime = AdaptiveAngle<>::Regime;
+  AdaptiveAngle<> angle;
+  // thin layers are accurate, thick ones only at low momentum
+  BOOST_CHECK(angle.regime(thinLayer, makeMuon(10. * au::_GeV)) ==
+              Regime::Accurate);
+  BOOST_CHECK(angle.regime(thickLayer, makeMuon(10. * au::_GeV)) ==
+              Regime::Fast);
+  BOOST_CHECK(angle.regime(thickLayer, makeMuon(0.5 * au::_GeV)) ==
+              Regime::Accurate);
+  angle.thinScale = 0.;
+  BOOST_CHECK(angle.regime(thinLayer, makeMuon(10. * au::_GeV)) ==
+              Regime::Fast);
+
+  // above a momentum the deflection is below the resolution
+  angle.resolution = 3e-5;
+  BOOST_CHECK(angle.regime(thinLayer, makeMuon(100. * au::_GeV)) ==
+              Regime::Skip);
+  BOOST_CHECK(angle.regime(thickLayer, makeMuon(100. * au::_GeV)) ==
+              Regime::Fast);
+  // a fixed species decides the same for its particles
+  using MuonAngle = AdaptiveAngle<GeneralMixture, Highland, species::Muon>;
+  MuonAngle muonAngle;
+  muonAngle.resolution = angle.resolution;
+  BOOST_CHECK(muonAngle.regime(thinLayer, makeMuon(100. * au::_GeV)) ==
+              MuonAngle::Regime::Skip);
+  BOOST_CHECK(muonAngle.regime(thickLayer, makeMuon(100. * au::_GeV)) ==
+              MuonAngle::Regime::Fast);
+
+  Generator generator(11);
+  Scattering<AdaptiveAngle<>> scattering;
+  scattering.angle.resolution = 3e-5;
+  Particle particle = makeMuon(100. * au::_GeV);
+  Acts::Vector3D momentum = particle.momentum();
+  scattering(generator, thinLayer, particle);
+  BOOST_CHECK_EQUAL(particle.momentum(), momentum);
+  scattering(generator, thickLayer, particle);
+  BOOST_CHECK_NE(particle.momentum(), momentum);
+}
+
+// This validates the scattering thresholds with the deflection
+// histogrammed at a resolution of 0.2 mrad after the stack
+BOOST_AUTO_TEST_CASE(AdaptiveAngle_histogram_test_) {
+  const double width = 2e-4;
+
+  // thin layers, a tenth of the resolution skips the fastest muons
+  Scattering<GeneralMixture> generalMixture;
+  Scattering<AdaptiveAngle<>> adaptive;
+  adaptive.angle.resolution = 0.1 * width;
+  auto reference = simulate(generalMixture, thinLayer, 1, width, deflection);
+  BOOST_CHECK_LT(
+      chi2ndf(reference, simulate(adaptive, thinLayer, 2, width, deflection)),
+      2.);
+  Generator generator(3);
+  std::uniform_real_distribution<double> logP(-1., 2.);
+  int nSkipped = 0;
+  for (int i = 0; i < 1000; ++i) {
+    nSkipped += adaptive.angle.regime(
+                    thinLayer,
+                    makeMuon(std::pow(10., logP(generator)) * au::_GeV)) ==
+                AdaptiveAngle<>::Regime::Skip;
+  }
+  BOOST_CHECK_GT(nSkipped, 100);
+
+  // a resolution beyond the histogram is detected
+  adaptive.angle.resolution = 5. * width;
+  BOOST_CHECK_GT(
+      chi2ndf(reference, simulate(adaptive, thinLayer, 2, width, deflection)),
+      10.);
+
+  // thick layers, Highland is the Gaussian core of the mixture
+  Scattering<GaussianMixture> gaussianMixture;
+  Scattering<AdaptiveAngle<GaussianMixture, Highland>> adaptiveMixture;
+  adaptiveMixture.angle.resolution = 0.1 * width;
+  BOOST_CHECK_LT(
+      chi2ndf(simulate(gaussianMixture, thickLayer, 1, width, deflection),
+              simulate(adaptiveMixture, thickLayer, 2, width, deflection)),
+      2.);
+}
+
+// This tests the choice of the energy loss sampling
+BOOST_AUTO_TEST_CASE(AdaptiveBetheBloch_regime_test_) {
+  using Regime = AdaptiveBetheBloch::Regime;
+  AdaptiveBetheBloch betheBloch;
+  const double mpv = 1. * au::_MeV;
+  BOOST_CHECK(betheBloch.regime(thinLayer, makeMuon(10. * au::_GeV), mpv) ==
+              Regime::Fast);
+  BOOST_CHECK(betheBloch.regime(thinLayer, makeMuon(5. * au::_GeV), mpv) ==
+              Regime::Accurate);
+  betheBloch.thinLimit = 0.01;
+  BOOST_CHECK(betheBloch.regime(thinLayer, makeMuon(10. * au::_GeV), mpv) ==
+              Regime::Accurate);
+  BOOST_CHECK(betheBloch.regime(thickLayer, makeMuon(10. * au::_GeV), mpv) ==
+              Regime::Fast);
+  // below the resolution relative to the energy
+  betheBloch.resolution = 1e-4;
+  BOOST_CHECK(betheBloch.regime(thickLayer, makeMuon(100. * au::_GeV),
+                                mpv) == Regime::Skip);
+
+  Generator generator(13);
+  Particle particle = makeMuon(100. * au::_GeV);
+  betheBloch.resolution = 1.;
+  betheBloch(generator, thickLayer, particle);
+  BOOST_CHECK_EQUAL(particle.p(), 100. * au::_GeV);
+  betheBloch.resolution = 0.;
+  betheBloch(generator, thickLayer, particle);
+  BOOST_CHECK_LT(particle.p(), 100. * au::_GeV);
+}
+
+// This validates the energy loss thresholds with the momentum loss
+// histogrammed at a resolution of 1e-3 after the stack
+BOOST_AUTO_TEST_CASE(AdaptiveBetheBloch_histogram_test_) {
+  const double width = 1e-3;
+
+  // the Gaussian misses the Landau tail, which only stays within the
+  // resolution at high momentum
+  BetheBloch betheBloch;
+  AdaptiveBetheBloch adaptive;
+  adaptive.pAccurate = 30. * au::_GeV;
+  adaptive.resolution = 0.01 * width;
+  auto reference = simulate(betheBloch, thinLayer, 1, width, momentumLoss);
+  BOOST_CHECK_LT(
+      chi2ndf(reference, simulate(adaptive, thinLayer, 2, width, momentumLoss)),
+      2.);
+
+  // a resolution beyond the histogram is detected
+  adaptive.resolution = width;
+  BOOST_CHECK_GT(
+      chi2ndf(reference, simulate(adaptive, thinLayer, 2, width, momentumLoss)),
+      10.);
+}
+
+} // namespace Test
+
+} // namespace Fatras
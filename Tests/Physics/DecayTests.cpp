@@ -0,0 +1,149 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Decay Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Fatras/Physics/Decay/Decay.hpp"
+#include "Fatras/Physics/Decay/DecayTable.hpp"
+#include "Particle.hpp"
+#include <random>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+// the generator
+typedef std::mt19937 Generator;
+
+// standard generator
+Generator generator;
+
+// This tests the tabulated species
+BOOST_AUTO_TEST_CASE(DecayTable_test) {
+
+  const DecaySpecies *k0s = findDecaySpecies(310);
+  BOOST_CHECK(k0s != nullptr);
+  BOOST_CHECK(k0s->decays());
+  BOOST_CHECK_CLOSE(k0s->lifetime, 0.08954 * au::_ns, 1e-6);
+
+  // the antiparticle shares the entry, self-conjugate ones have none
+  BOOST_CHECK_EQUAL(findDecaySpecies(-3122), findDecaySpecies(3122));
+  BOOST_CHECK(findDecaySpecies(-310) == nullptr);
+  BOOST_CHECK_EQUAL(chargeConjugate(2212), -2212);
+  BOOST_CHECK_EQUAL(chargeConjugate(111), 111);
+
+  // stable and unknown species
+  BOOST_CHECK(!findDecaySpecies(2212)->decays());
+  BOOST_CHECK(findDecaySpecies(999999) == nullptr);
+}
+
+// This tests the sampling of the proper time limit
+BOOST_AUTO_TEST_CASE(DecayLimit_test) {
+
+  Decay decay;
+
+  Acts::Vector3D position(0., 0., 0.);
+  Acts::Vector3D momentum(0., 0., 1. * au::_GeV);
+  double mK0S = findDecaySpecies(310)->mass;
+
+  // the mean of the sampled limits reproduces the lifetime
+  double sum = 0.;
+  const int nSamples = 10000;
+  for (int i = 0; i < nSamples; ++i) {
+    Particle kaon(position, momentum, mK0S, 0., 310, 1);
+    decay.initialize(generator, kaon);
+    sum += kaon.properTimeLimit();
+  }
+  BOOST_CHECK_CLOSE(sum / nSamples, findDecaySpecies(310)->lifetime, 5.);
+
+  // stable particles are not given a limit
+  Particle proton(position, momentum, findDecaySpecies(2212)->mass, 1., 2212,
+                  1);
+  decay.initialize(generator, proton);
+  BOOST_CHECK_EQUAL(proton.properTimeLimit(),
+                    std::numeric_limits<double>::max());
+}
+
+// This tests the decay kinematics
+BOOST_DATA_TEST_CASE(
+    Decay_test_,
+    bdata::random(
+        (bdata::seed = 20,
+         bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random(
+            (bdata::seed = 21,
+             bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random(
+            (bdata::seed = 22,
+             bdata::distribution = std::uniform_real_distribution<>(-1., 1.))) ^
+        bdata::random((
+            bdata::seed = 23,
+            bdata::distribution = std::uniform_real_distribution<>(0.1, 10.))) ^
+        bdata::xrange(100),
+    x, y, z, p, index) {
+
+  Decay decay;
+
+  // alternate between lambda and anti-lambda
+  int pdg = (index % 2) ? 3122 : -3122;
+  double m = findDecaySpecies(pdg)->mass;
+
+  Acts::Vector3D position(0., 0., 0.);
+  Acts::Vector3D momentum = p * au::_GeV * Acts::Vector3D(x, y, z).normalized();
+  Particle lambda(position, momentum, m, 0., pdg, 1);
+  decay.initialize(generator, lambda);
+  BOOST_CHECK(lambda.properTimeLimit() < std::numeric_limits<double>::max());
+
+  // no decay before the limit is reached
+  BOOST_CHECK(decay(generator, lambda).empty());
+
+  // step beyond the limit and decay
+  double decayLength =
+      lambda.properTimeLimit() * au::_c * lambda.p() / lambda.m();
+  Acts::Vector3D stepPosition = 2. * decayLength * momentum.normalized();
+  lambda.update(stepPosition, momentum);
+  BOOST_CHECK(!lambda);
+
+  auto daughters = decay(generator, lambda);
+  BOOST_CHECK_EQUAL(daughters.size(), 2u);
+
+  // four-momentum and charge are conserved
+  Acts::Vector3D sumMomentum(0., 0., 0.);
+  double sumE = 0.;
+  double sumQ = 0.;
+  for (const auto &daughter : daughters) {
+    sumMomentum += daughter.momentum();
+    sumE += daughter.E();
+    sumQ += daughter.q();
+    // the decay vertex is placed back at the sampled decay length
+    BOOST_CHECK_CLOSE(daughter.position().norm(), decayLength, 1e-6);
+  }
+  BOOST_CHECK_SMALL((sumMomentum - momentum).norm(), 1e-9);
+  BOOST_CHECK_CLOSE(sumE, lambda.E(), 1e-6);
+  BOOST_CHECK_SMALL(sumQ, 1e-12);
+
+  // the baryon number is carried by the (anti-)nucleon
+  BOOST_CHECK_EQUAL(daughters[0].pdg() > 0, pdg > 0);
+}
+
+} // namespace Test
+} // namespace Fatras
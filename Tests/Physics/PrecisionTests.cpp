@@ -0,0 +1,183 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE Precision Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Fatras/Kernel/detail/RandomNumberDistributions.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheBloch.hpp"
+#include "Fatras/Physics/EnergyLoss/BetheHeitler.hpp"
+#include "Fatras/Physics/Scattering/GaussianMixture.hpp"
+#include "Fatras/Physics/Scattering/GeneralMixture.hpp"
+#include "Fatras/Physics/Scattering/Highland.hpp"
+#include "Fatras/Physics/Scattering/Scattering.hpp"
+#include "Particle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+// the generator
+typedef std::mt19937 Generator;
+
+// some material
+Acts::Material berilium = Acts::Material(352.8, 407., 9.012, 4., 1.848e-3);
+
+// the number of samples per distribution
+const std::size_t nSamples = 20000;
+
+// the two-sample Kolmogorov-Smirnov critical value at 0.1% significance
+const double ksCritical = 1.95 * std::sqrt(2. / nSamples);
+
+/// Maximum distance of the empirical distribution functions
+///
+/// Values below the resolution are not distinguished, this is needed where
+/// the double precision path resolves values that are physically void.
+double ksDistance(std::vector<double> a, std::vector<double> b,
+                  double resolution = 0.) {
+  for (auto values : {&a, &b}) {
+    for (auto &value : *values) {
+      value = (std::abs(value) < resolution) ? 0. : value;
+    }
+  }
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  double distance = 0.;
+  std::size_t ia = 0, ib = 0;
+  while (ia < a.size() and ib < b.size()) {
+    // step over all values equal to the next one in both samples
+    double value = std::min(a[ia], b[ib]);
+    while (ia < a.size() and a[ia] <= value) {
+      ++ia;
+    }
+    while (ib < b.size() and b[ib] <= value) {
+      ++ib;
+    }
+    distance = std::max(distance, std::abs(double(ia) / a.size() -
+                                           double(ib) / b.size()));
+  }
+  return distance;
+}
+
+/// Sample a physics module on a fresh muon with independent seeds
+///
+/// @param module is the module to be sampled
+/// @param seed is the seed of the generator
+/// @param observable is what is recorded from the module and the particle
+template <typename module_t, typename observable_t>
+std::vector<double> sample(const module_t &module, unsigned int seed,
+                           observable_t observable) {
+  Generator generator(seed);
+  Acts::MaterialProperties detector(berilium, 1. * au::_mm);
+  double m = 105.658367 * au::_MeV;
+  std::vector<double> values;
+  values.reserve(nSamples);
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    Particle particle(Acts::Vector3D(0., 0., 0.),
+                      Acts::Vector3D(0.6, 0.8, 0.) * au::_GeV, m, -1., 13, 1);
+    values.push_back(observable(module, generator, detector, particle));
+  }
+  return values;
+}
+
+/// The sampled scattering angle
+auto angle = [](const auto &module, Generator &generator,
+                const Acts::MaterialProperties &detector, Particle &particle) {
+  return double(module(generator, detector, particle));
+};
+
+/// The sampled energy loss
+auto energyLoss = [](const auto &module, Generator &generator,
+                     const Acts::MaterialProperties &detector,
+                     Particle &particle) {
+  double E = particle.E();
+  module(generator, detector, particle);
+  return E - particle.E();
+};
+
+/// The deflection after the scattering
+auto deflection = [](const auto &module, Generator &generator,
+                     const Acts::MaterialProperties &detector,
+                     Particle &particle) {
+  Acts::Vector3D direction = particle.momentum().normalized();
+  module(generator, detector, particle);
+  return direction.dot(particle.momentum().normalized());
+};
+
+// This tests the single precision Landau distribution
+BOOST_AUTO_TEST_CASE(LandauPrecision_test) {
+  Generator generatorD(20);
+  Generator generatorF(21);
+  BasicLandauDist<double> landauD(0., 1.);
+  BasicLandauDist<float> landauF(0., 1.);
+  std::vector<double> valuesD, valuesF;
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    valuesD.push_back(landauD(generatorD));
+    valuesF.push_back(landauF(generatorF));
+  }
+  BOOST_CHECK_LT(ksDistance(valuesD, valuesF), ksCritical);
+
+  // the quantile itself agrees to float precision
+  for (double z : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99}) {
+    BOOST_CHECK_CLOSE(landau_quantile(float(z), 1.f),
+                      landau_quantile(z, 1.), 1e-3);
+  }
+}
+
+// This tests the single precision scattering formulas
+BOOST_AUTO_TEST_CASE(ScatteringPrecision_test) {
+  BOOST_CHECK_LT(ksDistance(sample(BasicHighland<double>(), 20, angle),
+                            sample(BasicHighland<float>(), 21, angle)),
+                 ksCritical);
+  BOOST_CHECK_LT(ksDistance(sample(BasicGaussianMixture<double>(), 20, angle),
+                            sample(BasicGaussianMixture<float>(), 21, angle)),
+                 ksCritical);
+  BOOST_CHECK_LT(ksDistance(sample(BasicGeneralMixture<double>(), 20, angle),
+                            sample(BasicGeneralMixture<float>(), 21, angle)),
+                 ksCritical);
+  BOOST_CHECK_LT(
+      ksDistance(sample(Scattering<BasicHighland<double>>(), 20, deflection),
+                 sample(Scattering<BasicHighland<float>>(), 21, deflection)),
+      ksCritical);
+}
+
+// This tests the single precision energy loss
+BOOST_AUTO_TEST_CASE(EnergyLossPrecision_test) {
+  BOOST_CHECK_LT(ksDistance(sample(BasicBetheBloch<double>(), 20, energyLoss),
+                            sample(BasicBetheBloch<float>(), 21, energyLoss)),
+                 ksCritical);
+  // the radiated energy spans many orders of magnitude down to values
+  // that do not exist in single precision, compare down to 1 eV
+  BOOST_CHECK_LT(
+      ksDistance(sample(BasicBetheHeitler<double>(), 20, energyLoss),
+                 sample(BasicBetheHeitler<float>(), 21, energyLoss),
+                 1e-3 * au::_keV),
+      ksCritical);
+}
+
+} // namespace Test
+} // namespace Fatras
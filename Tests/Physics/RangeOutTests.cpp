@@ -0,0 +1,156 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2018 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+///  Boost include(s)
+#define BOOST_TEST_MODULE RangeOut Tests
+
+#include <boost/test/included/unit_test.hpp>
+// leave blank line
+
+#include <boost/test/data/test_case.hpp>
+// leave blank line
+
+#include <boost/test/output_test_stream.hpp>
+// leave blank line
+
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialProperties.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Fatras/Physics/EnergyLoss/RangeOut.hpp"
+#include "Particle.hpp"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+namespace tt = boost::test_tools;
+namespace au = Acts::units;
+
+namespace Fatras {
+
+namespace Test {
+
+// some material
+const double gPerCm3 = 1. / (au::_cm * au::_cm * au::_cm);
+Acts::Material silicon =
+    Acts::Material(93.7, 465.2, 28.0855, 14., 2.329 * gPerCm3);
+Acts::Material iron =
+    Acts::Material(17.57, 169.8, 55.845, 26., 7.874 * gPerCm3);
+
+const double protonMass = 938.272 * au::_MeV;
+const double electronMass = 0.51099895 * au::_MeV;
+
+/// A particle along x with the given kinetic energy
+Particle makeParticle(int pdg, double m, double q, double kineticEnergy) {
+  double E = kineticEnergy + m;
+  double p = std::sqrt(E * E - m * m);
+  return Particle(Acts::Vector3D(0., 0., 0.), Acts::Vector3D(p, 0., 0.), m,
+                  q, pdg, 1);
+}
+
+// This tests the range against the NIST PSTAR and ESTAR CSDA ranges
+BOOST_AUTO_TEST_CASE(RangeTable_test_) {
+  RangeTable proton(silicon, protonMass, 1., RangeTable::Config());
+  RangeTable electron(silicon, electronMass, 1., RangeTable::Config());
+  // in g/cm2
+  auto areal = [](double range) { return range * 2.329 * au::_mm / au::_cm; };
+  BOOST_CHECK_CLOSE(areal(proton.range(10. * au::_MeV)), 0.169, 10.);
+  BOOST_CHECK_CLOSE(areal(electron.range(1. * au::_MeV)), 0.555, 10.);
+
+  // monotonic in and beyond the table
+  double last = 0.;
+  for (double T = 1e-4 * au::_keV; T < 100. * au::_GeV; T *= 1.3) {
+    double range = proton.range(T);
+    BOOST_CHECK_GT(range, last);
+    last = range;
+  }
+  BOOST_CHECK_EQUAL(proton.range(0.), 0.);
+
+  // a heavier material stops faster
+  RangeTable protonIron(iron, protonMass, 1., RangeTable::Config());
+  BOOST_CHECK_LT(protonIron.range(10. * au::_MeV),
+                 proton.range(10. * au::_MeV));
+  // the range scales with the mass at equal velocity
+  RangeTable deuteron(silicon, 2. * protonMass, 1., RangeTable::Config());
+  BOOST_CHECK_CLOSE(deuteron.range(20. * au::_MeV),
+                    2. * proton.range(10. * au::_MeV), 1.);
+}
+
+// This tests the termination of slow particles
+BOOST_AUTO_TEST_CASE(RangeOut_test_) {
+  Acts::MaterialProperties slab(silicon, 1. * au::_mm);
+  RangeOut::Config slabCfg;
+  slabCfg.slabRange = true;
+  RangeOut rangeOut(slabCfg);
+
+  // a slow proton is only stopped at the slab if requested
+  auto slow = makeParticle(2212, protonMass, 1., 5. * au::_MeV);
+  RangeOut withoutSlab;
+  BOOST_CHECK_EQUAL(withoutSlab(slab, slow), 0.);
+  BOOST_CHECK(slow);
+  BOOST_CHECK_CLOSE(rangeOut(slab, slow), 5. * au::_MeV, 1e-6);
+  BOOST_CHECK(not slow);
+  BOOST_CHECK_EQUAL(slow.p(), 0.);
+
+  // a faster one continues, unless the cut is above its range
+  auto fast = makeParticle(2212, protonMass, 1., 50. * au::_MeV);
+  BOOST_CHECK_EQUAL(rangeOut(slab, fast), 0.);
+  BOOST_CHECK(fast);
+  RangeOut::Config cfg;
+  cfg.cut = 20. * au::_mm;
+  RangeOut withCut(cfg);
+  BOOST_CHECK_GT(withCut(slab, fast), 0.);
+  BOOST_CHECK(not fast);
+
+  // neutral and energetic particles are not checked
+  auto neutron = makeParticle(2112, protonMass, 0., 1. * au::_MeV);
+  auto pion = makeParticle(211, 139.57 * au::_MeV, 1., 1. * au::_GeV);
+  BOOST_CHECK_EQUAL(rangeOut(slab, neutron), 0.);
+  BOOST_CHECK_EQUAL(rangeOut(slab, pion), 0.);
+  BOOST_CHECK(neutron);
+  BOOST_CHECK(pion);
+
+  auto counters = rangeOut.counters();
+  BOOST_CHECK_EQUAL(counters.checked, 2u);
+  BOOST_CHECK_EQUAL(counters.rangedOut, 1u);
+  BOOST_CHECK_CLOSE(counters.depositedEnergy, 5. * au::_MeV, 1e-6);
+}
+
+// This tests that the tables are shared per material and species
+BOOST_AUTO_TEST_CASE(RangeOut_tables_test_) {
+  RangeOut::Config cfg;
+  cfg.cut = 1. * au::_mm;
+  RangeOut rangeOut(cfg);
+  const auto &proton = rangeOut.table(silicon, 2212, protonMass, 1.);
+  BOOST_CHECK_EQUAL(&rangeOut.table(silicon, -2212, protonMass, -1.),
+                    &proton);
+  BOOST_CHECK_NE(&rangeOut.table(iron, 2212, protonMass, 1.), &proton);
+  BOOST_CHECK_NE(&rangeOut.table(silicon, 11, electronMass, -1.), &proton);
+
+  Acts::MaterialProperties slab(silicon, 1. * au::_mm);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 100; ++i) {
+        auto particle = makeParticle(211, 139.57 * au::_MeV, 1.,
+                                     (0.1 + i) * au::_MeV);
+        rangeOut(slab, particle);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(rangeOut.counters().checked, 400u);
+  BOOST_CHECK_GT(rangeOut.counters().rangedOut, 0u);
+  BOOST_CHECK_LT(rangeOut.counters().rangedOut, 400u);
+}
+
+} // namespace Test
+
+} // namespace Fatras